@@ -0,0 +1,19 @@
+//
+// Copyright (c) 2009 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofAppRunner.h"
+#include "ofAppNoWindow.h"
+#include "ofApp.h"
+
+
+int main()
+{
+    // The benchmark is headless, so no GL context is created.
+    ofAppNoWindow window;
+    ofSetupOpenGL(&window, 0, 0, OF_WINDOW);
+    return ofRunApp(std::make_shared<ofApp>());
+}
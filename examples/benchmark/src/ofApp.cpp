@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2009 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofApp.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+
+// Count every heap allocation so that allocations per call can be reported.
+std::atomic<uint64_t> numAllocations(0);
+
+
+void* operator new(std::size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+
+void ofApp::setup()
+{
+    ofSetLogLevel(OF_LOG_ERROR);
+
+    // Multi-lingual samples, repeated to build each corpus.
+    const std::vector<std::pair<std::string, std::string>> samples = {
+        { "en", "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs.\n" },
+        { "de", "Victor jagt zwölf Boxkämpfer quer über den großen Sylter Deich. Falsches Üben von Xylophonmusik quält jeden größeren Zwerg.\n" },
+        { "ru", "Эх, чужак! Общий съём цен шляп (юфть) – вдрызг! Съешь же ещё этих мягких французских булок, да выпей чаю.\n" },
+        { "zh", "視野無限廣，窗外有藍天。我能吞下玻璃而不伤身体。天地玄黄，宇宙洪荒。\n" },
+        { "th", "เป็นมนุษย์สุดประเสริฐเลิศคุณค่า กว่าบรรดาฝูงสัตว์เดรัจฉาน จงฝ่าฟันพัฒนาวิชาการ\n" },
+        { "ar", "نص حكيم له سر قاطع وذو شأن عظيم مكتوب على ثوب أخضر ومغلف بجلد أزرق.\n" }
+    };
+
+    const std::vector<std::size_t> sizes = { 100, 10000, 1000000, 100000000 };
+
+    for (const auto& sample: samples)
+    {
+        const std::string& language = sample.first;
+
+        for (std::size_t size: sizes)
+        {
+            std::cerr << "Measuring " << language << " " << size << " bytes" << std::endl;
+
+            std::string utf8 = makeCorpus(sample.second, size);
+            std::u16string utf16 = ofx::UTF8::toUTF16(utf8);
+            std::u32string utf32 = ofx::UTF8::toUTF32(utf8);
+
+            measureBreaker<ofx::Linebreaker>("line", "UTF-8", language, size, utf8);
+            measureBreaker<ofx::Linebreaker>("line", "UTF-16", language, size, utf16);
+            measureBreaker<ofx::Linebreaker>("line", "UTF-32", language, size, utf32);
+            measureBreaker<ofx::Wordbreaker>("word", "UTF-8", language, size, utf8);
+            measureBreaker<ofx::Wordbreaker>("word", "UTF-16", language, size, utf16);
+            measureBreaker<ofx::Wordbreaker>("word", "UTF-32", language, size, utf32);
+        }
+    }
+
+    ofJson output;
+    output["benchmark"] = "ofxUnicode breaking";
+    output["results"] = results;
+
+    std::cout << output.dump(4) << std::endl;
+    std::cerr << "Done (" << sink << ")" << std::endl;
+
+    ofExit();
+}
+
+
+std::string ofApp::makeCorpus(const std::string& sample, std::size_t size)
+{
+    std::string corpus;
+    corpus.reserve(size + sample.size());
+
+    while (corpus.size() < size)
+        corpus += sample;
+
+    // Cut back to the start of a UTF-8 sequence.
+    std::size_t end = std::min(size, corpus.size());
+
+    while (end > 0 && end < corpus.size() && (static_cast<unsigned char>(corpus[end]) & 0xC0) == 0x80)
+        --end;
+
+    corpus.resize(end);
+    return corpus;
+}
+
+
+void ofApp::measure(ofJson info,
+                    std::size_t inputBytes,
+                    const std::function<void()>& function)
+{
+    // Warm up caches and one-time initialization.
+    function();
+
+    uint64_t allocationsBefore = numAllocations.load();
+    uint64_t iterations = 0;
+    double seconds = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    do
+    {
+        function();
+        ++iterations;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    while (seconds < MIN_SECONDS);
+
+    uint64_t allocations = numAllocations.load() - allocationsBefore;
+
+    info["inputBytes"] = inputBytes;
+    info["iterations"] = iterations;
+    info["seconds"] = seconds;
+    info["bytesPerSecond"] = inputBytes * iterations / seconds;
+    info["allocationsPerCall"] = double(allocations) / iterations;
+    results.push_back(info);
+}
+
+
+template<typename Breaker, typename Text>
+void ofApp::measureBreaker(const std::string& breakerName,
+                           const std::string& encoding,
+                           const std::string& language,
+                           std::size_t corpusBytes,
+                           const Text& text)
+{
+    typedef std::basic_string_view<typename Text::value_type> View;
+
+    View view(text);
+    Breaker breaker(language);
+    std::vector<typename Breaker::BreakType> breaks;
+    std::size_t inputBytes = text.size() * sizeof(typename Text::value_type);
+
+    ofJson info;
+    info["breaker"] = breakerName;
+    info["encoding"] = encoding;
+    info["language"] = language;
+    info["corpusBytes"] = corpusBytes;
+
+    info["api"] = "static";
+    measure(info, inputBytes, [&]() {
+        sink += Breaker::findBreaks(view, language).size();
+    });
+
+    info["api"] = "member";
+    measure(info, inputBytes, [&]() {
+        sink += breaker.findBreaks(view).size();
+    });
+
+    info["api"] = "static_reuse";
+    measure(info, inputBytes, [&]() {
+        Breaker::findBreaks(view, language, breaks);
+        sink += breaks.size();
+    });
+
+    info["api"] = "member_reuse";
+    measure(info, inputBytes, [&]() {
+        breaker.findBreaks(view, breaks);
+        sink += breaks.size();
+    });
+}
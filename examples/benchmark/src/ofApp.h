@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2009 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#pragma once
+
+
+#include <functional>
+#include "ofMain.h"
+#include "ofxUnicode.h"
+
+
+/// \brief A headless benchmark for line and word breaking.
+///
+/// Every combination of breaker, API, encoding, language and corpus size is
+/// measured, and the results are written to stdout as JSON. Progress is
+/// written to stderr.
+class ofApp: public ofBaseApp
+{
+public:
+    void setup();
+
+    /// \brief Create a corpus by repeating a sample text.
+    /// \param sample The UTF-8 encoded sample text.
+    /// \param size The size of the corpus in bytes.
+    /// \returns a UTF-8 corpus, cut at a character boundary near size.
+    static std::string makeCorpus(const std::string& sample, std::size_t size);
+
+    /// \brief Measure one benchmark case and add it to the results.
+    /// \param info The fields describing the case.
+    /// \param inputBytes The size of the input in its own encoding.
+    /// \param function The function to measure.
+    void measure(ofJson info,
+                 std::size_t inputBytes,
+                 const std::function<void()>& function);
+
+    /// \brief Measure every API of a breaker for one input.
+    template<typename Breaker, typename Text>
+    void measureBreaker(const std::string& breakerName,
+                        const std::string& encoding,
+                        const std::string& language,
+                        std::size_t corpusBytes,
+                        const Text& text);
+
+    /// \brief The minimum time to spend measuring each case.
+    static constexpr double MIN_SECONDS = 0.25;
+
+    /// \brief The benchmark results.
+    ofJson results = ofJson::array();
+
+    /// \brief A value derived from every result so calls are not optimized
+    ///        away.
+    std::size_t sink = 0;
+
+};
@@ -94,6 +94,39 @@ void ofApp::setup()
     std::cout << "output >" << output << "<" << output.size() << std::endl;
     std::cout << "reverseInput >" << reverseInput << "<" << reverseInput.size() << std::endl;
 
+    // Streamed output must not depend on where the input is cut, even when
+    // a run of invalid bytes is cut.
+    std::string corrupt = "abc\x80\x81\x82\x83\x84" "def\xe6\x97\xff\xfe\xe6\x97\xa5";
+
+    for (const std::string& streamEncoding: { "windows-1252", "UTF-16LE" })
+    {
+        ofx::TextConverter streamConverter(inputEncoding, streamEncoding);
+
+        std::string expected;
+        int expectedErrors = streamConverter.convert(corrupt, expected);
+
+        for (std::size_t step = 1; step <= 4; ++step)
+        {
+            std::string streamed;
+            int numErrors = 0;
+
+            auto sink = [&streamed](const char* data, std::size_t size)
+            {
+                streamed.append(data, size);
+            };
+
+            streamConverter.reset();
+
+            for (std::size_t i = 0; i < corrupt.size(); i += step)
+                numErrors += streamConverter.feed(corrupt.data() + i, std::min(step, corrupt.size() - i), sink);
+
+            numErrors += streamConverter.flush(sink);
+
+            std::cout << streamEncoding << " in chunks of " << step << " bytes matches convert(): " << (streamed == expected && numErrors == expectedErrors) << std::endl;
+            assert(streamed == expected && numErrors == expectedErrors);
+        }
+    }
+
     auto encodings = ofx::TextConverter::encodings();
 
     std::cout << ofToString(encodings) << std::endl;
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#pragma once
+
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ofx/Unicode.h"
+
+
+namespace ofx {
+
+
+/// \brief A bounded cache of line and word break results.
+///
+/// Text that is drawn every frame, such as UI labels, is usually broken with
+/// the same language again and again. A BreakCache remembers the compact
+/// break offsets for each (text, language) pair, so that repeated requests
+/// do no break analysis.
+///
+/// Entries are found by a 64-bit hash of the text and language and verified
+/// against a copy of the text, so hash collisions never return the wrong
+/// result. The cache is split into shards, each guarded by a reader-writer
+/// lock, so that lookups from several threads proceed in parallel. Lookups
+/// only mark an entry as recently used, and eviction uses the CLOCK
+/// approximation of least-recently-used.
+///
+/// Results are returned as shared pointers, so they remain valid after the
+/// entry is evicted. A single BreakCache can be shared by many threads.
+class BreakCache
+{
+public:
+    /// \brief The default maximum number of entries.
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    /// \brief The default number of shards.
+    static constexpr std::size_t DEFAULT_NUM_SHARDS = 16;
+
+    /// \brief Create a BreakCache.
+    /// \param capacity The maximum number of (text, language) entries.
+    /// \param numShards The number of independently locked shards.
+    BreakCache(std::size_t capacity = DEFAULT_CAPACITY,
+               std::size_t numShards = DEFAULT_NUM_SHARDS);
+
+    /// \brief Destroy the BreakCache.
+    ~BreakCache();
+
+    /// \brief Get the line break opportunities for a UTF-8 text.
+    /// \param text The UTF-8 encoded text.
+    /// \param language The language used for line breaking.
+    /// \returns the cached or newly computed break offsets.
+    std::shared_ptr<const std::vector<Linebreaker::Break>> lineBreaks(std::string_view text,
+                                                                      const std::string& language = "en");
+
+    /// \brief Get the word break opportunities for a UTF-8 text.
+    /// \param text The UTF-8 encoded text.
+    /// \param language The language used for word breaking.
+    /// \returns the cached or newly computed break offsets.
+    std::shared_ptr<const std::vector<Wordbreaker::Break>> wordBreaks(std::string_view text,
+                                                                      const std::string& language = "en");
+
+    /// \brief Remove all entries and reset the counters.
+    void clear();
+
+    /// \returns the number of cached entries.
+    std::size_t size() const;
+
+    /// \returns the maximum number of cached entries.
+    std::size_t capacity() const;
+
+    /// \returns the number of requests answered from the cache.
+    uint64_t hits() const;
+
+    /// \returns the number of requests that required break analysis.
+    uint64_t misses() const;
+
+    /// \brief Hash a text and language.
+    ///
+    /// The text is consumed eight bytes at a time.
+    ///
+    /// \param text The text to hash.
+    /// \param language The language to hash.
+    /// \returns a 64-bit hash.
+    static uint64_t hash(std::string_view text, std::string_view language);
+
+private:
+    struct Shard;
+
+    /// \brief Find or compute the breaks for a Breaker type.
+    template<typename Breaker>
+    std::shared_ptr<const std::vector<typename Breaker::Break>> find(std::string_view text,
+                                                                     const std::string& language);
+
+    /// \brief The shards, selected by hash.
+    std::vector<std::unique_ptr<Shard>> _shards;
+
+    /// \brief The maximum number of cached entries.
+    std::size_t _capacity = 0;
+
+    /// \brief The number of cache hits.
+    std::atomic<uint64_t> _hits;
+
+    /// \brief The number of cache misses.
+    std::atomic<uint64_t> _misses;
+
+};
+
+
+} // namespace ofx
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ofx/Unicode.h"
+
+
+namespace ofx {
+
+
+/// \brief A compact set of Unicode code points.
+///
+/// The set is stored as an inversion list, a sorted list of code points where
+/// each even entry begins a range of members and each odd entry begins a
+/// range of non-members. Membership tests are O(log n) in the number of
+/// ranges and set algebra is linear in the number of ranges.
+///
+/// Calling optimize() additionally builds an 8 KB bitmap for the Basic
+/// Multilingual Plane, making membership tests for BMP code points O(1).
+///
+/// \sa http://www.unicode.org/reports/tr18/
+class CodepointSet
+{
+public:
+    /// \brief Create an empty CodepointSet.
+    CodepointSet();
+
+    /// \brief Create a CodepointSet from a range of code points.
+    /// \param first The first code point in the range.
+    /// \param last The last code point in the range, inclusive.
+    CodepointSet(char32_t first, char32_t last);
+
+    /// \brief Create a CodepointSet from a Unicode Block.
+    /// \param block The Block to include.
+    CodepointSet(const Unicode::Block& block);
+
+    /// \brief Create a CodepointSet from a UTF32 string.
+    /// \param utf32 The code points to include, in any order.
+    CodepointSet(const std::u32string& utf32);
+
+    /// \brief Destroy the CodepointSet.
+    ~CodepointSet();
+
+    /// \brief Create a CodepointSet from the code points in a UTF8 string.
+    /// \param utf8 The UTF8-encoded code points to include.
+    /// \returns the set of code points in the string.
+    static CodepointSet fromUTF8(const std::string& utf8);
+
+    /// \brief Add a code point to the set.
+    ///
+    /// Adding code points in ascending order takes constant time each.
+    /// Otherwise each new code point costs time linear in the number of
+    /// ranges, so use add(const std::u32string&) for many code points.
+    ///
+    /// \param codepoint The code point to add.
+    void add(char32_t codepoint);
+
+    /// \brief Add many code points to the set at once.
+    ///
+    /// The code points are sorted and merged in a single pass, which is
+    /// faster than adding them one at a time unless they are already in
+    /// ascending order.
+    ///
+    /// \param utf32 The code points to add, in any order.
+    void add(const std::u32string& utf32);
+
+    /// \brief Add a range of code points to the set.
+    /// \param first The first code point in the range.
+    /// \param last The last code point in the range, inclusive.
+    void add(char32_t first, char32_t last);
+
+    /// \brief Add all code points in a Unicode Block to the set.
+    /// \param block The Block to add.
+    void add(const Unicode::Block& block);
+
+    /// \brief Determine if the set contains a code point.
+    /// \param codepoint The code point to test.
+    /// \returns true if the code point is a member of the set.
+    bool contains(char32_t codepoint) const;
+
+    /// \brief Determine if the set contains every code point in a UTF8 string.
+    /// \param utf8 The UTF8-encoded text to test.
+    /// \returns true if every code point in the text is a member.
+    bool containsAll(const std::string& utf8) const;
+
+    /// \brief Find the code points in a UTF8 string that are not in this set.
+    ///
+    /// This can be used to determine if a font charset covers a document.
+    /// Invalid UTF-8 sequences are skipped and logged.
+    ///
+    /// \param utf8 The UTF8-encoded text to test.
+    /// \returns the set of code points in the text that are not members.
+    CodepointSet missingFrom(const std::string& utf8) const;
+
+    /// \brief Find the code points in a UTF8 string that are not in this set.
+    ///
+    /// Invalid UTF-8 sequences are skipped.
+    ///
+    /// \param utf8 The UTF8-encoded text to test.
+    /// \param missing Set to the code points in the text that are not
+    ///        members.
+    /// \returns false if the text contains invalid UTF-8 sequences.
+    bool missingFrom(const std::string& utf8, CodepointSet& missing) const;
+
+    /// \returns true if the set has no members.
+    bool empty() const;
+
+    /// \returns the number of code points in the set.
+    std::size_t size() const;
+
+    /// \returns the number of disjoint code point ranges in the set.
+    std::size_t numRanges() const;
+
+    /// \brief Remove all code points from the set.
+    void clear();
+
+    /// \brief Build a bitmap for O(1) BMP membership tests.
+    ///
+    /// The bitmap is discarded when the set is modified.
+    void optimize();
+
+    /// \returns true if the BMP bitmap has been built.
+    bool isOptimized() const;
+
+    /// \brief Get the members as a UTF32 string.
+    /// \returns the sorted members as a UTF32 string.
+    std::u32string toUTF32() const;
+
+    /// \brief Get the underlying inversion list.
+    /// \returns the sorted range boundaries.
+    const std::vector<char32_t>& inversionList() const;
+
+    /// \returns the union of this set and \p other.
+    CodepointSet unionWith(const CodepointSet& other) const;
+
+    /// \returns the intersection of this set and \p other.
+    CodepointSet intersectionWith(const CodepointSet& other) const;
+
+    /// \returns the members of this set that are not in \p other.
+    CodepointSet difference(const CodepointSet& other) const;
+
+    CodepointSet operator | (const CodepointSet& other) const;
+    CodepointSet operator & (const CodepointSet& other) const;
+    CodepointSet operator - (const CodepointSet& other) const;
+    CodepointSet& operator |= (const CodepointSet& other);
+    CodepointSet& operator &= (const CodepointSet& other);
+    CodepointSet& operator -= (const CodepointSet& other);
+
+    bool operator == (const CodepointSet& other) const;
+    bool operator != (const CodepointSet& other) const;
+
+private:
+    /// \brief Set operations used when merging inversion lists.
+    enum class Operation
+    {
+        UNION,
+        INTERSECTION,
+        DIFFERENCE
+    };
+
+    /// \brief Merge two inversion lists in a single linear pass.
+    static CodepointSet combine(const CodepointSet& a,
+                                const CodepointSet& b,
+                                Operation operation);
+
+    /// \brief Build an inversion list from sorted, unique code points.
+    static std::vector<char32_t> fromSorted(const std::u32string& utf32);
+
+    /// \brief The inversion list.
+    std::vector<char32_t> _list;
+
+    /// \brief The optional BMP bitmap, one bit per code point.
+    std::shared_ptr<const std::vector<uint64_t>> _bmp = nullptr;
+
+};
+
+
+} // namespace ofx
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ofx/CodepointSet.h"
+#include "ofx/Unicode.h"
+
+
+namespace ofx {
+
+
+/// \brief Measure which Unicode Blocks and scripts appear in a corpus.
+///
+/// UTF-8 input is split into chunks that are scanned on a pool of threads.
+/// Each thread counts code points into its own histogram and the histograms
+/// are merged once at the end, so the scan itself shares no state. Block,
+/// script and distinct code point results are derived from the merged
+/// histogram, so property lookups happen once per distinct code point rather
+/// than once per character.
+class CoverageAnalyzer
+{
+public:
+    struct Settings;
+    struct Result;
+
+    /// \brief Create a CoverageAnalyzer with default Settings.
+    CoverageAnalyzer();
+
+    /// \brief Create a CoverageAnalyzer with the given Settings.
+    /// \param settings The Settings to use.
+    CoverageAnalyzer(const Settings& settings);
+
+    /// \brief Destroy the CoverageAnalyzer.
+    ~CoverageAnalyzer();
+
+    /// \returns the current Settings.
+    const Settings& settings() const;
+
+    /// \brief Analyze a single UTF-8 buffer.
+    ///
+    /// Large buffers are split at UTF-8 sequence boundaries and scanned in
+    /// parallel.
+    ///
+    /// \param utf8 The UTF-8 encoded text to analyze.
+    /// \returns the coverage Result.
+    Result analyze(std::string_view utf8) const;
+
+    /// \brief Analyze a collection of UTF-8 strings.
+    /// \param texts The UTF-8 encoded strings to analyze.
+    /// \returns the combined coverage Result.
+    Result analyze(const std::vector<std::string>& texts) const;
+
+    /// \brief Analyze a collection of UTF-8 encoded files.
+    ///
+    /// Files are read by the worker threads one block at a time, so a file
+    /// is never held in memory whole. Files that cannot be read are logged
+    /// and skipped.
+    ///
+    /// \param paths The paths of the files to analyze.
+    /// \returns the combined coverage Result.
+    Result analyzeFiles(const std::vector<std::string>& paths) const;
+
+    /// \brief Settings to configure the CoverageAnalyzer.
+    struct Settings
+    {
+        /// \brief The number of worker threads.
+        ///
+        /// If 0, std::thread::hardware_concurrency() is used.
+        std::size_t numThreads = 0;
+
+        /// \brief The approximate number of bytes scanned per work item.
+        std::size_t chunkSize = 1 << 20;
+    };
+
+    /// \brief The result of a coverage analysis.
+    struct Result
+    {
+        /// \brief Code point counts for each Block.
+        ///
+        /// Counts are indexed in the same order as Unicode::blocks().
+        std::vector<uint64_t> blockCounts;
+
+        /// \brief Code point counts for each script.
+        ///
+        /// Counts are indexed by UCDN script value, e.g. UCDN_SCRIPT_LATIN.
+        std::vector<uint64_t> scriptCounts;
+
+        /// \brief The number of code points not assigned to any Block.
+        uint64_t noBlockCount = 0;
+
+        /// \brief The total number of code points scanned.
+        uint64_t numCodepoints = 0;
+
+        /// \brief The number of invalid UTF-8 bytes skipped.
+        uint64_t numInvalidBytes = 0;
+
+        /// \brief The distinct code points that were found.
+        CodepointSet codepoints;
+
+        /// \brief Get the number of code points found in a Block.
+        /// \param block The Block to query.
+        /// \returns the number of code points found in the Block.
+        uint64_t count(const Unicode::Block& block) const;
+
+        /// \brief Get the Blocks that were found, most frequent first.
+        /// \returns a list of (Block, count) pairs.
+        std::vector<std::pair<const Unicode::Block*, uint64_t>> blocks() const;
+    };
+
+private:
+    /// \brief The Settings.
+    Settings _settings;
+
+};
+
+
+} // namespace ofx
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+#include "ofx/Unicode.h"
+
+
+namespace ofx {
+
+
+/// \brief Choose line breaks that fit a text into a given width.
+///
+/// Linebreaker reports where a line may end. LineFitter takes those break
+/// opportunities and the advance of each character and chooses the lines.
+///
+/// When the text is set, the break opportunities are collected and the
+/// advances are summed once into a prefix sum, so the width of any line is
+/// found in constant time. Fitting the same text to a different width reuses
+/// both and does not repeat the break analysis or measurement.
+///
+/// Two algorithms are available. GREEDY fills each line as far as possible in
+/// a single linear pass. OPTIMAL minimizes the total raggedness of the
+/// paragraph using the Knuth-Plass method, keeping at most maxActiveNodes()
+/// candidate line starts alive at once so the cost stays linear in the length
+/// of the text.
+///
+/// \sa https://doi.org/10.1002/spe.4380111102
+class LineFitter
+{
+public:
+    /// \brief The line fitting algorithms.
+    enum class Algorithm
+    {
+        /// \brief Put as much as possible on each line.
+        GREEDY,
+        /// \brief Minimize the raggedness of the whole paragraph.
+        OPTIMAL
+    };
+
+    /// \brief A fitted line.
+    struct Line
+    {
+        /// \brief The byte offset of the first character in the line.
+        std::size_t begin = 0;
+
+        /// \brief The byte offset one past the last character in the line.
+        ///
+        /// This includes any trailing whitespace and line terminators.
+        std::size_t end = 0;
+
+        /// \brief The width of the line, excluding trailing whitespace.
+        float width = 0;
+
+        /// \brief True if the line ends at a mandatory break.
+        bool mandatory = false;
+
+        /// \brief True if the line is wider than the fitted width.
+        ///
+        /// This happens when a single unbreakable run is too wide.
+        bool overfull = false;
+    };
+
+    /// \brief A function that returns the advance of a code point.
+    ///
+    /// The function is passed the code point and its byte offset in the text.
+    typedef std::function<float(char32_t codepoint, std::size_t offset)> AdvanceFunction;
+
+    /// \brief Create an empty LineFitter.
+    LineFitter();
+
+    /// \brief Create a LineFitter for a text.
+    /// \param utf8 The UTF-8 encoded text.
+    /// \param breaks The Linebreaker results for the text.
+    /// \param advance The function used to measure each code point.
+    LineFitter(std::string_view utf8,
+               const std::vector<Linebreaker::BreakType>& breaks,
+               const AdvanceFunction& advance);
+
+    /// \brief Create a LineFitter for a text.
+    /// \param utf8 The UTF-8 encoded text.
+    /// \param breaks The Linebreaker results for the text.
+    /// \param advances The advance of each byte in the text.
+    LineFitter(std::string_view utf8,
+               const std::vector<Linebreaker::BreakType>& breaks,
+               const std::vector<float>& advances);
+
+    /// \brief Destroy the LineFitter.
+    ~LineFitter();
+
+    /// \brief Set the text, measuring each code point with a function.
+    ///
+    /// The function is called once per code point.
+    ///
+    /// \param utf8 The UTF-8 encoded text.
+    /// \param breaks The Linebreaker results for the text, one per byte.
+    /// \param advance The function used to measure each code point.
+    /// \returns true if the text was set successfully.
+    bool setText(std::string_view utf8,
+                 const std::vector<Linebreaker::BreakType>& breaks,
+                 const AdvanceFunction& advance);
+
+    /// \brief Set the text with precomputed advances.
+    ///
+    /// The advances are given per byte so that shaped clusters can be
+    /// measured as a whole. A cluster's advance is stored at the offset of
+    /// its first byte and the remaining bytes of the cluster have an advance
+    /// of 0.
+    ///
+    /// \param utf8 The UTF-8 encoded text.
+    /// \param breaks The Linebreaker results for the text, one per byte.
+    /// \param advances The advance of each byte, one per byte.
+    /// \returns true if the text was set successfully.
+    bool setText(std::string_view utf8,
+                 const std::vector<Linebreaker::BreakType>& breaks,
+                 const std::vector<float>& advances);
+
+    /// \brief Remove the text.
+    void clear();
+
+    /// \brief Fit the text into lines.
+    /// \param maxWidth The maximum width of a line.
+    /// \param algorithm The Algorithm to use.
+    /// \returns the fitted lines.
+    std::vector<Line> fit(float maxWidth,
+                          Algorithm algorithm = Algorithm::GREEDY) const;
+
+    /// \brief Fit the text into lines.
+    ///
+    /// This reuses the capacity of an existing list when relaying out the
+    /// same text repeatedly.
+    ///
+    /// \param maxWidth The maximum width of a line.
+    /// \param algorithm The Algorithm to use.
+    /// \param lines The list to fill with the fitted lines.
+    void fit(float maxWidth,
+             Algorithm algorithm,
+             std::vector<Line>& lines) const;
+
+    /// \brief Get the total advance of a range of the text.
+    /// \param begin The byte offset of the start of the range.
+    /// \param end The byte offset one past the end of the range.
+    /// \returns the sum of the advances in the range.
+    float width(std::size_t begin, std::size_t end) const;
+
+    /// \returns the size of the text in bytes.
+    std::size_t size() const;
+
+    /// \brief Set the maximum number of active nodes for OPTIMAL fitting.
+    ///
+    /// When the limit is reached the node with the highest total demerits is
+    /// dropped. Larger values give results closer to the true optimum for
+    /// very narrow widths at a higher cost.
+    ///
+    /// \param maxActiveNodes The maximum number of active nodes.
+    void setMaxActiveNodes(std::size_t maxActiveNodes);
+
+    /// \returns the maximum number of active nodes for OPTIMAL fitting.
+    std::size_t maxActiveNodes() const;
+
+private:
+    /// \brief A position where a line may end.
+    struct Candidate
+    {
+        /// \brief The byte offset one past the end of the line.
+        std::size_t end;
+
+        /// \brief The byte offset after the last non-whitespace character.
+        std::size_t contentEnd;
+
+        /// \brief True if the break is mandatory.
+        bool mandatory;
+    };
+
+    /// \brief Collect the break candidates after the advances are set.
+    void collectCandidates(std::string_view utf8,
+                           const std::vector<Linebreaker::BreakType>& breaks);
+
+    void fitGreedy(float maxWidth, std::vector<Line>& lines) const;
+
+    void fitOptimal(float maxWidth, std::vector<Line>& lines) const;
+
+    /// \brief Make a Line between a start offset and a Candidate.
+    Line makeLine(std::size_t begin,
+                  const Candidate& candidate,
+                  float maxWidth) const;
+
+    /// \brief The prefix sums of the advances, one more than the text size.
+    std::vector<double> _prefixWidths;
+
+    /// \brief The break candidates, in order.
+    std::vector<Candidate> _candidates;
+
+    /// \brief The maximum number of active nodes for OPTIMAL fitting.
+    std::size_t _maxActiveNodes = 32;
+
+};
+
+
+} // namespace ofx
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "ofx/Unicode.h"
+
+
+namespace ofx {
+
+
+/// \brief A thread-safe source of TextConverters.
+///
+/// A TextConverter holds a single iconv descriptor whose shift state is
+/// changed by every conversion, so one converter cannot be used by several
+/// threads at once. A TextConverterPool gives each thread its own converter
+/// for each combination of Settings, the first time that thread uses those
+/// Settings. The converter state is reset before every conversion.
+///
+/// Each thread finds its converters in a thread-local table without taking
+/// a lock. When a thread exits its converters return to the pool, and are
+/// given to the next threads that use the same Settings, so short-lived
+/// threads do not add converters. The pool owns the converters and closes
+/// them when it is destroyed, so the pool must outlive any conversion that
+/// uses it.
+class TextConverterPool
+{
+public:
+    /// \brief Create an empty TextConverterPool.
+    TextConverterPool();
+
+    /// \brief Destroy the TextConverterPool and close its converters.
+    ~TextConverterPool();
+
+    TextConverterPool(const TextConverterPool&) = delete;
+    TextConverterPool& operator = (const TextConverterPool&) = delete;
+
+    /// \brief Convert encoded input text to the encoded output text.
+    /// \param input The input string corresponding to inputEncoding.
+    /// \param output A string in which to write the output.
+    /// \param settings The conversion Settings.
+    /// \returns -1 if error.
+    ///           0 if no error.
+    ///          >0 For number of invalid byte sequences in source.
+    int convert(const std::string& input,
+                std::string& output,
+                const TextConverter::Settings& settings);
+
+    /// \brief Convert encoded input text to the encoded output text.
+    /// \param input The input string corresponding to inputEncoding.
+    /// \param output A string in which to write the output.
+    /// \param inputEncoding The input encoding, e.g. ENCODING_ISO_8859_15.
+    /// \param outputEncoding The output encoding, e.g. ENCODING_UTF8.
+    /// \returns -1 if error.
+    ///           0 if no error.
+    ///          >0 For number of invalid byte sequences in source.
+    int convert(const std::string& input,
+                std::string& output,
+                const std::string& inputEncoding,
+                const std::string& outputEncoding);
+
+    /// \brief Convert encoded input text to the encoded output text.
+    /// \param input The input string corresponding to inputEncoding.
+    /// \param settings The conversion Settings.
+    /// \returns the encoded input or an empty string on error.
+    std::string convert(const std::string& input,
+                        const TextConverter::Settings& settings);
+
+    /// \brief Get the calling thread's converter for the given Settings.
+    ///
+    /// The converter must only be used by the calling thread.
+    ///
+    /// \param settings The conversion Settings.
+    /// \returns the converter, or nullptr if the Settings are not supported.
+    std::shared_ptr<TextConverter> converter(const TextConverter::Settings& settings);
+
+    /// \returns the number of converters owned by the pool, both those in
+    ///          use by a thread and those returned by exited threads.
+    std::size_t size() const;
+
+private:
+    struct Shared;
+    struct ThreadConverters;
+    struct ThreadTables;
+
+    /// \brief Get the calling thread's converters for every pool.
+    static ThreadTables& threadTables();
+
+    /// \brief A unique id, so that thread-local tables never confuse pools.
+    uint64_t _id = 0;
+
+    /// \brief The converters, shared with the thread-local tables so that
+    ///        exiting threads can return their converters.
+    std::shared_ptr<Shared> _shared;
+
+};
+
+
+} // namespace ofx
@@ -8,7 +8,12 @@
 #pragma once
 
 
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <numeric>
 #include <set>
@@ -18,6 +23,9 @@
 #include "ofConstants.h"
 //#include "fribidi/fribidi-bidi.h"
 #include "ucdn.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 
 namespace ofx {
@@ -25,8 +33,9 @@ namespace ofx {
 
 /// \brief Defines Unicode Blocks.
 ///
-/// Block data is generated from
-/// http://www.unicode.org/Public/UNIDATA/Blocks.txt using a script.
+/// Block data is generated from a vendored copy of
+/// http://www.unicode.org/Public/UNIDATA/Blocks.txt using
+/// scripts/GenerateUnicodeBlocks.sh.
 ///
 /// \sa http://www.unicode.org/Public/UNIDATA/Blocks.txt
 class Unicode
@@ -69,6 +78,98 @@ public:
     /// \brief An character set covering ASCII and most Western code points.
     static const std::u32string STANDARD_CHARSET;
 
+    /// \brief Filters used when building character sets.
+    enum class CharsetFilter
+    {
+        /// \brief Include every code point.
+        ALL,
+
+        /// \brief Include code points that are assigned a character.
+        ///
+        /// Unassigned code points (General Category Cn) are excluded.
+        ASSIGNED,
+
+        /// \brief Include printable code points.
+        ///
+        /// \sa UTF32::isPrintable()
+        PRINTABLE
+    };
+
+    /// \brief A lazy, allocation-free range of consecutive code points.
+    ///
+    /// The range supports random access and can be iterated like a
+    /// std::u32string without materializing the code points.
+    class CodepointRange
+    {
+    public:
+        /// \brief A random access iterator over the code points.
+        class const_iterator
+        {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef char32_t value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const char32_t* pointer;
+            typedef char32_t reference;
+
+            constexpr const_iterator(char32_t codepoint = 0): _codepoint(codepoint) {}
+
+            constexpr char32_t operator * () const { return _codepoint; }
+            constexpr char32_t operator [] (difference_type n) const { return static_cast<char32_t>(_codepoint + n); }
+
+            const_iterator& operator ++ () { ++_codepoint; return *this; }
+            const_iterator operator ++ (int) { const_iterator i = *this; ++_codepoint; return i; }
+            const_iterator& operator -- () { --_codepoint; return *this; }
+            const_iterator operator -- (int) { const_iterator i = *this; --_codepoint; return i; }
+            const_iterator& operator += (difference_type n) { _codepoint = static_cast<char32_t>(_codepoint + n); return *this; }
+            const_iterator& operator -= (difference_type n) { _codepoint = static_cast<char32_t>(_codepoint - n); return *this; }
+
+            constexpr const_iterator operator + (difference_type n) const { return const_iterator(static_cast<char32_t>(_codepoint + n)); }
+            constexpr const_iterator operator - (difference_type n) const { return const_iterator(static_cast<char32_t>(_codepoint - n)); }
+            constexpr difference_type operator - (const_iterator other) const { return difference_type(_codepoint) - difference_type(other._codepoint); }
+
+            constexpr bool operator == (const_iterator other) const { return _codepoint == other._codepoint; }
+            constexpr bool operator != (const_iterator other) const { return _codepoint != other._codepoint; }
+            constexpr bool operator < (const_iterator other) const { return _codepoint < other._codepoint; }
+            constexpr bool operator > (const_iterator other) const { return _codepoint > other._codepoint; }
+            constexpr bool operator <= (const_iterator other) const { return _codepoint <= other._codepoint; }
+            constexpr bool operator >= (const_iterator other) const { return _codepoint >= other._codepoint; }
+
+        private:
+            /// \brief The current code point.
+            char32_t _codepoint;
+
+        };
+
+        typedef const_iterator iterator;
+
+        /// \brief Create a range of code points.
+        /// \param first The first code point in the range.
+        /// \param last The last code point in the range, inclusive.
+        constexpr CodepointRange(char32_t first, char32_t last):
+            _begin(first), _end(static_cast<char32_t>(last + 1))
+        {
+        }
+
+        constexpr const_iterator begin() const { return const_iterator(_begin); }
+        constexpr const_iterator end() const { return const_iterator(_end); }
+        constexpr std::size_t size() const { return _end - _begin; }
+        constexpr bool empty() const { return _end == _begin; }
+        constexpr char32_t operator [] (std::size_t i) const { return static_cast<char32_t>(_begin + i); }
+
+    private:
+        /// \brief The first code point.
+        char32_t _begin;
+
+        /// \brief One past the last code point.
+        char32_t _end;
+
+    };
+
+    /// \brief A range of Unicode code points.
+    ///
+    /// Blocks are literal types, so the Block table is constant-initialized
+    /// and requires no static initialization at startup.
     struct Block
     {
         /// \brief The first Unicode code point in the Block.
@@ -82,923 +183,1034 @@ public:
         /// When comparing block names, casing, whitespace, hyphens, and
         /// underbars are ignored. For example, "Latin Extended-A", "latin
         /// extended a" and "LATIN_EXTENDED_A" are equivalent.
-        std::string name;
+        ///
+        /// The name refers to static storage. Earlier versions stored a
+        /// std::string; use std::string(name) where one is needed.
+        std::string_view name;
 
         /// \brief Get the number of Unicode code points in the Block.
         /// \returns the number of Unicode code points in the Block.
         std::size_t size() const;
 
         /// \brief Get this Block as a UTF32 string.
+        ///
+        /// To iterate the code points without allocating, use codepoints().
+        ///
         /// \returns the Block as a UTF32 string.
         std::u32string charset() const;
-        
+
+        /// \brief Get the filtered code points in this Block as a UTF32 string.
+        /// \param filter The filter used to select code points.
+        /// \returns the selected code points as a UTF32 string.
+        std::u32string charset(CharsetFilter filter) const;
+
+        /// \brief Get a lazy range over the code points in the Block.
+        /// \returns an allocation-free random access range.
+        CodepointRange codepoints() const;
+
+        /// \brief Determine if a code point is in the Block.
+        /// \param codepoint The code point to test.
+        /// \returns true if begin <= codepoint <= end.
+        bool contains(char32_t codepoint) const;
+
     };
 
+    /// \brief Get all Unicode Blocks, sorted by code point.
+    /// \returns a list of all Unicode Blocks.
+    static const std::vector<const Block*>& blocks();
 
+    /// \brief Find the Unicode Block containing the given code point.
+    ///
+    /// The lookup is a binary search over the sorted Block list.
+    ///
+    /// \param codepoint The code point to look up.
+    /// \returns the containing Block or nullptr if the code point is not
+    ///          assigned to a Block (i.e. the No_Block value).
+    static const Block* blockOf(char32_t codepoint);
+
+    /// \brief Find a Unicode Block by name.
+    ///
+    /// Names are compared ignoring casing, whitespace, hyphens and
+    /// underbars, so "Latin Extended-A", "latin extended a" and
+    /// "LATIN_EXTENDED_A" all find the same Block. The lookup uses a perfect
+    /// hash over the canonicalized names and does not allocate.
+    ///
+    /// \param name The Block name to find.
+    /// \returns the named Block or nullptr if no Block has that name.
+    static const Block* blockByName(std::string_view name);
+
+
+    // BEGIN GENERATED UNICODE BLOCKS
     /// \brief The BASIC_LATIN Unicode Block.
-    static const Block BASIC_LATIN;
+    static const Block& BASIC_LATIN;
 
     /// \brief The LATIN_1_SUPPLEMENT Unicode Block.
-    static const Block LATIN_1_SUPPLEMENT;
+    static const Block& LATIN_1_SUPPLEMENT;
 
     /// \brief The LATIN_EXTENDED_A Unicode Block.
-    static const Block LATIN_EXTENDED_A;
+    static const Block& LATIN_EXTENDED_A;
 
     /// \brief The LATIN_EXTENDED_B Unicode Block.
-    static const Block LATIN_EXTENDED_B;
+    static const Block& LATIN_EXTENDED_B;
 
     /// \brief The IPA_EXTENSIONS Unicode Block.
-    static const Block IPA_EXTENSIONS;
+    static const Block& IPA_EXTENSIONS;
 
     /// \brief The SPACING_MODIFIER_LETTERS Unicode Block.
-    static const Block SPACING_MODIFIER_LETTERS;
+    static const Block& SPACING_MODIFIER_LETTERS;
 
     /// \brief The COMBINING_DIACRITICAL_MARKS Unicode Block.
-    static const Block COMBINING_DIACRITICAL_MARKS;
+    static const Block& COMBINING_DIACRITICAL_MARKS;
 
     /// \brief The GREEK_AND_COPTIC Unicode Block.
-    static const Block GREEK_AND_COPTIC;
+    static const Block& GREEK_AND_COPTIC;
 
     /// \brief The CYRILLIC Unicode Block.
-    static const Block CYRILLIC;
+    static const Block& CYRILLIC;
 
     /// \brief The CYRILLIC_SUPPLEMENT Unicode Block.
-    static const Block CYRILLIC_SUPPLEMENT;
+    static const Block& CYRILLIC_SUPPLEMENT;
 
     /// \brief The ARMENIAN Unicode Block.
-    static const Block ARMENIAN;
+    static const Block& ARMENIAN;
 
     /// \brief The HEBREW Unicode Block.
-    static const Block HEBREW;
+    static const Block& HEBREW;
 
     /// \brief The ARABIC Unicode Block.
-    static const Block ARABIC;
+    static const Block& ARABIC;
 
     /// \brief The SYRIAC Unicode Block.
-    static const Block SYRIAC;
+    static const Block& SYRIAC;
 
     /// \brief The ARABIC_SUPPLEMENT Unicode Block.
-    static const Block ARABIC_SUPPLEMENT;
+    static const Block& ARABIC_SUPPLEMENT;
 
     /// \brief The THAANA Unicode Block.
-    static const Block THAANA;
+    static const Block& THAANA;
 
     /// \brief The NKO Unicode Block.
-    static const Block NKO;
+    static const Block& NKO;
 
     /// \brief The SAMARITAN Unicode Block.
-    static const Block SAMARITAN;
+    static const Block& SAMARITAN;
 
     /// \brief The MANDAIC Unicode Block.
-    static const Block MANDAIC;
+    static const Block& MANDAIC;
 
     /// \brief The SYRIAC_SUPPLEMENT Unicode Block.
-    static const Block SYRIAC_SUPPLEMENT;
+    static const Block& SYRIAC_SUPPLEMENT;
+
+    /// \brief The ARABIC_EXTENDED_B Unicode Block.
+    static const Block& ARABIC_EXTENDED_B;
 
     /// \brief The ARABIC_EXTENDED_A Unicode Block.
-    static const Block ARABIC_EXTENDED_A;
+    static const Block& ARABIC_EXTENDED_A;
 
     /// \brief The DEVANAGARI Unicode Block.
-    static const Block DEVANAGARI;
+    static const Block& DEVANAGARI;
 
     /// \brief The BENGALI Unicode Block.
-    static const Block BENGALI;
+    static const Block& BENGALI;
 
     /// \brief The GURMUKHI Unicode Block.
-    static const Block GURMUKHI;
+    static const Block& GURMUKHI;
 
     /// \brief The GUJARATI Unicode Block.
-    static const Block GUJARATI;
+    static const Block& GUJARATI;
 
     /// \brief The ORIYA Unicode Block.
-    static const Block ORIYA;
+    static const Block& ORIYA;
 
     /// \brief The TAMIL Unicode Block.
-    static const Block TAMIL;
+    static const Block& TAMIL;
 
     /// \brief The TELUGU Unicode Block.
-    static const Block TELUGU;
+    static const Block& TELUGU;
 
     /// \brief The KANNADA Unicode Block.
-    static const Block KANNADA;
+    static const Block& KANNADA;
 
     /// \brief The MALAYALAM Unicode Block.
-    static const Block MALAYALAM;
+    static const Block& MALAYALAM;
 
     /// \brief The SINHALA Unicode Block.
-    static const Block SINHALA;
+    static const Block& SINHALA;
 
     /// \brief The THAI Unicode Block.
-    static const Block THAI;
+    static const Block& THAI;
 
     /// \brief The LAO Unicode Block.
-    static const Block LAO;
+    static const Block& LAO;
 
     /// \brief The TIBETAN Unicode Block.
-    static const Block TIBETAN;
+    static const Block& TIBETAN;
 
     /// \brief The MYANMAR Unicode Block.
-    static const Block MYANMAR;
+    static const Block& MYANMAR;
 
     /// \brief The GEORGIAN Unicode Block.
-    static const Block GEORGIAN;
+    static const Block& GEORGIAN;
 
     /// \brief The HANGUL_JAMO Unicode Block.
-    static const Block HANGUL_JAMO;
+    static const Block& HANGUL_JAMO;
 
     /// \brief The ETHIOPIC Unicode Block.
-    static const Block ETHIOPIC;
+    static const Block& ETHIOPIC;
 
     /// \brief The ETHIOPIC_SUPPLEMENT Unicode Block.
-    static const Block ETHIOPIC_SUPPLEMENT;
+    static const Block& ETHIOPIC_SUPPLEMENT;
 
     /// \brief The CHEROKEE Unicode Block.
-    static const Block CHEROKEE;
+    static const Block& CHEROKEE;
 
     /// \brief The UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS Unicode Block.
-    static const Block UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS;
+    static const Block& UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS;
 
     /// \brief The OGHAM Unicode Block.
-    static const Block OGHAM;
+    static const Block& OGHAM;
 
     /// \brief The RUNIC Unicode Block.
-    static const Block RUNIC;
+    static const Block& RUNIC;
 
     /// \brief The TAGALOG Unicode Block.
-    static const Block TAGALOG;
+    static const Block& TAGALOG;
 
     /// \brief The HANUNOO Unicode Block.
-    static const Block HANUNOO;
+    static const Block& HANUNOO;
 
     /// \brief The BUHID Unicode Block.
-    static const Block BUHID;
+    static const Block& BUHID;
 
     /// \brief The TAGBANWA Unicode Block.
-    static const Block TAGBANWA;
+    static const Block& TAGBANWA;
 
     /// \brief The KHMER Unicode Block.
-    static const Block KHMER;
+    static const Block& KHMER;
 
     /// \brief The MONGOLIAN Unicode Block.
-    static const Block MONGOLIAN;
+    static const Block& MONGOLIAN;
 
     /// \brief The UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED Unicode Block.
-    static const Block UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED;
+    static const Block& UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED;
 
     /// \brief The LIMBU Unicode Block.
-    static const Block LIMBU;
+    static const Block& LIMBU;
 
     /// \brief The TAI_LE Unicode Block.
-    static const Block TAI_LE;
+    static const Block& TAI_LE;
 
     /// \brief The NEW_TAI_LUE Unicode Block.
-    static const Block NEW_TAI_LUE;
+    static const Block& NEW_TAI_LUE;
 
     /// \brief The KHMER_SYMBOLS Unicode Block.
-    static const Block KHMER_SYMBOLS;
+    static const Block& KHMER_SYMBOLS;
 
     /// \brief The BUGINESE Unicode Block.
-    static const Block BUGINESE;
+    static const Block& BUGINESE;
 
     /// \brief The TAI_THAM Unicode Block.
-    static const Block TAI_THAM;
+    static const Block& TAI_THAM;
 
     /// \brief The COMBINING_DIACRITICAL_MARKS_EXTENDED Unicode Block.
-    static const Block COMBINING_DIACRITICAL_MARKS_EXTENDED;
+    static const Block& COMBINING_DIACRITICAL_MARKS_EXTENDED;
 
     /// \brief The BALINESE Unicode Block.
-    static const Block BALINESE;
+    static const Block& BALINESE;
 
     /// \brief The SUNDANESE Unicode Block.
-    static const Block SUNDANESE;
+    static const Block& SUNDANESE;
 
     /// \brief The BATAK Unicode Block.
-    static const Block BATAK;
+    static const Block& BATAK;
 
     /// \brief The LEPCHA Unicode Block.
-    static const Block LEPCHA;
+    static const Block& LEPCHA;
 
     /// \brief The OL_CHIKI Unicode Block.
-    static const Block OL_CHIKI;
+    static const Block& OL_CHIKI;
 
     /// \brief The CYRILLIC_EXTENDED_C Unicode Block.
-    static const Block CYRILLIC_EXTENDED_C;
+    static const Block& CYRILLIC_EXTENDED_C;
 
     /// \brief The GEORGIAN_EXTENDED Unicode Block.
-    static const Block GEORGIAN_EXTENDED;
+    static const Block& GEORGIAN_EXTENDED;
 
     /// \brief The SUNDANESE_SUPPLEMENT Unicode Block.
-    static const Block SUNDANESE_SUPPLEMENT;
+    static const Block& SUNDANESE_SUPPLEMENT;
 
     /// \brief The VEDIC_EXTENSIONS Unicode Block.
-    static const Block VEDIC_EXTENSIONS;
+    static const Block& VEDIC_EXTENSIONS;
 
     /// \brief The PHONETIC_EXTENSIONS Unicode Block.
-    static const Block PHONETIC_EXTENSIONS;
+    static const Block& PHONETIC_EXTENSIONS;
 
     /// \brief The PHONETIC_EXTENSIONS_SUPPLEMENT Unicode Block.
-    static const Block PHONETIC_EXTENSIONS_SUPPLEMENT;
+    static const Block& PHONETIC_EXTENSIONS_SUPPLEMENT;
 
     /// \brief The COMBINING_DIACRITICAL_MARKS_SUPPLEMENT Unicode Block.
-    static const Block COMBINING_DIACRITICAL_MARKS_SUPPLEMENT;
+    static const Block& COMBINING_DIACRITICAL_MARKS_SUPPLEMENT;
 
     /// \brief The LATIN_EXTENDED_ADDITIONAL Unicode Block.
-    static const Block LATIN_EXTENDED_ADDITIONAL;
+    static const Block& LATIN_EXTENDED_ADDITIONAL;
 
     /// \brief The GREEK_EXTENDED Unicode Block.
-    static const Block GREEK_EXTENDED;
+    static const Block& GREEK_EXTENDED;
 
     /// \brief The GENERAL_PUNCTUATION Unicode Block.
-    static const Block GENERAL_PUNCTUATION;
+    static const Block& GENERAL_PUNCTUATION;
 
     /// \brief The SUPERSCRIPTS_AND_SUBSCRIPTS Unicode Block.
-    static const Block SUPERSCRIPTS_AND_SUBSCRIPTS;
+    static const Block& SUPERSCRIPTS_AND_SUBSCRIPTS;
 
     /// \brief The CURRENCY_SYMBOLS Unicode Block.
-    static const Block CURRENCY_SYMBOLS;
+    static const Block& CURRENCY_SYMBOLS;
 
     /// \brief The COMBINING_DIACRITICAL_MARKS_FOR_SYMBOLS Unicode Block.
-    static const Block COMBINING_DIACRITICAL_MARKS_FOR_SYMBOLS;
+    static const Block& COMBINING_DIACRITICAL_MARKS_FOR_SYMBOLS;
 
     /// \brief The LETTERLIKE_SYMBOLS Unicode Block.
-    static const Block LETTERLIKE_SYMBOLS;
+    static const Block& LETTERLIKE_SYMBOLS;
 
     /// \brief The NUMBER_FORMS Unicode Block.
-    static const Block NUMBER_FORMS;
+    static const Block& NUMBER_FORMS;
 
     /// \brief The ARROWS Unicode Block.
-    static const Block ARROWS;
+    static const Block& ARROWS;
 
     /// \brief The MATHEMATICAL_OPERATORS Unicode Block.
-    static const Block MATHEMATICAL_OPERATORS;
+    static const Block& MATHEMATICAL_OPERATORS;
 
     /// \brief The MISCELLANEOUS_TECHNICAL Unicode Block.
-    static const Block MISCELLANEOUS_TECHNICAL;
+    static const Block& MISCELLANEOUS_TECHNICAL;
 
     /// \brief The CONTROL_PICTURES Unicode Block.
-    static const Block CONTROL_PICTURES;
+    static const Block& CONTROL_PICTURES;
 
     /// \brief The OPTICAL_CHARACTER_RECOGNITION Unicode Block.
-    static const Block OPTICAL_CHARACTER_RECOGNITION;
+    static const Block& OPTICAL_CHARACTER_RECOGNITION;
 
     /// \brief The ENCLOSED_ALPHANUMERICS Unicode Block.
-    static const Block ENCLOSED_ALPHANUMERICS;
+    static const Block& ENCLOSED_ALPHANUMERICS;
 
     /// \brief The BOX_DRAWING Unicode Block.
-    static const Block BOX_DRAWING;
+    static const Block& BOX_DRAWING;
 
     /// \brief The BLOCK_ELEMENTS Unicode Block.
-    static const Block BLOCK_ELEMENTS;
+    static const Block& BLOCK_ELEMENTS;
 
     /// \brief The GEOMETRIC_SHAPES Unicode Block.
-    static const Block GEOMETRIC_SHAPES;
+    static const Block& GEOMETRIC_SHAPES;
 
     /// \brief The MISCELLANEOUS_SYMBOLS Unicode Block.
-    static const Block MISCELLANEOUS_SYMBOLS;
+    static const Block& MISCELLANEOUS_SYMBOLS;
 
     /// \brief The DINGBATS Unicode Block.
-    static const Block DINGBATS;
+    static const Block& DINGBATS;
 
     /// \brief The MISCELLANEOUS_MATHEMATICAL_SYMBOLS_A Unicode Block.
-    static const Block MISCELLANEOUS_MATHEMATICAL_SYMBOLS_A;
+    static const Block& MISCELLANEOUS_MATHEMATICAL_SYMBOLS_A;
 
     /// \brief The SUPPLEMENTAL_ARROWS_A Unicode Block.
-    static const Block SUPPLEMENTAL_ARROWS_A;
+    static const Block& SUPPLEMENTAL_ARROWS_A;
 
     /// \brief The BRAILLE_PATTERNS Unicode Block.
-    static const Block BRAILLE_PATTERNS;
+    static const Block& BRAILLE_PATTERNS;
 
     /// \brief The SUPPLEMENTAL_ARROWS_B Unicode Block.
-    static const Block SUPPLEMENTAL_ARROWS_B;
+    static const Block& SUPPLEMENTAL_ARROWS_B;
 
     /// \brief The MISCELLANEOUS_MATHEMATICAL_SYMBOLS_B Unicode Block.
-    static const Block MISCELLANEOUS_MATHEMATICAL_SYMBOLS_B;
+    static const Block& MISCELLANEOUS_MATHEMATICAL_SYMBOLS_B;
 
     /// \brief The SUPPLEMENTAL_MATHEMATICAL_OPERATORS Unicode Block.
-    static const Block SUPPLEMENTAL_MATHEMATICAL_OPERATORS;
+    static const Block& SUPPLEMENTAL_MATHEMATICAL_OPERATORS;
 
     /// \brief The MISCELLANEOUS_SYMBOLS_AND_ARROWS Unicode Block.
-    static const Block MISCELLANEOUS_SYMBOLS_AND_ARROWS;
+    static const Block& MISCELLANEOUS_SYMBOLS_AND_ARROWS;
 
     /// \brief The GLAGOLITIC Unicode Block.
-    static const Block GLAGOLITIC;
+    static const Block& GLAGOLITIC;
 
     /// \brief The LATIN_EXTENDED_C Unicode Block.
-    static const Block LATIN_EXTENDED_C;
+    static const Block& LATIN_EXTENDED_C;
 
     /// \brief The COPTIC Unicode Block.
-    static const Block COPTIC;
+    static const Block& COPTIC;
 
     /// \brief The GEORGIAN_SUPPLEMENT Unicode Block.
-    static const Block GEORGIAN_SUPPLEMENT;
+    static const Block& GEORGIAN_SUPPLEMENT;
 
     /// \brief The TIFINAGH Unicode Block.
-    static const Block TIFINAGH;
+    static const Block& TIFINAGH;
 
     /// \brief The ETHIOPIC_EXTENDED Unicode Block.
-    static const Block ETHIOPIC_EXTENDED;
+    static const Block& ETHIOPIC_EXTENDED;
 
     /// \brief The CYRILLIC_EXTENDED_A Unicode Block.
-    static const Block CYRILLIC_EXTENDED_A;
+    static const Block& CYRILLIC_EXTENDED_A;
 
     /// \brief The SUPPLEMENTAL_PUNCTUATION Unicode Block.
-    static const Block SUPPLEMENTAL_PUNCTUATION;
+    static const Block& SUPPLEMENTAL_PUNCTUATION;
 
     /// \brief The CJK_RADICALS_SUPPLEMENT Unicode Block.
-    static const Block CJK_RADICALS_SUPPLEMENT;
+    static const Block& CJK_RADICALS_SUPPLEMENT;
 
     /// \brief The KANGXI_RADICALS Unicode Block.
-    static const Block KANGXI_RADICALS;
+    static const Block& KANGXI_RADICALS;
 
     /// \brief The IDEOGRAPHIC_DESCRIPTION_CHARACTERS Unicode Block.
-    static const Block IDEOGRAPHIC_DESCRIPTION_CHARACTERS;
+    static const Block& IDEOGRAPHIC_DESCRIPTION_CHARACTERS;
 
     /// \brief The CJK_SYMBOLS_AND_PUNCTUATION Unicode Block.
-    static const Block CJK_SYMBOLS_AND_PUNCTUATION;
+    static const Block& CJK_SYMBOLS_AND_PUNCTUATION;
 
     /// \brief The HIRAGANA Unicode Block.
-    static const Block HIRAGANA;
+    static const Block& HIRAGANA;
 
     /// \brief The KATAKANA Unicode Block.
-    static const Block KATAKANA;
+    static const Block& KATAKANA;
 
     /// \brief The BOPOMOFO Unicode Block.
-    static const Block BOPOMOFO;
+    static const Block& BOPOMOFO;
 
     /// \brief The HANGUL_COMPATIBILITY_JAMO Unicode Block.
-    static const Block HANGUL_COMPATIBILITY_JAMO;
+    static const Block& HANGUL_COMPATIBILITY_JAMO;
 
     /// \brief The KANBUN Unicode Block.
-    static const Block KANBUN;
+    static const Block& KANBUN;
 
     /// \brief The BOPOMOFO_EXTENDED Unicode Block.
-    static const Block BOPOMOFO_EXTENDED;
+    static const Block& BOPOMOFO_EXTENDED;
 
     /// \brief The CJK_STROKES Unicode Block.
-    static const Block CJK_STROKES;
+    static const Block& CJK_STROKES;
 
     /// \brief The KATAKANA_PHONETIC_EXTENSIONS Unicode Block.
-    static const Block KATAKANA_PHONETIC_EXTENSIONS;
+    static const Block& KATAKANA_PHONETIC_EXTENSIONS;
 
     /// \brief The ENCLOSED_CJK_LETTERS_AND_MONTHS Unicode Block.
-    static const Block ENCLOSED_CJK_LETTERS_AND_MONTHS;
+    static const Block& ENCLOSED_CJK_LETTERS_AND_MONTHS;
 
     /// \brief The CJK_COMPATIBILITY Unicode Block.
-    static const Block CJK_COMPATIBILITY;
+    static const Block& CJK_COMPATIBILITY;
 
     /// \brief The CJK_UNIFIED_IDEOGRAPHS_EXTENSION_A Unicode Block.
-    static const Block CJK_UNIFIED_IDEOGRAPHS_EXTENSION_A;
+    static const Block& CJK_UNIFIED_IDEOGRAPHS_EXTENSION_A;
 
     /// \brief The YIJING_HEXAGRAM_SYMBOLS Unicode Block.
-    static const Block YIJING_HEXAGRAM_SYMBOLS;
+    static const Block& YIJING_HEXAGRAM_SYMBOLS;
 
     /// \brief The CJK_UNIFIED_IDEOGRAPHS Unicode Block.
-    static const Block CJK_UNIFIED_IDEOGRAPHS;
+    static const Block& CJK_UNIFIED_IDEOGRAPHS;
 
     /// \brief The YI_SYLLABLES Unicode Block.
-    static const Block YI_SYLLABLES;
+    static const Block& YI_SYLLABLES;
 
     /// \brief The YI_RADICALS Unicode Block.
-    static const Block YI_RADICALS;
+    static const Block& YI_RADICALS;
 
     /// \brief The LISU Unicode Block.
-    static const Block LISU;
+    static const Block& LISU;
 
     /// \brief The VAI Unicode Block.
-    static const Block VAI;
+    static const Block& VAI;
 
     /// \brief The CYRILLIC_EXTENDED_B Unicode Block.
-    static const Block CYRILLIC_EXTENDED_B;
+    static const Block& CYRILLIC_EXTENDED_B;
 
     /// \brief The BAMUM Unicode Block.
-    static const Block BAMUM;
+    static const Block& BAMUM;
 
     /// \brief The MODIFIER_TONE_LETTERS Unicode Block.
-    static const Block MODIFIER_TONE_LETTERS;
+    static const Block& MODIFIER_TONE_LETTERS;
 
     /// \brief The LATIN_EXTENDED_D Unicode Block.
-    static const Block LATIN_EXTENDED_D;
+    static const Block& LATIN_EXTENDED_D;
 
     /// \brief The SYLOTI_NAGRI Unicode Block.
-    static const Block SYLOTI_NAGRI;
+    static const Block& SYLOTI_NAGRI;
 
     /// \brief The COMMON_INDIC_NUMBER_FORMS Unicode Block.
-    static const Block COMMON_INDIC_NUMBER_FORMS;
+    static const Block& COMMON_INDIC_NUMBER_FORMS;
 
     /// \brief The PHAGS_PA Unicode Block.
-    static const Block PHAGS_PA;
+    static const Block& PHAGS_PA;
 
     /// \brief The SAURASHTRA Unicode Block.
-    static const Block SAURASHTRA;
+    static const Block& SAURASHTRA;
 
     /// \brief The DEVANAGARI_EXTENDED Unicode Block.
-    static const Block DEVANAGARI_EXTENDED;
+    static const Block& DEVANAGARI_EXTENDED;
 
     /// \brief The KAYAH_LI Unicode Block.
-    static const Block KAYAH_LI;
+    static const Block& KAYAH_LI;
 
     /// \brief The REJANG Unicode Block.
-    static const Block REJANG;
+    static const Block& REJANG;
 
     /// \brief The HANGUL_JAMO_EXTENDED_A Unicode Block.
-    static const Block HANGUL_JAMO_EXTENDED_A;
+    static const Block& HANGUL_JAMO_EXTENDED_A;
 
     /// \brief The JAVANESE Unicode Block.
-    static const Block JAVANESE;
+    static const Block& JAVANESE;
 
     /// \brief The MYANMAR_EXTENDED_B Unicode Block.
-    static const Block MYANMAR_EXTENDED_B;
+    static const Block& MYANMAR_EXTENDED_B;
 
     /// \brief The CHAM Unicode Block.
-    static const Block CHAM;
+    static const Block& CHAM;
 
     /// \brief The MYANMAR_EXTENDED_A Unicode Block.
-    static const Block MYANMAR_EXTENDED_A;
+    static const Block& MYANMAR_EXTENDED_A;
 
     /// \brief The TAI_VIET Unicode Block.
-    static const Block TAI_VIET;
+    static const Block& TAI_VIET;
 
     /// \brief The MEETEI_MAYEK_EXTENSIONS Unicode Block.
-    static const Block MEETEI_MAYEK_EXTENSIONS;
+    static const Block& MEETEI_MAYEK_EXTENSIONS;
 
     /// \brief The ETHIOPIC_EXTENDED_A Unicode Block.
-    static const Block ETHIOPIC_EXTENDED_A;
+    static const Block& ETHIOPIC_EXTENDED_A;
 
     /// \brief The LATIN_EXTENDED_E Unicode Block.
-    static const Block LATIN_EXTENDED_E;
+    static const Block& LATIN_EXTENDED_E;
 
     /// \brief The CHEROKEE_SUPPLEMENT Unicode Block.
-    static const Block CHEROKEE_SUPPLEMENT;
+    static const Block& CHEROKEE_SUPPLEMENT;
 
     /// \brief The MEETEI_MAYEK Unicode Block.
-    static const Block MEETEI_MAYEK;
+    static const Block& MEETEI_MAYEK;
 
     /// \brief The HANGUL_SYLLABLES Unicode Block.
-    static const Block HANGUL_SYLLABLES;
+    static const Block& HANGUL_SYLLABLES;
 
     /// \brief The HANGUL_JAMO_EXTENDED_B Unicode Block.
-    static const Block HANGUL_JAMO_EXTENDED_B;
+    static const Block& HANGUL_JAMO_EXTENDED_B;
 
     /// \brief The HIGH_SURROGATES Unicode Block.
-    static const Block HIGH_SURROGATES;
+    static const Block& HIGH_SURROGATES;
 
     /// \brief The HIGH_PRIVATE_USE_SURROGATES Unicode Block.
-    static const Block HIGH_PRIVATE_USE_SURROGATES;
+    static const Block& HIGH_PRIVATE_USE_SURROGATES;
 
     /// \brief The LOW_SURROGATES Unicode Block.
-    static const Block LOW_SURROGATES;
+    static const Block& LOW_SURROGATES;
 
     /// \brief The PRIVATE_USE_AREA Unicode Block.
-    static const Block PRIVATE_USE_AREA;
+    static const Block& PRIVATE_USE_AREA;
 
     /// \brief The CJK_COMPATIBILITY_IDEOGRAPHS Unicode Block.
-    static const Block CJK_COMPATIBILITY_IDEOGRAPHS;
+    static const Block& CJK_COMPATIBILITY_IDEOGRAPHS;
 
     /// \brief The ALPHABETIC_PRESENTATION_FORMS Unicode Block.
-    static const Block ALPHABETIC_PRESENTATION_FORMS;
+    static const Block& ALPHABETIC_PRESENTATION_FORMS;
 
     /// \brief The ARABIC_PRESENTATION_FORMS_A Unicode Block.
-    static const Block ARABIC_PRESENTATION_FORMS_A;
+    static const Block& ARABIC_PRESENTATION_FORMS_A;
 
     /// \brief The VARIATION_SELECTORS Unicode Block.
-    static const Block VARIATION_SELECTORS;
+    static const Block& VARIATION_SELECTORS;
 
     /// \brief The VERTICAL_FORMS Unicode Block.
-    static const Block VERTICAL_FORMS;
+    static const Block& VERTICAL_FORMS;
 
     /// \brief The COMBINING_HALF_MARKS Unicode Block.
-    static const Block COMBINING_HALF_MARKS;
+    static const Block& COMBINING_HALF_MARKS;
 
     /// \brief The CJK_COMPATIBILITY_FORMS Unicode Block.
-    static const Block CJK_COMPATIBILITY_FORMS;
+    static const Block& CJK_COMPATIBILITY_FORMS;
 
     /// \brief The SMALL_FORM_VARIANTS Unicode Block.
-    static const Block SMALL_FORM_VARIANTS;
+    static const Block& SMALL_FORM_VARIANTS;
 
     /// \brief The ARABIC_PRESENTATION_FORMS_B Unicode Block.
-    static const Block ARABIC_PRESENTATION_FORMS_B;
+    static const Block& ARABIC_PRESENTATION_FORMS_B;
 
     /// \brief The HALFWIDTH_AND_FULLWIDTH_FORMS Unicode Block.
-    static const Block HALFWIDTH_AND_FULLWIDTH_FORMS;
+    static const Block& HALFWIDTH_AND_FULLWIDTH_FORMS;
 
     /// \brief The SPECIALS Unicode Block.
-    static const Block SPECIALS;
+    static const Block& SPECIALS;
 
     /// \brief The LINEAR_B_SYLLABARY Unicode Block.
-    static const Block LINEAR_B_SYLLABARY;
+    static const Block& LINEAR_B_SYLLABARY;
 
     /// \brief The LINEAR_B_IDEOGRAMS Unicode Block.
-    static const Block LINEAR_B_IDEOGRAMS;
+    static const Block& LINEAR_B_IDEOGRAMS;
 
     /// \brief The AEGEAN_NUMBERS Unicode Block.
-    static const Block AEGEAN_NUMBERS;
+    static const Block& AEGEAN_NUMBERS;
 
     /// \brief The ANCIENT_GREEK_NUMBERS Unicode Block.
-    static const Block ANCIENT_GREEK_NUMBERS;
+    static const Block& ANCIENT_GREEK_NUMBERS;
 
     /// \brief The ANCIENT_SYMBOLS Unicode Block.
-    static const Block ANCIENT_SYMBOLS;
+    static const Block& ANCIENT_SYMBOLS;
 
     /// \brief The PHAISTOS_DISC Unicode Block.
-    static const Block PHAISTOS_DISC;
+    static const Block& PHAISTOS_DISC;
 
     /// \brief The LYCIAN Unicode Block.
-    static const Block LYCIAN;
+    static const Block& LYCIAN;
 
     /// \brief The CARIAN Unicode Block.
-    static const Block CARIAN;
+    static const Block& CARIAN;
 
     /// \brief The COPTIC_EPACT_NUMBERS Unicode Block.
-    static const Block COPTIC_EPACT_NUMBERS;
+    static const Block& COPTIC_EPACT_NUMBERS;
 
     /// \brief The OLD_ITALIC Unicode Block.
-    static const Block OLD_ITALIC;
+    static const Block& OLD_ITALIC;
 
     /// \brief The GOTHIC Unicode Block.
-    static const Block GOTHIC;
+    static const Block& GOTHIC;
 
     /// \brief The OLD_PERMIC Unicode Block.
-    static const Block OLD_PERMIC;
+    static const Block& OLD_PERMIC;
 
     /// \brief The UGARITIC Unicode Block.
-    static const Block UGARITIC;
+    static const Block& UGARITIC;
 
     /// \brief The OLD_PERSIAN Unicode Block.
-    static const Block OLD_PERSIAN;
+    static const Block& OLD_PERSIAN;
 
     /// \brief The DESERET Unicode Block.
-    static const Block DESERET;
+    static const Block& DESERET;
 
     /// \brief The SHAVIAN Unicode Block.
-    static const Block SHAVIAN;
+    static const Block& SHAVIAN;
 
     /// \brief The OSMANYA Unicode Block.
-    static const Block OSMANYA;
+    static const Block& OSMANYA;
 
     /// \brief The OSAGE Unicode Block.
-    static const Block OSAGE;
+    static const Block& OSAGE;
 
     /// \brief The ELBASAN Unicode Block.
-    static const Block ELBASAN;
+    static const Block& ELBASAN;
 
     /// \brief The CAUCASIAN_ALBANIAN Unicode Block.
-    static const Block CAUCASIAN_ALBANIAN;
+    static const Block& CAUCASIAN_ALBANIAN;
+
+    /// \brief The VITHKUQI Unicode Block.
+    static const Block& VITHKUQI;
 
     /// \brief The LINEAR_A Unicode Block.
-    static const Block LINEAR_A;
+    static const Block& LINEAR_A;
+
+    /// \brief The LATIN_EXTENDED_F Unicode Block.
+    static const Block& LATIN_EXTENDED_F;
 
     /// \brief The CYPRIOT_SYLLABARY Unicode Block.
-    static const Block CYPRIOT_SYLLABARY;
+    static const Block& CYPRIOT_SYLLABARY;
 
     /// \brief The IMPERIAL_ARAMAIC Unicode Block.
-    static const Block IMPERIAL_ARAMAIC;
+    static const Block& IMPERIAL_ARAMAIC;
 
     /// \brief The PALMYRENE Unicode Block.
-    static const Block PALMYRENE;
+    static const Block& PALMYRENE;
 
     /// \brief The NABATAEAN Unicode Block.
-    static const Block NABATAEAN;
+    static const Block& NABATAEAN;
 
     /// \brief The HATRAN Unicode Block.
-    static const Block HATRAN;
+    static const Block& HATRAN;
 
     /// \brief The PHOENICIAN Unicode Block.
-    static const Block PHOENICIAN;
+    static const Block& PHOENICIAN;
 
     /// \brief The LYDIAN Unicode Block.
-    static const Block LYDIAN;
+    static const Block& LYDIAN;
 
     /// \brief The MEROITIC_HIEROGLYPHS Unicode Block.
-    static const Block MEROITIC_HIEROGLYPHS;
+    static const Block& MEROITIC_HIEROGLYPHS;
 
     /// \brief The MEROITIC_CURSIVE Unicode Block.
-    static const Block MEROITIC_CURSIVE;
+    static const Block& MEROITIC_CURSIVE;
 
     /// \brief The KHAROSHTHI Unicode Block.
-    static const Block KHAROSHTHI;
+    static const Block& KHAROSHTHI;
 
     /// \brief The OLD_SOUTH_ARABIAN Unicode Block.
-    static const Block OLD_SOUTH_ARABIAN;
+    static const Block& OLD_SOUTH_ARABIAN;
 
     /// \brief The OLD_NORTH_ARABIAN Unicode Block.
-    static const Block OLD_NORTH_ARABIAN;
+    static const Block& OLD_NORTH_ARABIAN;
 
     /// \brief The MANICHAEAN Unicode Block.
-    static const Block MANICHAEAN;
+    static const Block& MANICHAEAN;
 
     /// \brief The AVESTAN Unicode Block.
-    static const Block AVESTAN;
+    static const Block& AVESTAN;
 
     /// \brief The INSCRIPTIONAL_PARTHIAN Unicode Block.
-    static const Block INSCRIPTIONAL_PARTHIAN;
+    static const Block& INSCRIPTIONAL_PARTHIAN;
 
     /// \brief The INSCRIPTIONAL_PAHLAVI Unicode Block.
-    static const Block INSCRIPTIONAL_PAHLAVI;
+    static const Block& INSCRIPTIONAL_PAHLAVI;
 
     /// \brief The PSALTER_PAHLAVI Unicode Block.
-    static const Block PSALTER_PAHLAVI;
+    static const Block& PSALTER_PAHLAVI;
 
     /// \brief The OLD_TURKIC Unicode Block.
-    static const Block OLD_TURKIC;
+    static const Block& OLD_TURKIC;
 
     /// \brief The OLD_HUNGARIAN Unicode Block.
-    static const Block OLD_HUNGARIAN;
+    static const Block& OLD_HUNGARIAN;
 
     /// \brief The HANIFI_ROHINGYA Unicode Block.
-    static const Block HANIFI_ROHINGYA;
+    static const Block& HANIFI_ROHINGYA;
 
     /// \brief The RUMI_NUMERAL_SYMBOLS Unicode Block.
-    static const Block RUMI_NUMERAL_SYMBOLS;
+    static const Block& RUMI_NUMERAL_SYMBOLS;
+
+    /// \brief The YEZIDI Unicode Block.
+    static const Block& YEZIDI;
 
     /// \brief The OLD_SOGDIAN Unicode Block.
-    static const Block OLD_SOGDIAN;
+    static const Block& OLD_SOGDIAN;
 
     /// \brief The SOGDIAN Unicode Block.
-    static const Block SOGDIAN;
+    static const Block& SOGDIAN;
+
+    /// \brief The OLD_UYGHUR Unicode Block.
+    static const Block& OLD_UYGHUR;
+
+    /// \brief The CHORASMIAN Unicode Block.
+    static const Block& CHORASMIAN;
 
     /// \brief The ELYMAIC Unicode Block.
-    static const Block ELYMAIC;
+    static const Block& ELYMAIC;
 
     /// \brief The BRAHMI Unicode Block.
-    static const Block BRAHMI;
+    static const Block& BRAHMI;
 
     /// \brief The KAITHI Unicode Block.
-    static const Block KAITHI;
+    static const Block& KAITHI;
 
     /// \brief The SORA_SOMPENG Unicode Block.
-    static const Block SORA_SOMPENG;
+    static const Block& SORA_SOMPENG;
 
     /// \brief The CHAKMA Unicode Block.
-    static const Block CHAKMA;
+    static const Block& CHAKMA;
 
     /// \brief The MAHAJANI Unicode Block.
-    static const Block MAHAJANI;
+    static const Block& MAHAJANI;
 
     /// \brief The SHARADA Unicode Block.
-    static const Block SHARADA;
+    static const Block& SHARADA;
 
     /// \brief The SINHALA_ARCHAIC_NUMBERS Unicode Block.
-    static const Block SINHALA_ARCHAIC_NUMBERS;
+    static const Block& SINHALA_ARCHAIC_NUMBERS;
 
     /// \brief The KHOJKI Unicode Block.
-    static const Block KHOJKI;
+    static const Block& KHOJKI;
 
     /// \brief The MULTANI Unicode Block.
-    static const Block MULTANI;
+    static const Block& MULTANI;
 
     /// \brief The KHUDAWADI Unicode Block.
-    static const Block KHUDAWADI;
+    static const Block& KHUDAWADI;
 
     /// \brief The GRANTHA Unicode Block.
-    static const Block GRANTHA;
+    static const Block& GRANTHA;
 
     /// \brief The NEWA Unicode Block.
-    static const Block NEWA;
+    static const Block& NEWA;
 
     /// \brief The TIRHUTA Unicode Block.
-    static const Block TIRHUTA;
+    static const Block& TIRHUTA;
 
     /// \brief The SIDDHAM Unicode Block.
-    static const Block SIDDHAM;
+    static const Block& SIDDHAM;
 
     /// \brief The MODI Unicode Block.
-    static const Block MODI;
+    static const Block& MODI;
 
     /// \brief The MONGOLIAN_SUPPLEMENT Unicode Block.
-    static const Block MONGOLIAN_SUPPLEMENT;
+    static const Block& MONGOLIAN_SUPPLEMENT;
 
     /// \brief The TAKRI Unicode Block.
-    static const Block TAKRI;
+    static const Block& TAKRI;
 
     /// \brief The AHOM Unicode Block.
-    static const Block AHOM;
+    static const Block& AHOM;
 
     /// \brief The DOGRA Unicode Block.
-    static const Block DOGRA;
+    static const Block& DOGRA;
 
     /// \brief The WARANG_CITI Unicode Block.
-    static const Block WARANG_CITI;
+    static const Block& WARANG_CITI;
+
+    /// \brief The DIVES_AKURU Unicode Block.
+    static const Block& DIVES_AKURU;
 
     /// \brief The NANDINAGARI Unicode Block.
-    static const Block NANDINAGARI;
+    static const Block& NANDINAGARI;
 
     /// \brief The ZANABAZAR_SQUARE Unicode Block.
-    static const Block ZANABAZAR_SQUARE;
+    static const Block& ZANABAZAR_SQUARE;
 
     /// \brief The SOYOMBO Unicode Block.
-    static const Block SOYOMBO;
+    static const Block& SOYOMBO;
+
+    /// \brief The UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED_A Unicode Block.
+    static const Block& UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED_A;
 
     /// \brief The PAU_CIN_HAU Unicode Block.
-    static const Block PAU_CIN_HAU;
+    static const Block& PAU_CIN_HAU;
 
     /// \brief The BHAIKSUKI Unicode Block.
-    static const Block BHAIKSUKI;
+    static const Block& BHAIKSUKI;
 
     /// \brief The MARCHEN Unicode Block.
-    static const Block MARCHEN;
+    static const Block& MARCHEN;
 
     /// \brief The MASARAM_GONDI Unicode Block.
-    static const Block MASARAM_GONDI;
+    static const Block& MASARAM_GONDI;
 
     /// \brief The GUNJALA_GONDI Unicode Block.
-    static const Block GUNJALA_GONDI;
+    static const Block& GUNJALA_GONDI;
 
     /// \brief The MAKASAR Unicode Block.
-    static const Block MAKASAR;
+    static const Block& MAKASAR;
+
+    /// \brief The LISU_SUPPLEMENT Unicode Block.
+    static const Block& LISU_SUPPLEMENT;
 
     /// \brief The TAMIL_SUPPLEMENT Unicode Block.
-    static const Block TAMIL_SUPPLEMENT;
+    static const Block& TAMIL_SUPPLEMENT;
 
     /// \brief The CUNEIFORM Unicode Block.
-    static const Block CUNEIFORM;
+    static const Block& CUNEIFORM;
 
     /// \brief The CUNEIFORM_NUMBERS_AND_PUNCTUATION Unicode Block.
-    static const Block CUNEIFORM_NUMBERS_AND_PUNCTUATION;
+    static const Block& CUNEIFORM_NUMBERS_AND_PUNCTUATION;
 
     /// \brief The EARLY_DYNASTIC_CUNEIFORM Unicode Block.
-    static const Block EARLY_DYNASTIC_CUNEIFORM;
+    static const Block& EARLY_DYNASTIC_CUNEIFORM;
+
+    /// \brief The CYPRO_MINOAN Unicode Block.
+    static const Block& CYPRO_MINOAN;
 
     /// \brief The EGYPTIAN_HIEROGLYPHS Unicode Block.
-    static const Block EGYPTIAN_HIEROGLYPHS;
+    static const Block& EGYPTIAN_HIEROGLYPHS;
 
     /// \brief The EGYPTIAN_HIEROGLYPH_FORMAT_CONTROLS Unicode Block.
-    static const Block EGYPTIAN_HIEROGLYPH_FORMAT_CONTROLS;
+    static const Block& EGYPTIAN_HIEROGLYPH_FORMAT_CONTROLS;
 
     /// \brief The ANATOLIAN_HIEROGLYPHS Unicode Block.
-    static const Block ANATOLIAN_HIEROGLYPHS;
+    static const Block& ANATOLIAN_HIEROGLYPHS;
 
     /// \brief The BAMUM_SUPPLEMENT Unicode Block.
-    static const Block BAMUM_SUPPLEMENT;
+    static const Block& BAMUM_SUPPLEMENT;
 
     /// \brief The MRO Unicode Block.
-    static const Block MRO;
+    static const Block& MRO;
+
+    /// \brief The TANGSA Unicode Block.
+    static const Block& TANGSA;
 
     /// \brief The BASSA_VAH Unicode Block.
-    static const Block BASSA_VAH;
+    static const Block& BASSA_VAH;
 
     /// \brief The PAHAWH_HMONG Unicode Block.
-    static const Block PAHAWH_HMONG;
+    static const Block& PAHAWH_HMONG;
 
     /// \brief The MEDEFAIDRIN Unicode Block.
-    static const Block MEDEFAIDRIN;
+    static const Block& MEDEFAIDRIN;
 
     /// \brief The MIAO Unicode Block.
-    static const Block MIAO;
+    static const Block& MIAO;
 
     /// \brief The IDEOGRAPHIC_SYMBOLS_AND_PUNCTUATION Unicode Block.
-    static const Block IDEOGRAPHIC_SYMBOLS_AND_PUNCTUATION;
+    static const Block& IDEOGRAPHIC_SYMBOLS_AND_PUNCTUATION;
 
     /// \brief The TANGUT Unicode Block.
-    static const Block TANGUT;
+    static const Block& TANGUT;
 
     /// \brief The TANGUT_COMPONENTS Unicode Block.
-    static const Block TANGUT_COMPONENTS;
+    static const Block& TANGUT_COMPONENTS;
+
+    /// \brief The KHITAN_SMALL_SCRIPT Unicode Block.
+    static const Block& KHITAN_SMALL_SCRIPT;
+
+    /// \brief The TANGUT_SUPPLEMENT Unicode Block.
+    static const Block& TANGUT_SUPPLEMENT;
+
+    /// \brief The KANA_EXTENDED_B Unicode Block.
+    static const Block& KANA_EXTENDED_B;
 
     /// \brief The KANA_SUPPLEMENT Unicode Block.
-    static const Block KANA_SUPPLEMENT;
+    static const Block& KANA_SUPPLEMENT;
 
     /// \brief The KANA_EXTENDED_A Unicode Block.
-    static const Block KANA_EXTENDED_A;
+    static const Block& KANA_EXTENDED_A;
 
     /// \brief The SMALL_KANA_EXTENSION Unicode Block.
-    static const Block SMALL_KANA_EXTENSION;
+    static const Block& SMALL_KANA_EXTENSION;
 
     /// \brief The NUSHU Unicode Block.
-    static const Block NUSHU;
+    static const Block& NUSHU;
 
     /// \brief The DUPLOYAN Unicode Block.
-    static const Block DUPLOYAN;
+    static const Block& DUPLOYAN;
 
     /// \brief The SHORTHAND_FORMAT_CONTROLS Unicode Block.
-    static const Block SHORTHAND_FORMAT_CONTROLS;
+    static const Block& SHORTHAND_FORMAT_CONTROLS;
+
+    /// \brief The ZNAMENNY_MUSICAL_NOTATION Unicode Block.
+    static const Block& ZNAMENNY_MUSICAL_NOTATION;
 
     /// \brief The BYZANTINE_MUSICAL_SYMBOLS Unicode Block.
-    static const Block BYZANTINE_MUSICAL_SYMBOLS;
+    static const Block& BYZANTINE_MUSICAL_SYMBOLS;
 
     /// \brief The MUSICAL_SYMBOLS Unicode Block.
-    static const Block MUSICAL_SYMBOLS;
+    static const Block& MUSICAL_SYMBOLS;
 
     /// \brief The ANCIENT_GREEK_MUSICAL_NOTATION Unicode Block.
-    static const Block ANCIENT_GREEK_MUSICAL_NOTATION;
+    static const Block& ANCIENT_GREEK_MUSICAL_NOTATION;
 
     /// \brief The MAYAN_NUMERALS Unicode Block.
-    static const Block MAYAN_NUMERALS;
+    static const Block& MAYAN_NUMERALS;
 
     /// \brief The TAI_XUAN_JING_SYMBOLS Unicode Block.
-    static const Block TAI_XUAN_JING_SYMBOLS;
+    static const Block& TAI_XUAN_JING_SYMBOLS;
 
     /// \brief The COUNTING_ROD_NUMERALS Unicode Block.
-    static const Block COUNTING_ROD_NUMERALS;
+    static const Block& COUNTING_ROD_NUMERALS;
 
     /// \brief The MATHEMATICAL_ALPHANUMERIC_SYMBOLS Unicode Block.
-    static const Block MATHEMATICAL_ALPHANUMERIC_SYMBOLS;
+    static const Block& MATHEMATICAL_ALPHANUMERIC_SYMBOLS;
 
     /// \brief The SUTTON_SIGNWRITING Unicode Block.
-    static const Block SUTTON_SIGNWRITING;
+    static const Block& SUTTON_SIGNWRITING;
+
+    /// \brief The LATIN_EXTENDED_G Unicode Block.
+    static const Block& LATIN_EXTENDED_G;
 
     /// \brief The GLAGOLITIC_SUPPLEMENT Unicode Block.
-    static const Block GLAGOLITIC_SUPPLEMENT;
+    static const Block& GLAGOLITIC_SUPPLEMENT;
 
     /// \brief The NYIAKENG_PUACHUE_HMONG Unicode Block.
-    static const Block NYIAKENG_PUACHUE_HMONG;
+    static const Block& NYIAKENG_PUACHUE_HMONG;
+
+    /// \brief The TOTO Unicode Block.
+    static const Block& TOTO;
 
     /// \brief The WANCHO Unicode Block.
-    static const Block WANCHO;
+    static const Block& WANCHO;
+
+    /// \brief The ETHIOPIC_EXTENDED_B Unicode Block.
+    static const Block& ETHIOPIC_EXTENDED_B;
 
     /// \brief The MENDE_KIKAKUI Unicode Block.
-    static const Block MENDE_KIKAKUI;
+    static const Block& MENDE_KIKAKUI;
 
     /// \brief The ADLAM Unicode Block.
-    static const Block ADLAM;
+    static const Block& ADLAM;
 
     /// \brief The INDIC_SIYAQ_NUMBERS Unicode Block.
-    static const Block INDIC_SIYAQ_NUMBERS;
+    static const Block& INDIC_SIYAQ_NUMBERS;
 
     /// \brief The OTTOMAN_SIYAQ_NUMBERS Unicode Block.
-    static const Block OTTOMAN_SIYAQ_NUMBERS;
+    static const Block& OTTOMAN_SIYAQ_NUMBERS;
 
     /// \brief The ARABIC_MATHEMATICAL_ALPHABETIC_SYMBOLS Unicode Block.
-    static const Block ARABIC_MATHEMATICAL_ALPHABETIC_SYMBOLS;
+    static const Block& ARABIC_MATHEMATICAL_ALPHABETIC_SYMBOLS;
 
     /// \brief The MAHJONG_TILES Unicode Block.
-    static const Block MAHJONG_TILES;
+    static const Block& MAHJONG_TILES;
 
     /// \brief The DOMINO_TILES Unicode Block.
-    static const Block DOMINO_TILES;
+    static const Block& DOMINO_TILES;
 
     /// \brief The PLAYING_CARDS Unicode Block.
-    static const Block PLAYING_CARDS;
+    static const Block& PLAYING_CARDS;
 
     /// \brief The ENCLOSED_ALPHANUMERIC_SUPPLEMENT Unicode Block.
-    static const Block ENCLOSED_ALPHANUMERIC_SUPPLEMENT;
+    static const Block& ENCLOSED_ALPHANUMERIC_SUPPLEMENT;
 
     /// \brief The ENCLOSED_IDEOGRAPHIC_SUPPLEMENT Unicode Block.
-    static const Block ENCLOSED_IDEOGRAPHIC_SUPPLEMENT;
+    static const Block& ENCLOSED_IDEOGRAPHIC_SUPPLEMENT;
 
     /// \brief The MISCELLANEOUS_SYMBOLS_AND_PICTOGRAPHS Unicode Block.
-    static const Block MISCELLANEOUS_SYMBOLS_AND_PICTOGRAPHS;
+    static const Block& MISCELLANEOUS_SYMBOLS_AND_PICTOGRAPHS;
 
     /// \brief The EMOTICONS Unicode Block.
-    static const Block EMOTICONS;
+    static const Block& EMOTICONS;
 
     /// \brief The ORNAMENTAL_DINGBATS Unicode Block.
-    static const Block ORNAMENTAL_DINGBATS;
+    static const Block& ORNAMENTAL_DINGBATS;
 
     /// \brief The TRANSPORT_AND_MAP_SYMBOLS Unicode Block.
-    static const Block TRANSPORT_AND_MAP_SYMBOLS;
+    static const Block& TRANSPORT_AND_MAP_SYMBOLS;
 
     /// \brief The ALCHEMICAL_SYMBOLS Unicode Block.
-    static const Block ALCHEMICAL_SYMBOLS;
+    static const Block& ALCHEMICAL_SYMBOLS;
 
     /// \brief The GEOMETRIC_SHAPES_EXTENDED Unicode Block.
-    static const Block GEOMETRIC_SHAPES_EXTENDED;
+    static const Block& GEOMETRIC_SHAPES_EXTENDED;
 
     /// \brief The SUPPLEMENTAL_ARROWS_C Unicode Block.
-    static const Block SUPPLEMENTAL_ARROWS_C;
+    static const Block& SUPPLEMENTAL_ARROWS_C;
 
     /// \brief The SUPPLEMENTAL_SYMBOLS_AND_PICTOGRAPHS Unicode Block.
-    static const Block SUPPLEMENTAL_SYMBOLS_AND_PICTOGRAPHS;
+    static const Block& SUPPLEMENTAL_SYMBOLS_AND_PICTOGRAPHS;
 
     /// \brief The CHESS_SYMBOLS Unicode Block.
-    static const Block CHESS_SYMBOLS;
+    static const Block& CHESS_SYMBOLS;
 
     /// \brief The SYMBOLS_AND_PICTOGRAPHS_EXTENDED_A Unicode Block.
-    static const Block SYMBOLS_AND_PICTOGRAPHS_EXTENDED_A;
+    static const Block& SYMBOLS_AND_PICTOGRAPHS_EXTENDED_A;
+
+    /// \brief The SYMBOLS_FOR_LEGACY_COMPUTING Unicode Block.
+    static const Block& SYMBOLS_FOR_LEGACY_COMPUTING;
 
     /// \brief The CJK_UNIFIED_IDEOGRAPHS_EXTENSION_B Unicode Block.
-    static const Block CJK_UNIFIED_IDEOGRAPHS_EXTENSION_B;
+    static const Block& CJK_UNIFIED_IDEOGRAPHS_EXTENSION_B;
 
     /// \brief The CJK_UNIFIED_IDEOGRAPHS_EXTENSION_C Unicode Block.
-    static const Block CJK_UNIFIED_IDEOGRAPHS_EXTENSION_C;
+    static const Block& CJK_UNIFIED_IDEOGRAPHS_EXTENSION_C;
 
     /// \brief The CJK_UNIFIED_IDEOGRAPHS_EXTENSION_D Unicode Block.
-    static const Block CJK_UNIFIED_IDEOGRAPHS_EXTENSION_D;
+    static const Block& CJK_UNIFIED_IDEOGRAPHS_EXTENSION_D;
 
     /// \brief The CJK_UNIFIED_IDEOGRAPHS_EXTENSION_E Unicode Block.
-    static const Block CJK_UNIFIED_IDEOGRAPHS_EXTENSION_E;
+    static const Block& CJK_UNIFIED_IDEOGRAPHS_EXTENSION_E;
 
     /// \brief The CJK_UNIFIED_IDEOGRAPHS_EXTENSION_F Unicode Block.
-    static const Block CJK_UNIFIED_IDEOGRAPHS_EXTENSION_F;
+    static const Block& CJK_UNIFIED_IDEOGRAPHS_EXTENSION_F;
 
     /// \brief The CJK_COMPATIBILITY_IDEOGRAPHS_SUPPLEMENT Unicode Block.
-    static const Block CJK_COMPATIBILITY_IDEOGRAPHS_SUPPLEMENT;
+    static const Block& CJK_COMPATIBILITY_IDEOGRAPHS_SUPPLEMENT;
+
+    /// \brief The CJK_UNIFIED_IDEOGRAPHS_EXTENSION_G Unicode Block.
+    static const Block& CJK_UNIFIED_IDEOGRAPHS_EXTENSION_G;
 
     /// \brief The TAGS Unicode Block.
-    static const Block TAGS;
+    static const Block& TAGS;
 
     /// \brief The VARIATION_SELECTORS_SUPPLEMENT Unicode Block.
-    static const Block VARIATION_SELECTORS_SUPPLEMENT;
+    static const Block& VARIATION_SELECTORS_SUPPLEMENT;
 
     /// \brief The SUPPLEMENTARY_PRIVATE_USE_AREA_A Unicode Block.
-    static const Block SUPPLEMENTARY_PRIVATE_USE_AREA_A;
+    static const Block& SUPPLEMENTARY_PRIVATE_USE_AREA_A;
 
     /// \brief The SUPPLEMENTARY_PRIVATE_USE_AREA_B Unicode Block.
-    static const Block SUPPLEMENTARY_PRIVATE_USE_AREA_B;
+    static const Block& SUPPLEMENTARY_PRIVATE_USE_AREA_B;
+
+    // END GENERATED UNICODE BLOCKS
 
 
 };
 
 
+template<typename Breaker>
+class PackedBreaks;
+
+
 /// \brief A class for breaking lines according to the Unicode standard.
 class Linebreaker
 {
@@ -1015,32 +1227,368 @@ public:
         INSIDE_CHAR = LINEBREAK_INSIDEACHAR
     };
 
+    /// \brief A break opportunity at a position in the text.
+    struct Break
+    {
+        /// \brief The offset of the last code unit before the break.
+        std::size_t offset;
+
+        /// \brief The type of break, either MUST_BREAK or ALLOW_BREAK.
+        BreakType type;
+    };
+
+    /// \brief Determine if a BreakType is a break opportunity.
+    /// \param type The BreakType to test.
+    /// \returns true if the type is MUST_BREAK or ALLOW_BREAK.
+    static constexpr bool isBreak(BreakType type)
+    {
+        return type == BreakType::MUST_BREAK || type == BreakType::ALLOW_BREAK;
+    }
+
+    class Stream;
+    class Index;
+
+    /// \brief Settings for parallel line breaking.
+    struct ParallelSettings
+    {
+        ParallelSettings(): numThreads(0), minChunkSize(1 << 16)
+        {
+        }
+
+        /// \brief The number of worker threads.
+        ///
+        /// If 0, std::thread::hardware_concurrency() is used.
+        std::size_t numThreads;
+
+        /// \brief The minimum number of code units in each work item.
+        ///
+        /// Paragraphs are grouped until a work item reaches this size.
+        std::size_t minChunkSize;
+    };
+
+    /// \brief Create a Linebreaker.
+    ///
+    /// The language's line breaking tailoring is resolved once here, so the
+    /// member findBreaks() functions do not search for it on every call.
+    ///
+    /// \param language The language used for line breaking.
     Linebreaker(const std::string& language = "en");
 
     ~Linebreaker();
 
     const std::string& language() const;
 
-    std::vector<BreakType> findBreaks(const std::string& text) const;
-    std::vector<BreakType> findBreaks(const std::u16string& text) const;
-    std::vector<BreakType> findBreaks(const std::u32string& text) const;
+    /// \brief Create a Stream that breaks lines using this language.
+    /// \returns a new Stream.
+    Stream stream() const;
+
+    std::vector<BreakType> findBreaks(std::string_view text) const;
+    std::vector<BreakType> findBreaks(std::u16string_view text) const;
+    std::vector<BreakType> findBreaks(std::u32string_view text) const;
 
-    static std::vector<BreakType> findBreaks(const std::string& text,
+    static std::vector<BreakType> findBreaks(std::string_view text,
                                              const std::string& language);
 
-    static std::vector<BreakType> findBreaks(const std::u16string& text,
+    static std::vector<BreakType> findBreaks(std::u16string_view text,
                                              const std::string& language);
 
-    static std::vector<BreakType> findBreaks(const std::u32string& text,
+    static std::vector<BreakType> findBreaks(std::u32string_view text,
                                              const std::string& language);
 
+    /// \brief Find the breaks, reusing an output list.
+    ///
+    /// The list is resized to the length of the text. Reusing the same list
+    /// across calls keeps its capacity and avoids an allocation per call.
+    ///
+    /// \param text The text to break.
+    /// \param breaks The list to fill with one BreakType per code unit.
+    void findBreaks(std::string_view text, std::vector<BreakType>& breaks) const;
+    void findBreaks(std::u16string_view text, std::vector<BreakType>& breaks) const;
+    void findBreaks(std::u32string_view text, std::vector<BreakType>& breaks) const;
+
+    static void findBreaks(std::string_view text,
+                           const std::string& language,
+                           std::vector<BreakType>& breaks);
+
+    static void findBreaks(std::u16string_view text,
+                           const std::string& language,
+                           std::vector<BreakType>& breaks);
+
+    static void findBreaks(std::u32string_view text,
+                           const std::string& language,
+                           std::vector<BreakType>& breaks);
+
+    /// \brief Find the breaks, writing into a caller-supplied buffer.
+    /// \param text The text to break.
+    /// \param breaks The buffer to fill with one BreakType per code unit.
+    /// \param size The size of the buffer, at least the length of the text.
+    /// \returns the number of breaks written or 0 if the buffer is too small.
+    std::size_t findBreaks(std::string_view text, BreakType* breaks, std::size_t size) const;
+    std::size_t findBreaks(std::u16string_view text, BreakType* breaks, std::size_t size) const;
+    std::size_t findBreaks(std::u32string_view text, BreakType* breaks, std::size_t size) const;
+
+    static std::size_t findBreaks(std::string_view text,
+                                  const std::string& language,
+                                  BreakType* breaks,
+                                  std::size_t size);
+
+    static std::size_t findBreaks(std::u16string_view text,
+                                  const std::string& language,
+                                  BreakType* breaks,
+                                  std::size_t size);
+
+    static std::size_t findBreaks(std::u32string_view text,
+                                  const std::string& language,
+                                  BreakType* breaks,
+                                  std::size_t size);
+
+    /// \brief Find the breaks for a large text using multiple threads.
+    ///
+    /// A line feed is always a mandatory break and resets the break state, so
+    /// the text is split after line feeds into paragraph groups that are
+    /// broken independently. Work items are claimed dynamically by the
+    /// worker threads and each writes directly into its own region of the
+    /// single output list. The results are identical to findBreaks().
+    ///
+    /// \param text The text to break.
+    /// \param breaks The list to fill with one BreakType per code unit.
+    /// \param settings The ParallelSettings to use.
+    void findBreaksParallel(std::string_view text,
+                            std::vector<BreakType>& breaks,
+                            const ParallelSettings& settings = ParallelSettings()) const;
+
+    void findBreaksParallel(std::u16string_view text,
+                            std::vector<BreakType>& breaks,
+                            const ParallelSettings& settings = ParallelSettings()) const;
+
+    void findBreaksParallel(std::u32string_view text,
+                            std::vector<BreakType>& breaks,
+                            const ParallelSettings& settings = ParallelSettings()) const;
+
+    static void findBreaksParallel(std::string_view text,
+                                   const std::string& language,
+                                   std::vector<BreakType>& breaks,
+                                   const ParallelSettings& settings = ParallelSettings());
+
+    static void findBreaksParallel(std::u16string_view text,
+                                   const std::string& language,
+                                   std::vector<BreakType>& breaks,
+                                   const ParallelSettings& settings = ParallelSettings());
+
+    static void findBreaksParallel(std::u32string_view text,
+                                   const std::string& language,
+                                   std::vector<BreakType>& breaks,
+                                   const ParallelSettings& settings = ParallelSettings());
+
+    /// \brief Find the break opportunities as a sorted list of offsets.
+    ///
+    /// Only MUST_BREAK and ALLOW_BREAK positions are stored, which is much
+    /// smaller than one BreakType per code unit for most text.
+    ///
+    /// \param text The text to break.
+    /// \returns the sorted break opportunities.
+    std::vector<Break> findBreakOffsets(std::string_view text) const;
+    std::vector<Break> findBreakOffsets(std::u16string_view text) const;
+    std::vector<Break> findBreakOffsets(std::u32string_view text) const;
+
+    static std::vector<Break> findBreakOffsets(std::string_view text,
+                                               const std::string& language);
+
+    static std::vector<Break> findBreakOffsets(std::u16string_view text,
+                                               const std::string& language);
+
+    static std::vector<Break> findBreakOffsets(std::u32string_view text,
+                                               const std::string& language);
+
+    /// \brief Find the breaks packed into 2 bits per code unit.
+    /// \param text The text to break.
+    /// \returns the packed breaks.
+    PackedBreaks<Linebreaker> findPackedBreaks(std::string_view text) const;
+    PackedBreaks<Linebreaker> findPackedBreaks(std::u16string_view text) const;
+    PackedBreaks<Linebreaker> findPackedBreaks(std::u32string_view text) const;
+
+    static PackedBreaks<Linebreaker> findPackedBreaks(std::string_view text,
+                                                      const std::string& language);
+
+    static PackedBreaks<Linebreaker> findPackedBreaks(std::u16string_view text,
+                                                      const std::string& language);
+
+    static PackedBreaks<Linebreaker> findPackedBreaks(std::u32string_view text,
+                                                      const std::string& language);
+
 protected:
     /// \brief The language used for line breaking.
     std::string _language;
+
+    /// \brief The language resolved to its libunibreak tailoring, or nullptr.
+    const LineBreakPropertiesLang* _resolvedLanguage = nullptr;
     
 };
 
 
+/// \brief Break lines incrementally over chunked input.
+///
+/// Text is fed in chunks of any size. Break context, including multi-byte
+/// sequences split across chunk boundaries, is carried from one chunk to the
+/// next. Break opportunities are emitted as soon as they are resolved, which
+/// is once the character following the break has been seen.
+///
+/// All chunks fed to a Stream should share one encoding. Break offsets are
+/// counted in code units of that encoding from the start of the stream.
+/// Incomplete sequences at the end of the stream are ignored, and invalid
+/// sequences are treated as U+FFFD.
+class Linebreaker::Stream
+{
+public:
+    /// \brief Create a Stream.
+    /// \param language The language used for line breaking.
+    Stream(const std::string& language = "en");
+
+    /// \brief Destroy the Stream.
+    ~Stream();
+
+    /// \returns the language used for line breaking.
+    const std::string& language() const;
+
+    /// \brief Break the next chunk of UTF-8 text.
+    /// \param chunk The next chunk of text.
+    /// \param breaks The list to which resolved breaks are appended.
+    /// \returns the number of breaks appended.
+    std::size_t feed(std::string_view chunk, std::vector<Break>& breaks);
+
+    /// \brief Break the next chunk of UTF-16 text.
+    /// \param chunk The next chunk of text.
+    /// \param breaks The list to which resolved breaks are appended.
+    /// \returns the number of breaks appended.
+    std::size_t feed(std::u16string_view chunk, std::vector<Break>& breaks);
+
+    /// \brief Break the next chunk of UTF-32 text.
+    /// \param chunk The next chunk of text.
+    /// \param breaks The list to which resolved breaks are appended.
+    /// \returns the number of breaks appended.
+    std::size_t feed(std::u32string_view chunk, std::vector<Break>& breaks);
+
+    /// \brief End the stream and resolve the final break.
+    ///
+    /// The end of the text is always a MUST_BREAK. After finishing, the
+    /// Stream is reset and can be reused.
+    ///
+    /// \param breaks The list to which resolved breaks are appended.
+    /// \returns the number of breaks appended.
+    std::size_t finish(std::vector<Break>& breaks);
+
+    /// \brief Discard all state and restart at offset 0.
+    void reset();
+
+    /// \returns the number of code units fed since the last reset.
+    std::size_t offset() const;
+
+private:
+    /// \brief Process one decoded character.
+    /// \param codepoint The character.
+    /// \param last The offset of the character's last code unit.
+    /// \param breaks The list to which a resolved break is appended.
+    /// \returns the number of breaks appended.
+    std::size_t process(char32_t codepoint,
+                        std::size_t last,
+                        std::vector<Break>& breaks);
+
+    /// \brief The language used for line breaking.
+    std::string _language;
+
+    /// \brief The language resolved to its libunibreak tailoring, or nullptr.
+    const LineBreakPropertiesLang* _resolvedLanguage = nullptr;
+
+    /// \brief The libunibreak break context.
+    LineBreakContext _context;
+
+    /// \brief True once the first character has been processed.
+    bool _started = false;
+
+    /// \brief The offset of the last code unit of the previous character.
+    std::size_t _previousLast = 0;
+
+    /// \brief The number of code units fed since the last reset.
+    std::size_t _offset = 0;
+
+    /// \brief The bytes or units of a sequence split across chunks.
+    char32_t _pending[4] = { 0, 0, 0, 0 };
+
+    /// \brief The number of pending code units.
+    std::size_t _numPending = 0;
+
+    /// \brief The number of code units needed to complete the sequence.
+    std::size_t _numExpected = 0;
+
+};
+
+
+/// \brief An editable line break index for a UTF-8 text buffer.
+///
+/// The Index holds a text and its line breaks in the same per-code-unit form
+/// returned by Linebreaker::findBreaks(). When the text is edited, the break
+/// algorithm is re-run starting from a stable break opportunity before the
+/// edit and stops as soon as the new breaks agree with the old breaks at a
+/// break opportunity after the edit. For typical edits this touches a few
+/// words rather than the whole document.
+///
+/// Edits must begin and end on UTF-8 sequence boundaries.
+class Linebreaker::Index
+{
+public:
+    /// \brief Create an Index.
+    /// \param text The initial UTF-8 encoded text.
+    /// \param language The language used for line breaking.
+    Index(const std::string& text = "", const std::string& language = "en");
+
+    /// \brief Destroy the Index.
+    ~Index();
+
+    /// \brief Replace the whole text and recompute all breaks.
+    /// \param text The new UTF-8 encoded text.
+    void setText(const std::string& text);
+
+    /// \brief Edit the text and update the breaks incrementally.
+    /// \param offset The byte offset of the edit.
+    /// \param removed The number of bytes removed at \p offset.
+    /// \param inserted The UTF-8 encoded text inserted at \p offset.
+    /// \returns the [begin, end) byte range whose breaks were recomputed.
+    std::pair<std::size_t, std::size_t> edit(std::size_t offset,
+                                             std::size_t removed,
+                                             const std::string& inserted);
+
+    /// \returns the current text.
+    const std::string& text() const;
+
+    /// \returns the current breaks, one per byte of text().
+    const std::vector<BreakType>& breaks() const;
+
+    /// \returns the language used for line breaking.
+    const std::string& language() const;
+
+private:
+    /// \brief Recompute breaks starting at a character boundary.
+    /// \param begin The byte offset at which to restart the algorithm.
+    /// \param stableAfter Stop at the first unchanged break opportunity at or
+    ///        after this offset.
+    /// \returns the end of the recomputed byte range.
+    std::size_t rebreak(std::size_t begin, std::size_t stableAfter);
+
+    /// \brief The language used for line breaking.
+    std::string _language;
+
+    /// \brief The language resolved to its libunibreak tailoring, or nullptr.
+    const LineBreakPropertiesLang* _resolvedLanguage = nullptr;
+
+    /// \brief The UTF-8 encoded text.
+    std::string _text;
+
+    /// \brief The breaks, one per byte of text.
+    std::vector<BreakType> _breaks;
+
+};
+
+
 /// \brief A class for breaking lines according to the Unicode standard.
 class Wordbreaker
 {
@@ -1055,31 +1603,422 @@ public:
         INSIDE_CHAR = WORDBREAK_INSIDEACHAR
     };
 
+    /// \brief A break opportunity at a position in the text.
+    struct Break
+    {
+        /// \brief The offset of the last code unit before the break.
+        std::size_t offset;
+
+        /// \brief The type of break, always ALLOW_BREAK.
+        BreakType type;
+    };
+
+    /// \brief Determine if a BreakType is a break opportunity.
+    /// \param type The BreakType to test.
+    /// \returns true if the type is ALLOW_BREAK.
+    static constexpr bool isBreak(BreakType type)
+    {
+        return type == BreakType::ALLOW_BREAK;
+    }
+
     Wordbreaker(const std::string& language = "en");
 
     ~Wordbreaker();
 
     const std::string& language() const;
 
-    std::vector<BreakType> findBreaks(const std::string& text) const;
-    std::vector<BreakType> findBreaks(const std::u16string& text) const;
-    std::vector<BreakType> findBreaks(const std::u32string& text) const;
+    std::vector<BreakType> findBreaks(std::string_view text) const;
+    std::vector<BreakType> findBreaks(std::u16string_view text) const;
+    std::vector<BreakType> findBreaks(std::u32string_view text) const;
 
-    static std::vector<BreakType> findBreaks(const std::string& text,
+    static std::vector<BreakType> findBreaks(std::string_view text,
                                              const std::string& language);
 
-    static std::vector<BreakType> findBreaks(const std::u16string& text,
+    static std::vector<BreakType> findBreaks(std::u16string_view text,
                                              const std::string& language);
 
-    static std::vector<BreakType> findBreaks(const std::u32string& text,
+    static std::vector<BreakType> findBreaks(std::u32string_view text,
                                              const std::string& language);
 
+    /// \brief Find the breaks, reusing an output list.
+    ///
+    /// The list is resized to the length of the text. Reusing the same list
+    /// across calls keeps its capacity and avoids an allocation per call.
+    ///
+    /// \param text The text to break.
+    /// \param breaks The list to fill with one BreakType per code unit.
+    void findBreaks(std::string_view text, std::vector<BreakType>& breaks) const;
+    void findBreaks(std::u16string_view text, std::vector<BreakType>& breaks) const;
+    void findBreaks(std::u32string_view text, std::vector<BreakType>& breaks) const;
+
+    static void findBreaks(std::string_view text,
+                           const std::string& language,
+                           std::vector<BreakType>& breaks);
+
+    static void findBreaks(std::u16string_view text,
+                           const std::string& language,
+                           std::vector<BreakType>& breaks);
+
+    static void findBreaks(std::u32string_view text,
+                           const std::string& language,
+                           std::vector<BreakType>& breaks);
+
+    /// \brief Find the breaks, writing into a caller-supplied buffer.
+    /// \param text The text to break.
+    /// \param breaks The buffer to fill with one BreakType per code unit.
+    /// \param size The size of the buffer, at least the length of the text.
+    /// \returns the number of breaks written or 0 if the buffer is too small.
+    std::size_t findBreaks(std::string_view text, BreakType* breaks, std::size_t size) const;
+    std::size_t findBreaks(std::u16string_view text, BreakType* breaks, std::size_t size) const;
+    std::size_t findBreaks(std::u32string_view text, BreakType* breaks, std::size_t size) const;
+
+    static std::size_t findBreaks(std::string_view text,
+                                  const std::string& language,
+                                  BreakType* breaks,
+                                  std::size_t size);
+
+    static std::size_t findBreaks(std::u16string_view text,
+                                  const std::string& language,
+                                  BreakType* breaks,
+                                  std::size_t size);
+
+    static std::size_t findBreaks(std::u32string_view text,
+                                  const std::string& language,
+                                  BreakType* breaks,
+                                  std::size_t size);
+
+    /// \brief Find the break opportunities as a sorted list of offsets.
+    /// \param text The text to break.
+    /// \returns the sorted break opportunities.
+    std::vector<Break> findBreakOffsets(std::string_view text) const;
+    std::vector<Break> findBreakOffsets(std::u16string_view text) const;
+    std::vector<Break> findBreakOffsets(std::u32string_view text) const;
+
+    static std::vector<Break> findBreakOffsets(std::string_view text,
+                                               const std::string& language);
+
+    static std::vector<Break> findBreakOffsets(std::u16string_view text,
+                                               const std::string& language);
+
+    static std::vector<Break> findBreakOffsets(std::u32string_view text,
+                                               const std::string& language);
+
+    /// \brief Find the breaks packed into 2 bits per code unit.
+    /// \param text The text to break.
+    /// \returns the packed breaks.
+    PackedBreaks<Wordbreaker> findPackedBreaks(std::string_view text) const;
+    PackedBreaks<Wordbreaker> findPackedBreaks(std::u16string_view text) const;
+    PackedBreaks<Wordbreaker> findPackedBreaks(std::u32string_view text) const;
+
+    static PackedBreaks<Wordbreaker> findPackedBreaks(std::string_view text,
+                                                      const std::string& language);
+
+    static PackedBreaks<Wordbreaker> findPackedBreaks(std::u16string_view text,
+                                                      const std::string& language);
+
+    static PackedBreaks<Wordbreaker> findPackedBreaks(std::u32string_view text,
+                                                      const std::string& language);
+
 protected:
     std::string _language;
     
 };
 
 
+/// \brief Break results packed into 2 bits per code unit.
+///
+/// Each BreakType value fits in 2 bits, so 32 code units are stored in each
+/// 64-bit word, a quarter of the memory of a std::vector<BreakType>. Finding
+/// the next break tests a whole word at a time and uses a count trailing
+/// zeros instruction to jump directly to the break.
+///
+/// \tparam Breaker Either Linebreaker or Wordbreaker.
+template<typename Breaker>
+class PackedBreaks
+{
+public:
+    typedef typename Breaker::BreakType BreakType;
+
+    /// \brief The value returned when there are no more breaks.
+    static constexpr std::size_t npos = std::size_t(-1);
+
+    /// \brief Create an empty PackedBreaks.
+    PackedBreaks()
+    {
+    }
+
+    /// \brief Pack a list of breaks.
+    /// \param breaks The breaks, one per code unit.
+    /// \param size The number of breaks.
+    PackedBreaks(const BreakType* breaks, std::size_t size):
+        _words((size + UNITS_PER_WORD - 1) / UNITS_PER_WORD, 0),
+        _size(size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            _words[i / UNITS_PER_WORD] |= uint64_t(static_cast<unsigned char>(breaks[i]) & 3)
+                                       << (2 * (i % UNITS_PER_WORD));
+        }
+    }
+
+    /// \brief Pack a list of breaks.
+    /// \param breaks The breaks, one per code unit.
+    PackedBreaks(const std::vector<BreakType>& breaks):
+        PackedBreaks(breaks.data(), breaks.size())
+    {
+    }
+
+    /// \returns the number of code units.
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    /// \returns true if there are no code units.
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /// \brief Get the break after a code unit.
+    /// \param i The code unit index.
+    /// \returns the BreakType.
+    BreakType operator [] (std::size_t i) const
+    {
+        return static_cast<BreakType>((_words[i / UNITS_PER_WORD] >> (2 * (i % UNITS_PER_WORD))) & 3);
+    }
+
+    /// \brief Find the next break opportunity.
+    /// \param from The first code unit index to consider.
+    /// \returns the index of the next break at or after \p from, or npos.
+    std::size_t nextBreak(std::size_t from) const
+    {
+        if (from >= _size)
+            return npos;
+
+        std::size_t word = from / UNITS_PER_WORD;
+
+        // Ignore the units before from in the first word.
+        uint64_t mask = breakMask(_words[word]) & (~uint64_t(0) << (2 * (from % UNITS_PER_WORD)));
+
+        while (mask == 0)
+        {
+            if (++word == _words.size())
+                return npos;
+
+            mask = breakMask(_words[word]);
+        }
+
+        std::size_t i = word * UNITS_PER_WORD + countTrailingZeros(mask) / 2;
+        return i < _size ? i : npos;
+    }
+
+    /// \returns the number of break opportunities.
+    std::size_t countBreaks() const
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = nextBreak(0); i != npos; i = nextBreak(i + 1))
+            ++count;
+
+        return count;
+    }
+
+    /// \returns the packed words.
+    const std::vector<uint64_t>& words() const
+    {
+        return _words;
+    }
+
+    /// \brief A forward iterator over the break opportunity offsets.
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::size_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::size_t* pointer;
+        typedef std::size_t reference;
+
+        const_iterator(const PackedBreaks* breaks = nullptr, std::size_t offset = npos):
+            _breaks(breaks), _offset(offset)
+        {
+        }
+
+        std::size_t operator * () const { return _offset; }
+        const_iterator& operator ++ () { _offset = _breaks->nextBreak(_offset + 1); return *this; }
+        const_iterator operator ++ (int) { const_iterator i = *this; ++(*this); return i; }
+        bool operator == (const const_iterator& other) const { return _offset == other._offset; }
+        bool operator != (const const_iterator& other) const { return _offset != other._offset; }
+
+    private:
+        const PackedBreaks* _breaks;
+        std::size_t _offset;
+
+    };
+
+    /// \returns an iterator to the first break opportunity.
+    const_iterator begin() const
+    {
+        return const_iterator(this, nextBreak(0));
+    }
+
+    /// \returns an iterator past the last break opportunity.
+    const_iterator end() const
+    {
+        return const_iterator(this, npos);
+    }
+
+private:
+    /// \brief The number of code units stored per word.
+    static constexpr std::size_t UNITS_PER_WORD = 32;
+
+    /// \brief Get a mask with the low bit of each break unit set.
+    static uint64_t breakMask(uint64_t word)
+    {
+        const uint64_t LOW_BITS = 0x5555555555555555ULL;
+        uint64_t low = word & LOW_BITS;
+        uint64_t high = (word >> 1) & LOW_BITS;
+        uint64_t mask = 0;
+
+        // Select the units whose 2-bit value is a break type. The constant
+        // conditions are folded by the compiler.
+        if (Breaker::isBreak(static_cast<BreakType>(0))) mask |= ~high & ~low & LOW_BITS;
+        if (Breaker::isBreak(static_cast<BreakType>(1))) mask |= ~high & low;
+        if (Breaker::isBreak(static_cast<BreakType>(2))) mask |= high & ~low;
+        if (Breaker::isBreak(static_cast<BreakType>(3))) mask |= high & low;
+
+        return mask;
+    }
+
+    /// \brief Count the trailing zero bits in a non-zero 64-bit value.
+    /// \param value The value, which must not be zero.
+    /// \returns the index of the lowest set bit.
+    static unsigned countTrailingZeros(uint64_t value)
+    {
+#if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+    }
+
+    /// \brief The packed breaks.
+    std::vector<uint64_t> _words;
+
+    /// \brief The number of code units.
+    std::size_t _size = 0;
+
+};
+
+
+/// \brief Find line, word and grapheme boundaries with a single decode.
+///
+/// Calling Linebreaker, Wordbreaker and a code point counter separately
+/// decodes the text once for each. A Segmenter decodes the UTF-8 once,
+/// computing line and grapheme breaks as each code point is decoded, and
+/// writes every result into a single structure of arrays. libunibreak has
+/// no per-character word breaking interface, so word breaks are found in a
+/// second pass over the decoded code points, which are held for the
+/// duration of the call.
+///
+/// Invalid UTF-8 sequences are treated as U+FFFD REPLACEMENT CHARACTER.
+class Segmenter
+{
+public:
+    /// \brief The segmentation results, one array per property.
+    struct Result
+    {
+        /// \brief The line breaks, one per byte.
+        std::vector<Linebreaker::BreakType> lineBreaks;
+
+        /// \brief The word breaks, one per byte.
+        std::vector<Wordbreaker::BreakType> wordBreaks;
+
+        /// \brief The grapheme cluster breaks, one per byte.
+        ///
+        /// A value of 1 means a grapheme cluster ends after this byte.
+        std::vector<uint8_t> graphemeBreaks;
+
+        /// \brief The number of code points in the text.
+        std::size_t numCodepoints = 0;
+
+        /// \brief The byte offset of every checkpointInterval-th code point.
+        std::vector<std::size_t> checkpoints;
+
+        /// \brief The number of code points between checkpoints.
+        std::size_t checkpointInterval = 0;
+
+        /// \brief Find the byte offset of a code point.
+        ///
+        /// The search starts from the nearest checkpoint, so at most
+        /// checkpointInterval code points are stepped over.
+        ///
+        /// \param utf8 The text that was segmented.
+        /// \param index The index of the code point.
+        /// \returns the byte offset or the text size if index is out of range.
+        std::size_t offsetOf(std::string_view utf8, std::size_t index) const;
+    };
+
+    /// \brief The default number of code points between checkpoints.
+    static constexpr std::size_t DEFAULT_CHECKPOINT_INTERVAL = 64;
+
+    /// \brief Create a Segmenter.
+    /// \param language The language used for line and word breaking.
+    /// \param checkpointInterval The number of code points between checkpoints.
+    Segmenter(const std::string& language = "en",
+              std::size_t checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL);
+
+    /// \brief Destroy the Segmenter.
+    ~Segmenter();
+
+    /// \returns the language used for line and word breaking.
+    const std::string& language() const;
+
+    /// \returns the number of code points between checkpoints.
+    std::size_t checkpointInterval() const;
+
+    /// \brief Segment a UTF-8 encoded text.
+    /// \param utf8 The text to segment.
+    /// \returns the segmentation Result.
+    Result segment(std::string_view utf8) const;
+
+    /// \brief Segment a UTF-8 encoded text, reusing an existing Result.
+    /// \param utf8 The text to segment.
+    /// \param result The Result to fill.
+    void segment(std::string_view utf8, Result& result) const;
+
+    /// \brief Segment a UTF-8 encoded text.
+    /// \param utf8 The text to segment.
+    /// \param language The language used for line and word breaking.
+    /// \returns the segmentation Result.
+    static Result segment(std::string_view utf8, const std::string& language);
+
+    /// \brief Segment a UTF-8 encoded text, reusing an existing Result.
+    /// \param utf8 The text to segment.
+    /// \param language The language used for line and word breaking.
+    /// \param result The Result to fill.
+    /// \param checkpointInterval The number of code points between checkpoints.
+    static void segment(std::string_view utf8,
+                        const std::string& language,
+                        Result& result,
+                        std::size_t checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL);
+
+protected:
+    /// \brief The language used for line and word breaking.
+    std::string _language;
+
+    /// \brief The language resolved to its libunibreak tailoring, or nullptr.
+    const LineBreakPropertiesLang* _resolvedLanguage = nullptr;
+
+    /// \brief The number of code points between checkpoints.
+    std::size_t _checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL;
+
+};
+
+
 class UTF8
 {
 public:
@@ -1156,6 +2095,11 @@ public:
     /// \returns true if the given value is a valid Unicode code point.
     static bool isValid(char32_t utf32);
 
+    /// \brief Determine if a code point is assigned a character.
+    /// \param utf32 The code point to test.
+    /// \returns true if the General Category is not Cn (unassigned).
+    static bool isAssigned(char32_t utf32);
+
     static bool isPrintable(char32_t utf32); // is this a "printable" character?
                                                              // True if the Unicode category is not CONTROL
                                                              // This does not guarantee that the character
@@ -1203,14 +2147,33 @@ public:
 };
 
 
+/// \brief A built-in character set codec, defined in Unicode.cpp.
+struct NativeCodec;
+
+
 /// \brief A class for converting between character sets.
 ///
-/// This class is not thread-safe.
+/// Conversions between UTF-8, ASCII, ISO-8859-1, ISO-8859-2, ISO-8859-15,
+/// windows-1250, windows-1251 and windows-1252 use built-in table-driven
+/// codecs unless transliteration is requested. All other conversions use
+/// iconv.
+///
+/// This class is not thread-safe. Use a TextConverterPool to convert on
+/// several threads.
 class TextConverter
 {
 public:
     struct Settings;
 
+    /// \brief The index of an encoding in the registry.
+    ///
+    /// Ids are assigned when the registry is built and are only valid for
+    /// the running process.
+    typedef int EncodingId;
+
+    /// \brief The EncodingId of an encoding that is not registered.
+    static constexpr EncodingId UNKNOWN_ENCODING = -1;
+
     /// \brief Create an unloaded TextConverter.
     TextConverter();
 
@@ -1243,22 +2206,117 @@ public:
     /// \brief True if the TextConverter is loaded with valid Settings.
     bool isLoaded() const;
 
+    /// \returns true if the built-in codecs are used rather than iconv.
+    bool isNative() const;
+
+    /// \brief Get the largest output that converting some input can produce.
+    ///
+    /// The size is found from the widths of the input and output encodings,
+    /// so convert() can allocate its output once. Preallocate an output of
+    /// this size to avoid any allocation in convert().
+    ///
+    /// \param inputBytes The size of the input in bytes.
+    /// \returns the maximum output size in bytes, or an estimate if
+    ///          isOutputBounded() is false.
+    std::size_t maxOutputSize(std::size_t inputBytes) const;
+
+    /// \returns true if maxOutputSize() is a bound rather than an estimate.
+    ///
+    /// The size is an estimate for encodings with unknown widths and when
+    /// transliterating, and convert() grows the output if needed.
+    bool isOutputBounded() const;
+
     /// \brief Reset the converter state.
     void reset();
 
+    /// \brief An input sequence that could not be converted.
+    struct ConversionError
+    {
+        /// \brief The byte offset of the sequence in the input.
+        std::size_t offset = 0;
+
+        /// \brief The length of the sequence in bytes.
+        std::size_t length = 0;
+    };
+
     /// \brief Convert encoded input text to the encoded output text.
+    ///
+    /// Each invalid or unmappable sequence is replaced by defaultCharacter,
+    /// encoded in the output encoding. Each unmappable character is replaced
+    /// once, and a run of invalid bytes is skipped in one step and replaced
+    /// once.
+    ///
     /// \param input The input string corresponding to inputEncoding.
     /// \param output A string in which to write the output encoded with outputEncoding.
+    /// \param errors If not nullptr, the sequences that could not be
+    ///        converted are appended in input order.
     /// \returns -1 if error.
     ///           0 if no error.
     ///          >0 For number of invalid byte sequences in source.
-    int convert(const std::string& input, std::string& output) const;
+    int convert(const std::string& input,
+                std::string& output,
+                std::vector<ConversionError>* errors = nullptr) const;
 
     /// \brief Convert encoded input text to the encoded output text.
     /// \param input The input string corresponding to inputEncoding.
     /// \returns the encoded input or an empty string on error.
     std::string convert(const std::string& input) const;
 
+    /// \brief A function that receives converted output.
+    typedef std::function<void(const char* data, std::size_t size)> Sink;
+
+    /// \brief The size of the output buffer used for streaming conversion.
+    static constexpr std::size_t STREAM_BUFFER_SIZE = 65536;
+
+    /// \brief Convert the next chunk of a stream of encoded input.
+    ///
+    /// A character cut off at the end of the chunk is kept and completed by
+    /// the next chunk, and a run of invalid bytes that continues into the
+    /// next chunk is still replaced once, so the output and the count do not
+    /// depend on where the stream is cut. Output is passed to the sink
+    /// through a fixed-size buffer, so memory use does not grow with the
+    /// length of the stream. Call flush() at the end of the stream.
+    ///
+    /// \param data The next chunk of input corresponding to inputEncoding.
+    /// \param size The size of the chunk in bytes.
+    /// \param sink The function that receives the output.
+    /// \returns -1 if error.
+    ///           0 if no error.
+    ///          >0 For number of invalid byte sequences in the chunk.
+    int feed(const char* data, std::size_t size, const Sink& sink);
+
+    /// \brief Convert the next chunk of a stream of encoded input.
+    /// \param chunk The next chunk of input corresponding to inputEncoding.
+    /// \param sink The function that receives the output.
+    /// \returns -1 if error.
+    ///           0 if no error.
+    ///          >0 For number of invalid byte sequences in the chunk.
+    int feed(const std::string& chunk, const Sink& sink);
+
+    /// \brief Finish a stream of input passed to feed().
+    ///
+    /// A character left incomplete at the end of the stream is an invalid
+    /// byte sequence. Stateful output encodings are returned to their
+    /// initial state and the converter is reset for a new stream.
+    ///
+    /// \param sink The function that receives the output.
+    /// \returns -1 if error.
+    ///           0 if no error.
+    ///          >0 For number of invalid byte sequences.
+    int flush(const Sink& sink);
+
+    /// \brief Convert an encoded input stream to an encoded output stream.
+    ///
+    /// The input is read and converted in chunks, so streams of any length
+    /// are converted in constant memory.
+    ///
+    /// \param input The input stream corresponding to inputEncoding.
+    /// \param output The stream in which to write the output.
+    /// \returns -1 if error.
+    ///           0 if no error.
+    ///          >0 For number of invalid byte sequences in source.
+    int convert(std::istream& input, std::ostream& output);
+
     /// \brief Settings to configure the TextConverter.
     struct Settings
     {
@@ -1268,6 +2326,18 @@ public:
         /// \brief The output encoding.
         std::string outputEncoding;
 
+        /// \brief The input encoding id found by findEncoding().
+        ///
+        /// If not UNKNOWN_ENCODING, the registered encoding is used instead
+        /// of inputEncoding, so that setup() does not parse a name.
+        EncodingId inputEncodingId = UNKNOWN_ENCODING;
+
+        /// \brief The output encoding id found by findEncoding().
+        ///
+        /// If not UNKNOWN_ENCODING, the registered encoding is used instead
+        /// of outputEncoding.
+        EncodingId outputEncodingId = UNKNOWN_ENCODING;
+
         /// \brief True if errors should be skipped.
         ///
         /// If errors are skipped, \p defaultCharacter is used.
@@ -1281,13 +2351,105 @@ public:
         /// If true, characters unrepresented in output encoding it can be
         /// approximated by characters that look similar.
         bool transliterate = false;
+
+        /// \brief Measure the output before converting with built-in codecs.
+        ///
+        /// If true, a first pass over the input finds the exact output size,
+        /// so the output is never larger than needed. Otherwise the output
+        /// is allocated with maxOutputSize() and shrunk after conversion.
+        bool exactOutputSize = false;
     };
 
+    /// \brief Settings for parallel conversion.
+    struct ParallelSettings
+    {
+        ParallelSettings(): numThreads(0), minChunkSize(1 << 20)
+        {
+        }
 
-    /// \returns a list of available encodings.
-    static std::vector<std::string> encodings();
+        /// \brief The number of worker threads.
+        ///
+        /// If 0, std::thread::hardware_concurrency() is used.
+        std::size_t numThreads;
+
+        /// \brief The minimum number of input bytes in each work item.
+        std::size_t minChunkSize;
+    };
+
+    /// \brief Convert a large input using multiple threads.
+    ///
+    /// Inputs in stateless encodings are split at character boundaries that
+    /// are found without decoding: any byte for single-byte encodings, a
+    /// UTF-8 lead byte, an aligned UTF-16 or UTF-32 unit that does not split
+    /// a surrogate pair, an aligned UCS-2 or UCS-4 unit, or just after a
+    /// line feed for ASCII compatible
+    /// multi-byte encodings such as Shift_JIS and GB18030. The work items are
+    /// converted in place by worker threads that each borrow their own
+    /// converter, and the results are joined into the output.
+    ///
+    /// The worker threads are started for each call and joined before it
+    /// returns, as in Linebreaker::findBreaksParallel(). There is no shared
+    /// thread pool, so the cost of starting threads is only repaid by inputs
+    /// of several work items.
+    ///
+    /// Conversions to or from stateful or unknown encodings, and inputs
+    /// smaller than two work items, are converted with convert(). For valid
+    /// input the output is identical to convert().
+    ///
+    /// \param input The input string corresponding to inputEncoding.
+    /// \param output A string in which to write the output encoded with outputEncoding.
+    /// \param settings The ParallelSettings to use.
+    /// \returns -1 if error.
+    ///           0 if no error.
+    ///          >0 For number of invalid byte sequences in source.
+    int convertParallel(const std::string& input,
+                        std::string& output,
+                        const ParallelSettings& settings = ParallelSettings()) const;
+
+
+    /// \brief A registered encoding and the other names it is known by.
+    struct EncodingInfo
+    {
+        /// \brief The id of the encoding.
+        EncodingId id = UNKNOWN_ENCODING;
+
+        /// \brief The canonical name, usable as a Settings encoding.
+        std::string name;
+
+        /// \brief The other names of the encoding.
+        std::vector<std::string> aliases;
+    };
+
+    /// \brief Get the canonical names of the available encodings.
+    ///
+    /// The registry is built the first time it is used and then cached. It
+    /// is read from iconvlist() where iconv is GNU libiconv, and from the
+    /// gconv module configuration and the built-in encodings where it is
+    /// glibc.
+    ///
+    /// \returns the canonical names, indexed by EncodingId.
+    static const std::vector<std::string>& encodings();
+
+    /// \brief Find a registered encoding by its name or an alias.
+    ///
+    /// Names are compared ignoring case and the characters "-", "_", " ",
+    /// "." and ":", so "utf8" and "Latin_1" are found.
+    ///
+    /// \param name The encoding name.
+    /// \returns the EncodingId, or UNKNOWN_ENCODING if it is not registered.
+    static EncodingId findEncoding(const std::string& name);
+
+    /// \brief Get a registered encoding.
+    /// \param id The EncodingId.
+    /// \returns the encoding, or nullptr if the id is not registered.
+    static const EncodingInfo* encodingInfo(EncodingId id);
 
     /// \brief Convert between character sets.
+    ///
+    /// Converters are borrowed from a bounded, thread-safe cache of open
+    /// iconv descriptors, so repeated calls with the same encodings do not
+    /// reopen them.
+    ///
     /// \param input The input string corresponding to inputEncoding.
     /// \param output A string in which to write the output encoded with outputEncoding.
     /// \param inputEncoding The input encoding character set, e.g. ENCODING_ISO_8859_15.
@@ -1300,6 +2462,47 @@ public:
                        const std::string& inputEncoding,
                        const std::string& outputEncoding);
 
+    /// \brief Build a key that identifies the conversion of Settings.
+    ///
+    /// Encoding names are normalized, so Settings that differ only in the
+    /// spelling of their encodings, such as "UTF-8" and "utf8", share a key.
+    ///
+    /// \param settings The conversion Settings.
+    /// \returns the key.
+    static std::string settingsKey(const Settings& settings);
+
+    /// \brief An encoding found by detect().
+    struct DetectedEncoding
+    {
+        /// \brief The encoding name, usable as a Settings encoding.
+        std::string encoding;
+
+        /// \brief The confidence, from 0 to 1.
+        float confidence = 0;
+    };
+
+    /// \brief The default number of bytes examined by detect().
+    static constexpr std::size_t DEFAULT_DETECT_SIZE = 65536;
+
+    /// \brief Detect the encoding of a buffer.
+    ///
+    /// A UTF-8, UTF-16 or UTF-32 byte order mark identifies the encoding.
+    /// Otherwise UTF-16 and UTF-32 are recognized by the position of their
+    /// zero bytes and UTF-8 by a strict validity check. The single-byte
+    /// encodings with built-in codecs and the Shift_JIS, EUC-JP, GB18030,
+    /// Big5 and EUC-KR legacy encodings are scored by how often the
+    /// characters they decode are found in text, with penalties for invalid
+    /// bytes, control characters and unlikely letter case and script
+    /// sequences.
+    ///
+    /// \param buffer The encoded text.
+    /// \param maxBytes The number of bytes at the start of the buffer to
+    ///        examine.
+    /// \returns the candidate encodings ranked by confidence, or an empty
+    ///          list if no encoding is likely.
+    static std::vector<DetectedEncoding> detect(std::string_view buffer,
+                                                std::size_t maxBytes = DEFAULT_DETECT_SIZE);
+
     /// \brief 7-bit ASCII text encoding.
     /// \sa http://en.wikipedia.org/wiki/ASCII
     static const std::string ENCODING_ASCII;
@@ -1353,11 +2556,135 @@ public:
     static const std::string ENCODING_WINDOWS_1252;
 
 private:
+    /// \brief Convert a buffer without copying it into a std::string.
+    /// \param data The input.
+    /// \param size The size of the input in bytes.
+    /// \param output A string in which to write the output.
+    /// \param errors If not nullptr, the sequences that could not be
+    ///        converted are appended in input order.
+    /// \returns -1 on error or the number of invalid byte sequences.
+    int convert(const char* data,
+                std::size_t size,
+                std::string& output,
+                std::vector<ConversionError>* errors = nullptr) const;
+
+    /// \brief Convert using the built-in codecs.
+    /// \param data The input.
+    /// \param size The size of the input in bytes.
+    /// \param out The output position, with room for maxOutputSize(size)
+    ///        bytes, advanced past the converted output.
+    /// \param errors If not nullptr, the sequences that could not be
+    ///        converted are appended.
+    /// \param isInInvalidRun If not nullptr and true, the leading bytes
+    ///        that continue an invalid run from an earlier call are skipped
+    ///        without another replacement. Set to true if the input ends
+    ///        inside an invalid run.
+    /// \returns -1 on error or the number of invalid byte sequences.
+    int convertNative(const char* data,
+                      std::size_t size,
+                      char*& out,
+                      std::vector<ConversionError>* errors = nullptr,
+                      bool* isInInvalidRun = nullptr) const;
+
+    /// \brief Find the length of an input sequence that iconv rejected.
+    ///
+    /// A valid character that the output encoding cannot represent is
+    /// skipped whole. Otherwise one invalid code unit is skipped, or a run
+    /// of invalid UTF-8 bytes.
+    ///
+    /// \param data The first byte of the sequence.
+    /// \param size The bytes remaining in the input.
+    /// \param isInvalid Set to true if the sequence is invalid rather than
+    ///        unmappable.
+    /// \returns the number of bytes to skip.
+    std::size_t skippedLength(const char* data, std::size_t size, bool& isInvalid) const;
+
+    /// \brief Convert the shortest prefix of rejected input that iconv
+    ///        accepts.
+    ///
+    /// For stateful inputs iconv can report an unmappable character at the
+    /// shift sequence before it, depending on where the input is cut.
+    /// Converting a few bytes at a time consumes the shift sequence.
+    ///
+    /// \param pInput The input position, advanced past converted input.
+    /// \param sInput The input bytes remaining.
+    /// \param pOutput The output position, advanced past converted output.
+    /// \param sOutput The output bytes remaining.
+    /// \returns true if any input was converted.
+    bool convertPrefix(char*& pInput,
+                       std::size_t& sInput,
+                       char*& pOutput,
+                       std::size_t& sOutput) const;
+
+    /// \brief Convert a chunk of a stream through the stream buffer.
+    /// \param data The input.
+    /// \param size The size of the input in bytes.
+    /// \param consumed Set to the bytes converted. The rest is an
+    ///        incomplete character.
+    /// \param sink The function that receives the output.
+    /// \param isFinal True if an incomplete character is an error.
+    /// \returns -1 on error or the number of invalid byte sequences.
+    int convertChunk(const char* data,
+                     std::size_t size,
+                     std::size_t& consumed,
+                     const Sink& sink,
+                     bool isFinal = false);
+
     /// \brief The Settings for this converter.
     Settings _settings;
 
     /// \brief The conversion descriptor.
     std::shared_ptr<void> _cd = nullptr;
+
+    /// \brief A descriptor from the input encoding to UTF-32, used to tell
+    ///        unmappable characters from invalid input.
+    std::shared_ptr<void> _decodeCd = nullptr;
+
+    /// \brief The built-in input codec, or nullptr if iconv is used.
+    const NativeCodec* _inputCodec = nullptr;
+
+    /// \brief The built-in output codec, or nullptr if iconv is used.
+    const NativeCodec* _outputCodec = nullptr;
+
+    /// \brief The numerator of the most output bytes per input byte.
+    std::size_t _expansionNumerator = 4;
+
+    /// \brief The denominator of the most output bytes per input byte.
+    std::size_t _expansionDenominator = 1;
+
+    /// \brief The output bytes written once, such as a byte order mark.
+    std::size_t _outputPrefixSize = 0;
+
+    /// \brief True if the expansion is a bound rather than an estimate.
+    bool _isOutputBounded = false;
+
+    /// \brief The defaultCharacter encoded in the output encoding.
+    std::string _replacement;
+
+    /// \brief The size of the input code units in bytes.
+    std::size_t _inputUnitSize = 1;
+
+    /// \brief True if the input is UTF-8.
+    bool _isInputUTF8 = false;
+
+    /// \brief True if adjacent invalid units are reported as one sequence.
+    bool _joinErrors = false;
+
+    /// \brief True if the input encoding has shift states.
+    bool _isInputStateful = false;
+
+    /// \brief True if the output encoding has shift states.
+    bool _isOutputStateful = false;
+
+    /// \brief The incomplete character at the end of the last chunk.
+    std::string _pending;
+
+    /// \brief True if the stream converted so far ends inside a run of
+    ///        invalid bytes that was already replaced.
+    bool _isInInvalidRun = false;
+
+    /// \brief The output buffer for streaming conversion.
+    std::vector<char> _streamBuffer;
 };
 
 
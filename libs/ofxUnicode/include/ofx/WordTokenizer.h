@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ofx/Unicode.h"
+
+
+namespace ofx {
+
+
+/// \brief Split UTF-8 text into words without copying.
+///
+/// A WordTokenizer is a single-pass range of std::string_view tokens that
+/// point into the original text. Tokens are found lazily as the range is
+/// iterated.
+///
+/// The text is broken one window at a time. Each window ends where a word
+/// break is always allowed, just after a line feed or after a space that is
+/// followed by another ASCII character. Only the breaks for the current
+/// window are kept, in a buffer that is reused, so memory use is bounded by
+/// the window size rather than the text size. A window that finds no such
+/// place within four times the window size ends at a character boundary
+/// instead, where a break is reported that breaking the whole text might
+/// not report.
+///
+///     for (std::string_view word: WordTokenizer(text, true))
+///         index.add(word);
+///
+/// The text must outlive the WordTokenizer and its tokens.
+class WordTokenizer
+{
+public:
+    class const_iterator;
+
+    /// \brief The default minimum window size in bytes.
+    static constexpr std::size_t DEFAULT_WINDOW_SIZE = 1 << 16;
+
+    /// \brief Create a WordTokenizer.
+    /// \param utf8 The UTF-8 encoded text to tokenize.
+    /// \param skipNonWords If true, tokens made only of whitespace,
+    ///        punctuation or control characters are skipped.
+    /// \param language The language used for word breaking.
+    /// \param windowSize The minimum number of bytes broken at once.
+    WordTokenizer(std::string_view utf8,
+                  bool skipNonWords = false,
+                  const std::string& language = "en",
+                  std::size_t windowSize = DEFAULT_WINDOW_SIZE);
+
+    /// \brief Destroy the WordTokenizer.
+    ~WordTokenizer();
+
+    /// \brief Get the next token.
+    /// \param token Set to the next token.
+    /// \returns false if there are no more tokens.
+    bool next(std::string_view& token);
+
+    /// \brief Restart tokenizing from the beginning of the text.
+    void reset();
+
+    /// \returns the byte offset of the next unread character.
+    std::size_t offset() const;
+
+    /// \returns an iterator to the next token.
+    const_iterator begin();
+
+    /// \returns the end iterator.
+    const_iterator end();
+
+    /// \brief Determine if a token contains no word characters.
+    ///
+    /// A token is a non-word if every code point is whitespace, punctuation
+    /// or a control character.
+    ///
+    /// \param token The UTF-8 encoded token to test.
+    /// \returns true if the token contains no word characters.
+    static bool isNonWord(std::string_view token);
+
+    /// \brief A single-pass iterator over the tokens.
+    class const_iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::string_view value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string_view* pointer;
+        typedef const std::string_view& reference;
+
+        const_iterator()
+        {
+        }
+
+        reference operator * () const
+        {
+            return _token;
+        }
+
+        pointer operator -> () const
+        {
+            return &_token;
+        }
+
+        const_iterator& operator ++ ()
+        {
+            if (!_tokenizer->next(_token))
+                _tokenizer = nullptr;
+
+            return *this;
+        }
+
+        bool operator == (const const_iterator& other) const
+        {
+            return _tokenizer == other._tokenizer;
+        }
+
+        bool operator != (const const_iterator& other) const
+        {
+            return _tokenizer != other._tokenizer;
+        }
+
+    private:
+        friend class WordTokenizer;
+
+        const_iterator(WordTokenizer* tokenizer): _tokenizer(tokenizer)
+        {
+            ++(*this);
+        }
+
+        /// \brief The tokenizer, or nullptr at the end.
+        WordTokenizer* _tokenizer = nullptr;
+
+        /// \brief The current token.
+        std::string_view _token;
+
+    };
+
+private:
+    /// \brief Break the next window of text.
+    /// \returns false if the end of the text has been reached.
+    bool nextWindow();
+
+    /// \brief The UTF-8 encoded text.
+    std::string_view _text;
+
+    /// \brief True if non-word tokens are skipped.
+    bool _skipNonWords = false;
+
+    /// \brief The language used for word breaking.
+    std::string _language;
+
+    /// \brief The minimum number of bytes broken at once.
+    std::size_t _windowSize = DEFAULT_WINDOW_SIZE;
+
+    /// \brief The byte offset of the start of the current window.
+    std::size_t _windowBegin = 0;
+
+    /// \brief The byte offset of the end of the current window.
+    std::size_t _windowEnd = 0;
+
+    /// \brief The byte offset of the next unread character.
+    std::size_t _offset = 0;
+
+    /// \brief The word breaks for the current window.
+    std::vector<Wordbreaker::BreakType> _breaks;
+
+};
+
+
+} // namespace ofx
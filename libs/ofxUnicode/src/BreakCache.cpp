@@ -0,0 +1,314 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofx/BreakCache.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
+
+
+namespace ofx {
+
+
+namespace {
+
+
+/// \brief A cached (text, language) pair and its break results.
+struct Entry
+{
+    /// \brief The hash of the text and language.
+    uint64_t hash = 0;
+
+    /// \brief A copy of the text, used to verify hash matches.
+    std::string text;
+
+    /// \brief The language.
+    std::string language;
+
+    /// \brief The line breaks, or nullptr if not yet requested.
+    std::shared_ptr<const std::vector<Linebreaker::Break>> lineBreaks;
+
+    /// \brief The word breaks, or nullptr if not yet requested.
+    std::shared_ptr<const std::vector<Wordbreaker::Break>> wordBreaks;
+
+    /// \brief True if the entry was used since the clock hand last passed.
+    std::atomic<bool> referenced;
+
+    Entry(): referenced(false)
+    {
+    }
+};
+
+
+} // namespace
+
+
+struct BreakCache::Shard
+{
+    /// \brief Guards the entries and index. Lookups take a shared lock.
+    mutable std::shared_mutex mutex;
+
+    /// \brief The entries, at most capacity of them.
+    std::vector<std::unique_ptr<Entry>> entries;
+
+    /// \brief The entry index for each hash.
+    std::unordered_map<uint64_t, std::size_t> index;
+
+    /// \brief The CLOCK hand, the next entry considered for eviction.
+    std::size_t hand = 0;
+
+    /// \brief The maximum number of entries.
+    std::size_t capacity = 1;
+};
+
+
+namespace {
+
+
+/// \brief Finalize a 64-bit hash so that every input bit affects every
+///        output bit.
+uint64_t finalizeHash(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+
+/// \brief Mix a 64-bit word into a running hash.
+uint64_t mixHash(uint64_t h, uint64_t word)
+{
+    word *= 0x9E3779B97F4A7C15ULL;
+    word ^= word >> 32;
+    h ^= word;
+    h = (h << 27) | (h >> 37);
+    return h * 0x94D049BB133111EBULL + 0x52DCE729;
+}
+
+
+/// \brief Hash a byte string, eight bytes at a time.
+uint64_t hashBytes(uint64_t h, std::string_view bytes)
+{
+    std::size_t i = 0;
+
+    for (; i + 8 <= bytes.size(); i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes.data() + i, sizeof(word));
+        h = mixHash(h, word);
+    }
+
+    uint64_t tail = 0;
+
+    // An empty view may have a null data pointer, which memcpy must not be
+    // given even for a zero size.
+    if (i < bytes.size())
+        std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+
+    // The length distinguishes strings that differ only by trailing zeros.
+    return mixHash(mixHash(h, tail), bytes.size());
+}
+
+
+} // namespace
+
+
+BreakCache::BreakCache(std::size_t capacity, std::size_t numShards):
+    _capacity(std::max(std::size_t(1), capacity)),
+    _hits(0),
+    _misses(0)
+{
+    numShards = std::max(std::size_t(1), std::min(numShards, _capacity));
+
+    for (std::size_t i = 0; i < numShards; ++i)
+    {
+        _shards.push_back(std::make_unique<Shard>());
+        _shards.back()->capacity = _capacity / numShards + (i < _capacity % numShards);
+    }
+}
+
+
+BreakCache::~BreakCache()
+{
+}
+
+
+std::shared_ptr<const std::vector<Linebreaker::Break>> BreakCache::lineBreaks(std::string_view text,
+                                                                              const std::string& language)
+{
+    return find<Linebreaker>(text, language);
+}
+
+
+std::shared_ptr<const std::vector<Wordbreaker::Break>> BreakCache::wordBreaks(std::string_view text,
+                                                                              const std::string& language)
+{
+    return find<Wordbreaker>(text, language);
+}
+
+
+void BreakCache::clear()
+{
+    for (auto& shard: _shards)
+    {
+        std::unique_lock<std::shared_mutex> lock(shard->mutex);
+        shard->entries.clear();
+        shard->index.clear();
+        shard->hand = 0;
+    }
+
+    _hits = 0;
+    _misses = 0;
+}
+
+
+std::size_t BreakCache::size() const
+{
+    std::size_t size = 0;
+
+    for (const auto& shard: _shards)
+    {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        size += shard->entries.size();
+    }
+
+    return size;
+}
+
+
+std::size_t BreakCache::capacity() const
+{
+    return _capacity;
+}
+
+
+uint64_t BreakCache::hits() const
+{
+    return _hits.load(std::memory_order_relaxed);
+}
+
+
+uint64_t BreakCache::misses() const
+{
+    return _misses.load(std::memory_order_relaxed);
+}
+
+
+uint64_t BreakCache::hash(std::string_view text, std::string_view language)
+{
+    return finalizeHash(hashBytes(hashBytes(0, text), language));
+}
+
+
+namespace {
+
+
+/// \brief Get the result member of an entry for a Breaker type.
+template<typename Breaker>
+std::shared_ptr<const std::vector<typename Breaker::Break>>& entryBreaks(Entry& entry)
+{
+    if constexpr (std::is_same<Breaker, Linebreaker>::value)
+        return entry.lineBreaks;
+    else
+        return entry.wordBreaks;
+}
+
+
+} // namespace
+
+
+template<typename Breaker>
+std::shared_ptr<const std::vector<typename Breaker::Break>> BreakCache::find(std::string_view text,
+                                                                             const std::string& language)
+{
+    uint64_t h = hash(text, language);
+    Shard& shard = *_shards[(h >> 32) % _shards.size()];
+
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto iter = shard.index.find(h);
+
+        if (iter != shard.index.end())
+        {
+            Entry& entry = *shard.entries[iter->second];
+            auto breaks = entryBreaks<Breaker>(entry);
+
+            if (breaks && entry.text == text && entry.language == language)
+            {
+                entry.referenced.store(true, std::memory_order_relaxed);
+                _hits.fetch_add(1, std::memory_order_relaxed);
+                return breaks;
+            }
+        }
+    }
+
+    _misses.fetch_add(1, std::memory_order_relaxed);
+
+    // Break the text before taking the exclusive lock so that readers of
+    // this shard are not blocked during the analysis.
+    auto breaks = std::make_shared<const std::vector<typename Breaker::Break>>(Breaker::findBreakOffsets(text, language));
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto iter = shard.index.find(h);
+
+    if (iter != shard.index.end())
+    {
+        Entry& entry = *shard.entries[iter->second];
+
+        if (entry.text != text || entry.language != language)
+        {
+            // A hash collision, so the newer text replaces the older.
+            entry.text = std::string(text);
+            entry.language = language;
+            entry.lineBreaks = nullptr;
+            entry.wordBreaks = nullptr;
+        }
+
+        entryBreaks<Breaker>(entry) = breaks;
+        entry.referenced.store(true, std::memory_order_relaxed);
+        return breaks;
+    }
+
+    std::size_t slot = shard.entries.size();
+
+    if (slot < shard.capacity)
+    {
+        shard.entries.push_back(std::make_unique<Entry>());
+    }
+    else
+    {
+        // Advance the clock hand, giving each recently used entry a second
+        // chance, until an entry that has not been used is found.
+        while (shard.entries[shard.hand]->referenced.exchange(false, std::memory_order_relaxed))
+            shard.hand = (shard.hand + 1) % shard.entries.size();
+
+        slot = shard.hand;
+        shard.hand = (shard.hand + 1) % shard.entries.size();
+        shard.index.erase(shard.entries[slot]->hash);
+    }
+
+    Entry& entry = *shard.entries[slot];
+    entry.hash = h;
+    entry.text = std::string(text);
+    entry.language = language;
+    entry.lineBreaks = nullptr;
+    entry.wordBreaks = nullptr;
+    entryBreaks<Breaker>(entry) = breaks;
+    entry.referenced.store(false, std::memory_order_relaxed);
+    shard.index[h] = slot;
+
+    return breaks;
+}
+
+
+} // namespace ofx
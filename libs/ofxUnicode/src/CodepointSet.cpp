@@ -0,0 +1,450 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofx/CodepointSet.h"
+#include <algorithm>
+#include "ofUtils.h"
+#include "ofLog.h"
+
+
+namespace ofx {
+
+
+namespace {
+
+
+/// \brief One past the last Unicode code point.
+const char32_t CODEPOINT_END = 0x110000;
+
+/// \brief One past the last code point in the Basic Multilingual Plane.
+const char32_t BMP_END = 0x10000;
+
+/// \brief The smallest number of code points sorted at once by missingFrom().
+const std::size_t MIN_SORT_SIZE = 1024;
+
+
+/// \brief Sort code points and remove duplicates.
+void sortUnique(std::u32string& utf32)
+{
+    std::sort(utf32.begin(), utf32.end());
+    utf32.erase(std::unique(utf32.begin(), utf32.end()), utf32.end());
+}
+
+
+} // namespace
+
+
+CodepointSet::CodepointSet()
+{
+}
+
+
+CodepointSet::CodepointSet(char32_t first, char32_t last)
+{
+    add(first, last);
+}
+
+
+CodepointSet::CodepointSet(const Unicode::Block& block):
+    CodepointSet(block.begin, block.end)
+{
+}
+
+
+CodepointSet::CodepointSet(const std::u32string& utf32)
+{
+    std::u32string sorted = utf32;
+    sortUnique(sorted);
+    _list = fromSorted(sorted);
+}
+
+
+CodepointSet::~CodepointSet()
+{
+}
+
+
+CodepointSet CodepointSet::fromUTF8(const std::string& utf8)
+{
+    return CodepointSet().missingFrom(utf8);
+}
+
+
+void CodepointSet::add(char32_t codepoint)
+{
+    if (codepoint >= CODEPOINT_END)
+        return;
+
+    // Code points added in ascending order extend or follow the last range,
+    // which is updated in place.
+    if (_list.empty() || codepoint > _list.back())
+    {
+        _list.push_back(codepoint);
+        _list.push_back(codepoint + 1);
+        _bmp.reset();
+    }
+    else if (codepoint == _list.back())
+    {
+        _list.back() = codepoint + 1;
+        _bmp.reset();
+    }
+    else if (!contains(codepoint))
+    {
+        add(codepoint, codepoint);
+    }
+}
+
+
+void CodepointSet::add(const std::u32string& utf32)
+{
+    *this = combine(*this, CodepointSet(utf32), Operation::UNION);
+}
+
+
+void CodepointSet::add(char32_t first, char32_t last)
+{
+    last = std::min(last, char32_t(CODEPOINT_END - 1));
+
+    if (first > last)
+        return;
+
+    CodepointSet range;
+    range._list = { first, static_cast<char32_t>(last + 1) };
+    *this = combine(*this, range, Operation::UNION);
+}
+
+
+void CodepointSet::add(const Unicode::Block& block)
+{
+    add(block.begin, block.end);
+}
+
+
+bool CodepointSet::contains(char32_t codepoint) const
+{
+    if (_bmp && codepoint < BMP_END)
+        return ((*_bmp)[codepoint >> 6] >> (codepoint & 63)) & 1;
+
+    // A code point is a member if an odd number of boundaries are <= it.
+    auto iter = std::upper_bound(_list.begin(), _list.end(), codepoint);
+    return (iter - _list.begin()) & 1;
+}
+
+
+bool CodepointSet::containsAll(const std::string& utf8) const
+{
+    try
+    {
+        auto iter = utf8.begin();
+
+        while (iter != utf8.end())
+        {
+            if (!contains(utf8::next(iter, utf8.end())))
+                return false;
+        }
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("CodepointSet::containsAll") << utfcpp_ex.what();
+        return false;
+    }
+
+    return true;
+}
+
+
+CodepointSet CodepointSet::missingFrom(const std::string& utf8) const
+{
+    CodepointSet missing;
+
+    if (!missingFrom(utf8, missing))
+        ofLogError("CodepointSet::missingFrom") << "Skipped invalid UTF-8 sequences.";
+
+    return missing;
+}
+
+
+bool CodepointSet::missingFrom(const std::string& utf8, CodepointSet& missing) const
+{
+    std::u32string codepoints;
+    std::size_t numSorted = 0;
+    bool isValid = true;
+
+    // The most recent miss is remembered so that runs of the same missing
+    // code point, common in real text, are only recorded once.
+    char32_t lastMissing = CODEPOINT_END;
+
+    auto iter = utf8.begin();
+
+    while (iter != utf8.end())
+    {
+        auto invalid = utf8::find_invalid(iter, utf8.end());
+
+        while (iter != invalid)
+        {
+            char32_t codepoint = utf8::unchecked::next(iter);
+
+            if (codepoint != lastMissing && !contains(codepoint))
+            {
+                codepoints.push_back(codepoint);
+                lastMissing = codepoint;
+
+                // Remove duplicates whenever the unsorted code points
+                // outnumber the sorted ones, so memory stays proportional to
+                // the number of distinct missing code points.
+                if (codepoints.size() >= 2 * std::max(numSorted, MIN_SORT_SIZE))
+                {
+                    sortUnique(codepoints);
+                    numSorted = codepoints.size();
+                }
+            }
+        }
+
+        if (iter != utf8.end())
+        {
+            isValid = false;
+            ++iter;
+        }
+    }
+
+    missing = CodepointSet(codepoints);
+    return isValid;
+}
+
+
+bool CodepointSet::empty() const
+{
+    return _list.empty();
+}
+
+
+std::size_t CodepointSet::size() const
+{
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i + 1 < _list.size(); i += 2)
+        count += _list[i + 1] - _list[i];
+
+    return count;
+}
+
+
+std::size_t CodepointSet::numRanges() const
+{
+    return _list.size() / 2;
+}
+
+
+void CodepointSet::clear()
+{
+    _list.clear();
+    _bmp.reset();
+}
+
+
+void CodepointSet::optimize()
+{
+    auto bmp = std::make_shared<std::vector<uint64_t>>(BMP_END / 64, 0);
+
+    for (std::size_t i = 0; i + 1 < _list.size() && _list[i] < BMP_END; i += 2)
+    {
+        char32_t end = std::min(_list[i + 1], BMP_END);
+
+        for (char32_t c = _list[i]; c < end; ++c)
+            (*bmp)[c >> 6] |= uint64_t(1) << (c & 63);
+    }
+
+    _bmp = bmp;
+}
+
+
+bool CodepointSet::isOptimized() const
+{
+    return _bmp != nullptr;
+}
+
+
+std::u32string CodepointSet::toUTF32() const
+{
+    std::u32string utf32;
+    utf32.reserve(size());
+
+    for (std::size_t i = 0; i + 1 < _list.size(); i += 2)
+        for (char32_t c = _list[i]; c < _list[i + 1]; ++c)
+            utf32.push_back(c);
+
+    return utf32;
+}
+
+
+const std::vector<char32_t>& CodepointSet::inversionList() const
+{
+    return _list;
+}
+
+
+CodepointSet CodepointSet::unionWith(const CodepointSet& other) const
+{
+    return combine(*this, other, Operation::UNION);
+}
+
+
+CodepointSet CodepointSet::intersectionWith(const CodepointSet& other) const
+{
+    return combine(*this, other, Operation::INTERSECTION);
+}
+
+
+CodepointSet CodepointSet::difference(const CodepointSet& other) const
+{
+    return combine(*this, other, Operation::DIFFERENCE);
+}
+
+
+CodepointSet CodepointSet::operator | (const CodepointSet& other) const
+{
+    return unionWith(other);
+}
+
+
+CodepointSet CodepointSet::operator & (const CodepointSet& other) const
+{
+    return intersectionWith(other);
+}
+
+
+CodepointSet CodepointSet::operator - (const CodepointSet& other) const
+{
+    return difference(other);
+}
+
+
+CodepointSet& CodepointSet::operator |= (const CodepointSet& other)
+{
+    *this = unionWith(other);
+    return *this;
+}
+
+
+CodepointSet& CodepointSet::operator &= (const CodepointSet& other)
+{
+    *this = intersectionWith(other);
+    return *this;
+}
+
+
+CodepointSet& CodepointSet::operator -= (const CodepointSet& other)
+{
+    *this = difference(other);
+    return *this;
+}
+
+
+bool CodepointSet::operator == (const CodepointSet& other) const
+{
+    return _list == other._list;
+}
+
+
+bool CodepointSet::operator != (const CodepointSet& other) const
+{
+    return _list != other._list;
+}
+
+
+CodepointSet CodepointSet::combine(const CodepointSet& a,
+                                   const CodepointSet& b,
+                                   Operation operation)
+{
+    CodepointSet result;
+    result._list.reserve(a._list.size() + b._list.size());
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    bool inA = false;
+    bool inB = false;
+    bool inResult = false;
+
+    // Walk both lists in order. Each boundary toggles membership in its own
+    // list, and a boundary is emitted whenever the combined membership
+    // changes.
+    while (i < a._list.size() || j < b._list.size())
+    {
+        char32_t codepoint = CODEPOINT_END;
+
+        if (i < a._list.size())
+            codepoint = a._list[i];
+
+        if (j < b._list.size())
+            codepoint = std::min(codepoint, b._list[j]);
+
+        if (i < a._list.size() && a._list[i] == codepoint)
+        {
+            inA = !inA;
+            ++i;
+        }
+
+        if (j < b._list.size() && b._list[j] == codepoint)
+        {
+            inB = !inB;
+            ++j;
+        }
+
+        bool in = false;
+
+        switch (operation)
+        {
+            case Operation::UNION:
+                in = inA || inB;
+                break;
+            case Operation::INTERSECTION:
+                in = inA && inB;
+                break;
+            case Operation::DIFFERENCE:
+                in = inA && !inB;
+                break;
+        }
+
+        if (in != inResult)
+        {
+            result._list.push_back(codepoint);
+            inResult = in;
+        }
+    }
+
+    return result;
+}
+
+
+std::vector<char32_t> CodepointSet::fromSorted(const std::u32string& utf32)
+{
+    std::vector<char32_t> list;
+
+    for (std::size_t i = 0; i < utf32.size(); )
+    {
+        if (utf32[i] >= CODEPOINT_END)
+            break;
+
+        std::size_t j = i + 1;
+
+        while (j < utf32.size()
+           &&  utf32[j] == utf32[j - 1] + 1
+           &&  utf32[j] < CODEPOINT_END)
+        {
+            ++j;
+        }
+
+        list.push_back(utf32[i]);
+        list.push_back(utf32[j - 1] + 1);
+        i = j;
+    }
+
+    return list;
+}
+
+
+} // namespace ofx
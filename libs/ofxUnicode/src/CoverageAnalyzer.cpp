@@ -0,0 +1,478 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofx/CoverageAnalyzer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+#include "ofLog.h"
+
+
+namespace ofx {
+
+
+namespace {
+
+
+/// \brief One past the last code point in the Basic Multilingual Plane.
+const char32_t BMP_SIZE = 0x10000;
+
+
+/// \brief The number of bytes read from a file at once.
+const std::size_t FILE_BLOCK_SIZE = 1 << 16;
+
+
+/// \brief Map a code point to its Block index.
+///
+/// Blocks.txt guarantees that every Block starts and ends on a multiple of 16
+/// code points, so a direct table with one entry per 16 code points maps any
+/// code point to its Block in a single load.
+class BlockPageTable
+{
+public:
+    BlockPageTable(): _pages(0x110000 >> 4, NO_BLOCK)
+    {
+        const auto& blocks = Unicode::blocks();
+
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+            for (char32_t page = blocks[i]->begin >> 4; page <= blocks[i]->end >> 4; ++page)
+                _pages[page] = static_cast<uint16_t>(i);
+    }
+
+    /// \returns the Block index or NO_BLOCK.
+    uint16_t operator [] (char32_t codepoint) const
+    {
+        return _pages[codepoint >> 4];
+    }
+
+    /// \brief The index value for code points without a Block.
+    static constexpr uint16_t NO_BLOCK = 0xFFFF;
+
+private:
+    std::vector<uint16_t> _pages;
+
+};
+
+
+/// \returns the shared BlockPageTable.
+const BlockPageTable& blockPageTable()
+{
+    static const BlockPageTable pageTable;
+    return pageTable;
+}
+
+
+/// \brief A per-thread code point histogram.
+struct Histogram
+{
+    Histogram(): bmp(BMP_SIZE, 0)
+    {
+    }
+
+    /// \brief Counts for code points in the BMP.
+    std::vector<uint64_t> bmp;
+
+    /// \brief Counts for supplementary code points, which are rare.
+    std::unordered_map<char32_t, uint64_t> supplementary;
+
+    /// \brief The number of invalid bytes skipped.
+    uint64_t numInvalidBytes = 0;
+
+    /// \brief Count every code point in a UTF-8 buffer.
+    void scan(std::string_view utf8)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(utf8.data());
+        const unsigned char* end = p + utf8.size();
+
+        while (p < end)
+        {
+            // Fast path for runs of ASCII, eight bytes at a time.
+            while (end - p >= 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, p, sizeof(word));
+
+                if (word & 0x8080808080808080ULL)
+                    break;
+
+                for (int i = 0; i < 8; ++i)
+                    ++bmp[p[i]];
+
+                p += 8;
+            }
+
+            if (p == end)
+                break;
+
+            unsigned char c = *p;
+
+            if (c < 0x80)
+            {
+                ++bmp[c];
+                ++p;
+                continue;
+            }
+
+            char32_t codepoint = 0;
+            std::size_t length = 0;
+            char32_t minimum = 0;
+
+            if (c >= 0xC2 && c <= 0xDF)
+            {
+                codepoint = c & 0x1F;
+                length = 2;
+                minimum = 0x80;
+            }
+            else if (c >= 0xE0 && c <= 0xEF)
+            {
+                codepoint = c & 0x0F;
+                length = 3;
+                minimum = 0x800;
+            }
+            else if (c >= 0xF0 && c <= 0xF4)
+            {
+                codepoint = c & 0x07;
+                length = 4;
+                minimum = 0x10000;
+            }
+
+            bool valid = length > 0 && std::size_t(end - p) >= length;
+
+            for (std::size_t i = 1; valid && i < length; ++i)
+            {
+                if ((p[i] & 0xC0) != 0x80)
+                    valid = false;
+                else
+                    codepoint = (codepoint << 6) | (p[i] & 0x3F);
+            }
+
+            valid = valid
+                 && codepoint >= minimum
+                 && codepoint <= 0x10FFFF
+                 && !(codepoint >= 0xD800 && codepoint <= 0xDFFF);
+
+            if (!valid)
+            {
+                ++numInvalidBytes;
+                ++p;
+                continue;
+            }
+
+            if (codepoint < BMP_SIZE)
+                ++bmp[codepoint];
+            else
+                ++supplementary[codepoint];
+
+            p += length;
+        }
+    }
+
+    /// \brief Add another Histogram's counts to this one.
+    void merge(const Histogram& other)
+    {
+        for (std::size_t i = 0; i < BMP_SIZE; ++i)
+            bmp[i] += other.bmp[i];
+
+        for (const auto& entry: other.supplementary)
+            supplementary[entry.first] += entry.second;
+
+        numInvalidBytes += other.numInvalidBytes;
+    }
+};
+
+
+/// \brief Find the length of a UTF-8 buffer without an incomplete sequence
+///        at its end.
+///
+/// A sequence is incomplete if its lead byte needs more bytes than remain,
+/// which Histogram::scan() would count as invalid.
+///
+/// \param data The buffer.
+/// \param size The size of the buffer.
+/// \returns the length of the buffer before the incomplete sequence.
+std::size_t completeUTF8Length(const char* data, std::size_t size)
+{
+    for (std::size_t i = 1; i <= std::min(size, std::size_t(3)); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(data[size - i]);
+
+        if ((c & 0xC0) == 0x80)
+            continue;
+
+        std::size_t length = 1;
+
+        if (c >= 0xC2 && c <= 0xDF)
+            length = 2;
+        else if (c >= 0xE0 && c <= 0xEF)
+            length = 3;
+        else if (c >= 0xF0 && c <= 0xF4)
+            length = 4;
+
+        return length > i ? size - i : size;
+    }
+
+    return size;
+}
+
+
+/// \brief Count every code point in a UTF-8 file.
+///
+/// The file is read one block at a time. An incomplete sequence at the end
+/// of a block is carried into the next, so the counts are the same as for
+/// the whole file.
+///
+/// \param path The path of the file.
+/// \param histogram The Histogram to count into.
+/// \param buffer A buffer to reuse for reading.
+/// \returns false if the file could not be read.
+bool scanFile(const std::string& path, Histogram& histogram, std::vector<char>& buffer)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file)
+        return false;
+
+    buffer.resize(FILE_BLOCK_SIZE + 3);
+    std::size_t carried = 0;
+
+    while (true)
+    {
+        file.read(buffer.data() + carried, FILE_BLOCK_SIZE);
+        std::size_t size = carried + static_cast<std::size_t>(file.gcount());
+
+        // At the end of the file nothing can complete the last sequence.
+        std::size_t complete = file ? completeUTF8Length(buffer.data(), size) : size;
+        histogram.scan(std::string_view(buffer.data(), complete));
+
+        if (!file)
+            return true;
+
+        carried = size - complete;
+        std::memmove(buffer.data(), buffer.data() + complete, carried);
+    }
+}
+
+
+/// \brief A unit of work, either an in-memory buffer or a file path.
+struct WorkItem
+{
+    std::string_view text;
+    const std::string* path = nullptr;
+};
+
+
+/// \brief Split a UTF-8 buffer into work items of about chunkSize bytes.
+void splitWorkItems(std::string_view utf8,
+                    std::size_t chunkSize,
+                    std::vector<WorkItem>& items)
+{
+    chunkSize = std::max(std::size_t(16), chunkSize);
+    std::size_t begin = 0;
+
+    while (begin < utf8.size())
+    {
+        std::size_t end = std::min(begin + chunkSize, utf8.size());
+
+        // Move the split forward past any UTF-8 continuation bytes so that
+        // no sequence is divided between chunks.
+        for (int i = 0; i < 3 && end < utf8.size() && (utf8[end] & 0xC0) == 0x80; ++i)
+            ++end;
+
+        WorkItem item;
+        item.text = utf8.substr(begin, end - begin);
+        items.push_back(item);
+        begin = end;
+    }
+}
+
+
+/// \brief Scan all work items on a pool of threads.
+CoverageAnalyzer::Result analyzeWorkItems(const std::vector<WorkItem>& items,
+                                          const CoverageAnalyzer::Settings& settings)
+{
+    std::size_t numThreads = settings.numThreads;
+
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    numThreads = std::max(std::size_t(1), std::min(numThreads, items.size()));
+
+    std::vector<Histogram> histograms(numThreads);
+    std::atomic<std::size_t> nextItem(0);
+
+    auto worker = [&](Histogram& histogram) {
+        std::vector<char> buffer;
+        std::size_t i;
+
+        while ((i = nextItem.fetch_add(1)) < items.size())
+        {
+            const auto& item = items[i];
+
+            if (item.path)
+            {
+                if (!scanFile(*item.path, histogram, buffer))
+                    ofLogError("CoverageAnalyzer::analyzeFiles") << "Unable to read " << *item.path;
+            }
+            else
+            {
+                histogram.scan(item.text);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < numThreads; ++i)
+        threads.emplace_back(worker, std::ref(histograms[i]));
+
+    worker(histograms[0]);
+
+    for (auto& thread: threads)
+        thread.join();
+
+    Histogram& total = histograms[0];
+
+    for (std::size_t i = 1; i < histograms.size(); ++i)
+        total.merge(histograms[i]);
+
+    // Derive Block, script and code point results once per distinct code
+    // point.
+    const BlockPageTable& pageTable = blockPageTable();
+
+    CoverageAnalyzer::Result result;
+    result.blockCounts.resize(Unicode::blocks().size(), 0);
+    result.numInvalidBytes = total.numInvalidBytes;
+
+    std::u32string distinct;
+
+    auto count = [&](char32_t codepoint, uint64_t n) {
+        uint16_t block = pageTable[codepoint];
+
+        if (block == BlockPageTable::NO_BLOCK)
+            result.noBlockCount += n;
+        else
+            result.blockCounts[block] += n;
+
+        std::size_t script = static_cast<std::size_t>(ucdn_get_script(codepoint));
+
+        if (script >= result.scriptCounts.size())
+            result.scriptCounts.resize(script + 1, 0);
+
+        result.scriptCounts[script] += n;
+        result.numCodepoints += n;
+        distinct.push_back(codepoint);
+    };
+
+    for (char32_t codepoint = 0; codepoint < BMP_SIZE; ++codepoint)
+        if (total.bmp[codepoint] > 0)
+            count(codepoint, total.bmp[codepoint]);
+
+    for (const auto& entry: total.supplementary)
+        count(entry.first, entry.second);
+
+    result.codepoints = CodepointSet(distinct);
+
+    return result;
+}
+
+
+} // namespace
+
+
+CoverageAnalyzer::CoverageAnalyzer()
+{
+}
+
+
+CoverageAnalyzer::CoverageAnalyzer(const Settings& settings):
+    _settings(settings)
+{
+}
+
+
+CoverageAnalyzer::~CoverageAnalyzer()
+{
+}
+
+
+const CoverageAnalyzer::Settings& CoverageAnalyzer::settings() const
+{
+    return _settings;
+}
+
+
+CoverageAnalyzer::Result CoverageAnalyzer::analyze(std::string_view utf8) const
+{
+    std::vector<WorkItem> items;
+    splitWorkItems(utf8, _settings.chunkSize, items);
+    return analyzeWorkItems(items, _settings);
+}
+
+
+CoverageAnalyzer::Result CoverageAnalyzer::analyze(const std::vector<std::string>& texts) const
+{
+    std::vector<WorkItem> items;
+
+    for (const auto& text: texts)
+        splitWorkItems(text, _settings.chunkSize, items);
+
+    return analyzeWorkItems(items, _settings);
+}
+
+
+CoverageAnalyzer::Result CoverageAnalyzer::analyzeFiles(const std::vector<std::string>& paths) const
+{
+    std::vector<WorkItem> items(paths.size());
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+        items[i].path = &paths[i];
+
+    return analyzeWorkItems(items, _settings);
+}
+
+
+uint64_t CoverageAnalyzer::Result::count(const Unicode::Block& block) const
+{
+    if (block.begin > 0x10FFFF)
+        return 0;
+
+    // Blocks do not overlap, so the first code point identifies the Block.
+    uint16_t i = blockPageTable()[block.begin];
+
+    if (i == BlockPageTable::NO_BLOCK
+    ||  i >= blockCounts.size()
+    ||  Unicode::blocks()[i]->begin != block.begin
+    ||  Unicode::blocks()[i]->end != block.end)
+    {
+        return 0;
+    }
+
+    return blockCounts[i];
+}
+
+
+std::vector<std::pair<const Unicode::Block*, uint64_t>> CoverageAnalyzer::Result::blocks() const
+{
+    std::vector<std::pair<const Unicode::Block*, uint64_t>> results;
+    const auto& blocks = Unicode::blocks();
+
+    for (std::size_t i = 0; i < blocks.size() && i < blockCounts.size(); ++i)
+        if (blockCounts[i] > 0)
+            results.push_back(std::make_pair(blocks[i], blockCounts[i]));
+
+    std::stable_sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second;
+    });
+
+    return results;
+}
+
+
+} // namespace ofx
@@ -0,0 +1,410 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofx/LineFitter.h"
+#include <algorithm>
+#include <limits>
+#include "ofUtils.h"
+#include "ofLog.h"
+
+
+namespace ofx {
+
+
+namespace {
+
+
+/// \brief Determine if a byte is whitespace that hangs at the end of a line.
+///
+/// Only ASCII whitespace is considered, so the test is safe for any byte of
+/// a UTF-8 sequence.
+bool isHangingWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+
+} // namespace
+
+
+LineFitter::LineFitter()
+{
+}
+
+
+LineFitter::LineFitter(std::string_view utf8,
+                       const std::vector<Linebreaker::BreakType>& breaks,
+                       const AdvanceFunction& advance)
+{
+    setText(utf8, breaks, advance);
+}
+
+
+LineFitter::LineFitter(std::string_view utf8,
+                       const std::vector<Linebreaker::BreakType>& breaks,
+                       const std::vector<float>& advances)
+{
+    setText(utf8, breaks, advances);
+}
+
+
+LineFitter::~LineFitter()
+{
+}
+
+
+bool LineFitter::setText(std::string_view utf8,
+                         const std::vector<Linebreaker::BreakType>& breaks,
+                         const AdvanceFunction& advance)
+{
+    clear();
+
+    if (breaks.size() != utf8.size())
+    {
+        ofLogError("LineFitter::setText") << "Expected " << utf8.size() << " breaks, got " << breaks.size() << ".";
+        return false;
+    }
+
+    _prefixWidths.assign(utf8.size() + 1, 0);
+
+    try
+    {
+        auto iter = utf8.begin();
+
+        while (iter != utf8.end())
+        {
+            std::size_t offset = iter - utf8.begin();
+            char32_t codepoint = utf8::next(iter, utf8.end());
+            std::size_t next = iter - utf8.begin();
+
+            // The advance belongs to the first byte of the code point.
+            _prefixWidths[offset + 1] = _prefixWidths[offset] + advance(codepoint, offset);
+
+            for (std::size_t i = offset + 2; i <= next; ++i)
+                _prefixWidths[i] = _prefixWidths[offset + 1];
+        }
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("LineFitter::setText") << utfcpp_ex.what();
+        clear();
+        return false;
+    }
+
+    collectCandidates(utf8, breaks);
+    return true;
+}
+
+
+bool LineFitter::setText(std::string_view utf8,
+                         const std::vector<Linebreaker::BreakType>& breaks,
+                         const std::vector<float>& advances)
+{
+    clear();
+
+    if (breaks.size() != utf8.size() || advances.size() != utf8.size())
+    {
+        ofLogError("LineFitter::setText") << "Expected " << utf8.size() << " breaks and advances, got " << breaks.size() << " and " << advances.size() << ".";
+        return false;
+    }
+
+    _prefixWidths.resize(utf8.size() + 1);
+    _prefixWidths[0] = 0;
+
+    for (std::size_t i = 0; i < advances.size(); ++i)
+        _prefixWidths[i + 1] = _prefixWidths[i] + advances[i];
+
+    collectCandidates(utf8, breaks);
+    return true;
+}
+
+
+void LineFitter::clear()
+{
+    _prefixWidths.clear();
+    _candidates.clear();
+}
+
+
+std::vector<LineFitter::Line> LineFitter::fit(float maxWidth,
+                                              Algorithm algorithm) const
+{
+    std::vector<Line> lines;
+    fit(maxWidth, algorithm, lines);
+    return lines;
+}
+
+
+void LineFitter::fit(float maxWidth,
+                     Algorithm algorithm,
+                     std::vector<Line>& lines) const
+{
+    lines.clear();
+
+    if (_candidates.empty())
+        return;
+
+    if (algorithm == Algorithm::OPTIMAL)
+        fitOptimal(maxWidth, lines);
+    else
+        fitGreedy(maxWidth, lines);
+}
+
+
+float LineFitter::width(std::size_t begin, std::size_t end) const
+{
+    if (_prefixWidths.empty())
+        return 0;
+
+    end = std::min(end, _prefixWidths.size() - 1);
+    begin = std::min(begin, end);
+    return static_cast<float>(_prefixWidths[end] - _prefixWidths[begin]);
+}
+
+
+std::size_t LineFitter::size() const
+{
+    return _prefixWidths.empty() ? 0 : _prefixWidths.size() - 1;
+}
+
+
+void LineFitter::setMaxActiveNodes(std::size_t maxActiveNodes)
+{
+    _maxActiveNodes = std::max(std::size_t(1), maxActiveNodes);
+}
+
+
+std::size_t LineFitter::maxActiveNodes() const
+{
+    return _maxActiveNodes;
+}
+
+
+void LineFitter::collectCandidates(std::string_view utf8,
+                                   const std::vector<Linebreaker::BreakType>& breaks)
+{
+    // The start of the current run of trailing whitespace.
+    std::size_t contentEnd = 0;
+
+    for (std::size_t i = 0; i < utf8.size(); ++i)
+    {
+        if (!isHangingWhitespace(utf8[i]))
+            contentEnd = i + 1;
+
+        // The end of the text always ends the last line.
+        bool last = i + 1 == utf8.size();
+
+        if (Linebreaker::isBreak(breaks[i]) || last)
+        {
+            Candidate candidate;
+            candidate.end = i + 1;
+            candidate.contentEnd = contentEnd;
+            candidate.mandatory = breaks[i] == Linebreaker::BreakType::MUST_BREAK || last;
+            _candidates.push_back(candidate);
+        }
+    }
+}
+
+
+void LineFitter::fitGreedy(float maxWidth, std::vector<Line>& lines) const
+{
+    std::size_t begin = 0;
+
+    // The index of the last candidate that fit on the current line.
+    std::size_t lastFit = std::numeric_limits<std::size_t>::max();
+
+    for (std::size_t i = 0; i < _candidates.size(); ++i)
+    {
+        const Candidate& candidate = _candidates[i];
+
+        if (width(begin, candidate.contentEnd) > maxWidth
+        &&  lastFit != std::numeric_limits<std::size_t>::max())
+        {
+            lines.push_back(makeLine(begin, _candidates[lastFit], maxWidth));
+            begin = _candidates[lastFit].end;
+            lastFit = std::numeric_limits<std::size_t>::max();
+        }
+
+        // A candidate that does not fit on an empty line is taken anyway,
+        // producing an overfull line.
+        if (candidate.mandatory || width(begin, candidate.contentEnd) > maxWidth)
+        {
+            lines.push_back(makeLine(begin, candidate, maxWidth));
+            begin = candidate.end;
+            lastFit = std::numeric_limits<std::size_t>::max();
+        }
+        else
+        {
+            lastFit = i;
+        }
+    }
+}
+
+
+namespace {
+
+
+/// \brief A feasible line ending in the Knuth-Plass search.
+struct Node
+{
+    /// \brief The index of the candidate where the line ends.
+    std::size_t candidate;
+
+    /// \brief The byte offset where the next line begins.
+    std::size_t end;
+
+    /// \brief The sum of the demerits of all lines up to this node.
+    double totalDemerits;
+
+    /// \brief The index of the previous node or NO_NODE.
+    std::size_t previous;
+};
+
+
+/// \brief The previous node index for the first line.
+const std::size_t NO_NODE = std::numeric_limits<std::size_t>::max();
+
+
+/// \brief Calculate the demerits of a line that fits.
+///
+/// Badness grows with the cube of the unused fraction of the line, as in
+/// Knuth and Plass. The last line of a paragraph is allowed to be short.
+double lineDemerits(double lineWidth, double maxWidth, bool lastLine)
+{
+    double badness = 0;
+
+    if (!lastLine && maxWidth > 0)
+    {
+        double ratio = (maxWidth - lineWidth) / maxWidth;
+        badness = 100 * ratio * ratio * ratio;
+    }
+
+    return (1 + badness) * (1 + badness);
+}
+
+
+} // namespace
+
+
+void LineFitter::fitOptimal(float maxWidth, std::vector<Line>& lines) const
+{
+    // Demerits for an overfull line, used only when nothing else fits.
+    const double OVERFULL_DEMERITS = 1e10;
+
+    std::vector<Node> nodes;
+    std::vector<std::size_t> active;
+
+    Node start;
+    start.candidate = NO_NODE;
+    start.end = 0;
+    start.totalDemerits = 0;
+    start.previous = NO_NODE;
+    nodes.push_back(start);
+    active.push_back(0);
+
+    for (std::size_t i = 0; i < _candidates.size(); ++i)
+    {
+        const Candidate& candidate = _candidates[i];
+
+        std::size_t best = NO_NODE;
+        double bestDemerits = std::numeric_limits<double>::max();
+
+        // The latest overfull node, the fallback when no active node can
+        // reach this candidate. Starting the line there keeps the overflow
+        // as small as possible.
+        std::size_t fallback = NO_NODE;
+
+        for (std::size_t j = 0; j < active.size(); )
+        {
+            const Node& node = nodes[active[j]];
+            double lineWidth = width(node.end, candidate.contentEnd);
+
+            if (lineWidth > maxWidth)
+            {
+                // Lines only get wider, so this node can never be used
+                // again.
+                if (fallback == NO_NODE || node.end > nodes[fallback].end)
+                    fallback = active[j];
+
+                active.erase(active.begin() + j);
+                continue;
+            }
+
+            double demerits = node.totalDemerits
+                            + lineDemerits(lineWidth, maxWidth, candidate.mandatory);
+
+            if (demerits < bestDemerits)
+            {
+                best = active[j];
+                bestDemerits = demerits;
+            }
+
+            ++j;
+        }
+
+        if (best == NO_NODE && active.empty())
+        {
+            // Nothing fits, so end an overfull line here.
+            best = fallback;
+            bestDemerits = nodes[fallback].totalDemerits + OVERFULL_DEMERITS;
+        }
+
+        if (best == NO_NODE)
+            continue;
+
+        Node node;
+        node.candidate = i;
+        node.end = candidate.end;
+        node.totalDemerits = bestDemerits;
+        node.previous = best;
+        nodes.push_back(node);
+
+        // Every line must end at a mandatory break, so nothing before it can
+        // start a later line.
+        if (candidate.mandatory)
+            active.clear();
+
+        active.push_back(nodes.size() - 1);
+
+        if (active.size() > _maxActiveNodes)
+        {
+            auto worst = std::max_element(active.begin(), active.end(), [&](std::size_t a, std::size_t b) {
+                return nodes[a].totalDemerits < nodes[b].totalDemerits;
+            });
+
+            active.erase(worst);
+        }
+    }
+
+    // The last candidate is always mandatory, so the last node ends the text.
+    std::size_t first = lines.size();
+
+    for (std::size_t n = nodes.size() - 1; n != 0 && n != NO_NODE; n = nodes[n].previous)
+    {
+        std::size_t previous = nodes[n].previous;
+        lines.push_back(makeLine(nodes[previous].end, _candidates[nodes[n].candidate], maxWidth));
+    }
+
+    std::reverse(lines.begin() + first, lines.end());
+}
+
+
+LineFitter::Line LineFitter::makeLine(std::size_t begin,
+                                      const Candidate& candidate,
+                                      float maxWidth) const
+{
+    Line line;
+    line.begin = begin;
+    line.end = candidate.end;
+    line.width = width(begin, candidate.contentEnd);
+    line.mandatory = candidate.mandatory;
+    line.overfull = line.width > maxWidth;
+    return line;
+}
+
+
+} // namespace ofx
@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofx/TextConverterPool.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace ofx {
+
+
+struct TextConverterPool::Shared
+{
+    /// \brief Guards the converters.
+    std::mutex mutex;
+
+    /// \brief The converters in use by a thread.
+    std::unordered_map<TextConverter*, std::shared_ptr<TextConverter>> assigned;
+
+    /// \brief The converters returned by exited threads, by Settings key.
+    std::unordered_multimap<std::string, std::shared_ptr<TextConverter>> idle;
+};
+
+
+struct TextConverterPool::ThreadConverters
+{
+    /// \brief The pool's converters, expired once the pool is destroyed.
+    std::weak_ptr<Shared> shared;
+
+    /// \brief The thread's converters by Settings key. The pool owns them.
+    std::unordered_map<std::string, std::weak_ptr<TextConverter>> converters;
+};
+
+
+struct TextConverterPool::ThreadTables
+{
+    /// \brief Return the thread's converters to the pools that still exist.
+    ~ThreadTables()
+    {
+        for (auto& pool: pools)
+        {
+            auto shared = pool.second.shared.lock();
+
+            if (!shared)
+                continue;
+
+            std::lock_guard<std::mutex> lock(shared->mutex);
+
+            for (auto& entry: pool.second.converters)
+            {
+                auto iter = shared->assigned.find(entry.second.lock().get());
+
+                if (iter != shared->assigned.end())
+                {
+                    shared->idle.emplace(entry.first, std::move(iter->second));
+                    shared->assigned.erase(iter);
+                }
+            }
+        }
+    }
+
+    /// \brief Remove the tables of destroyed pools.
+    void prune()
+    {
+        for (auto iter = pools.begin(); iter != pools.end();)
+        {
+            if (iter->second.shared.expired())
+                iter = pools.erase(iter);
+            else
+                ++iter;
+        }
+    }
+
+    /// \brief The thread's converters by pool id.
+    std::unordered_map<uint64_t, ThreadConverters> pools;
+};
+
+
+TextConverterPool::TextConverterPool():
+    _shared(std::make_shared<Shared>())
+{
+    static std::atomic<uint64_t> nextId(0);
+    _id = nextId.fetch_add(1);
+}
+
+
+TextConverterPool::~TextConverterPool()
+{
+}
+
+
+int TextConverterPool::convert(const std::string& input,
+                               std::string& output,
+                               const TextConverter::Settings& settings)
+{
+    auto converter = this->converter(settings);
+
+    if (!converter)
+        return -1;
+
+    converter->reset();
+    return converter->convert(input, output);
+}
+
+
+int TextConverterPool::convert(const std::string& input,
+                               std::string& output,
+                               const std::string& inputEncoding,
+                               const std::string& outputEncoding)
+{
+    TextConverter::Settings settings;
+    settings.inputEncoding = inputEncoding;
+    settings.outputEncoding = outputEncoding;
+    return convert(input, output, settings);
+}
+
+
+std::string TextConverterPool::convert(const std::string& input,
+                                       const TextConverter::Settings& settings)
+{
+    std::string output;
+    convert(input, output, settings);
+    return output;
+}
+
+
+std::shared_ptr<TextConverter> TextConverterPool::converter(const TextConverter::Settings& settings)
+{
+    ThreadTables& tables = threadTables();
+    std::string key = TextConverter::settingsKey(settings);
+
+    auto pool = tables.pools.find(_id);
+
+    if (pool != tables.pools.end())
+    {
+        auto iter = pool->second.converters.find(key);
+
+        if (iter != pool->second.converters.end())
+        {
+            if (auto converter = iter->second.lock())
+                return converter;
+        }
+    }
+
+    // Only a miss changes the tables, so the tables of destroyed pools are
+    // removed here.
+    tables.prune();
+
+    ThreadConverters& converters = tables.pools[_id];
+    converters.shared = _shared;
+
+    std::shared_ptr<TextConverter> converter;
+
+    {
+        std::lock_guard<std::mutex> lock(_shared->mutex);
+        auto iter = _shared->idle.find(key);
+
+        if (iter != _shared->idle.end())
+        {
+            converter = std::move(iter->second);
+            _shared->idle.erase(iter);
+            _shared->assigned[converter.get()] = converter;
+        }
+    }
+
+    if (!converter)
+    {
+        converter = std::make_shared<TextConverter>();
+
+        if (!converter->setup(settings))
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_shared->mutex);
+        _shared->assigned[converter.get()] = converter;
+    }
+
+    converters.converters[key] = converter;
+    return converter;
+}
+
+
+std::size_t TextConverterPool::size() const
+{
+    std::lock_guard<std::mutex> lock(_shared->mutex);
+    return _shared->assigned.size() + _shared->idle.size();
+}
+
+
+TextConverterPool::ThreadTables& TextConverterPool::threadTables()
+{
+    thread_local ThreadTables tables;
+    return tables;
+}
+
+
+} // namespace ofx
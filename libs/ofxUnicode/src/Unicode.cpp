@@ -6,6 +6,24 @@
 
 
 #include "ofx/Unicode.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 #include "ofUtils.h"
 #include "ofLog.h"
 #include "utf8proc.h"
@@ -67,1172 +85,5866 @@ std::u32string Unicode::Block::charset() const
 }
 
 
-const Unicode::Block Unicode::BASIC_LATIN {0x0000, 0x007F, "BASIC_LATIN"};
-const Unicode::Block Unicode::LATIN_1_SUPPLEMENT {0x0080, 0x00FF, "LATIN_1_SUPPLEMENT"};
-const Unicode::Block Unicode::LATIN_EXTENDED_A {0x0100, 0x017F, "LATIN_EXTENDED_A"};
-const Unicode::Block Unicode::LATIN_EXTENDED_B {0x0180, 0x024F, "LATIN_EXTENDED_B"};
-const Unicode::Block Unicode::IPA_EXTENSIONS {0x0250, 0x02AF, "IPA_EXTENSIONS"};
-const Unicode::Block Unicode::SPACING_MODIFIER_LETTERS {0x02B0, 0x02FF, "SPACING_MODIFIER_LETTERS"};
-const Unicode::Block Unicode::COMBINING_DIACRITICAL_MARKS {0x0300, 0x036F, "COMBINING_DIACRITICAL_MARKS"};
-const Unicode::Block Unicode::GREEK_AND_COPTIC {0x0370, 0x03FF, "GREEK_AND_COPTIC"};
-const Unicode::Block Unicode::CYRILLIC {0x0400, 0x04FF, "CYRILLIC"};
-const Unicode::Block Unicode::CYRILLIC_SUPPLEMENT {0x0500, 0x052F, "CYRILLIC_SUPPLEMENT"};
-const Unicode::Block Unicode::ARMENIAN {0x0530, 0x058F, "ARMENIAN"};
-const Unicode::Block Unicode::HEBREW {0x0590, 0x05FF, "HEBREW"};
-const Unicode::Block Unicode::ARABIC {0x0600, 0x06FF, "ARABIC"};
-const Unicode::Block Unicode::SYRIAC {0x0700, 0x074F, "SYRIAC"};
-const Unicode::Block Unicode::ARABIC_SUPPLEMENT {0x0750, 0x077F, "ARABIC_SUPPLEMENT"};
-const Unicode::Block Unicode::THAANA {0x0780, 0x07BF, "THAANA"};
-const Unicode::Block Unicode::NKO {0x07C0, 0x07FF, "NKO"};
-const Unicode::Block Unicode::SAMARITAN {0x0800, 0x083F, "SAMARITAN"};
-const Unicode::Block Unicode::MANDAIC {0x0840, 0x085F, "MANDAIC"};
-const Unicode::Block Unicode::SYRIAC_SUPPLEMENT {0x0860, 0x086F, "SYRIAC_SUPPLEMENT"};
-const Unicode::Block Unicode::ARABIC_EXTENDED_A {0x08A0, 0x08FF, "ARABIC_EXTENDED_A"};
-const Unicode::Block Unicode::DEVANAGARI {0x0900, 0x097F, "DEVANAGARI"};
-const Unicode::Block Unicode::BENGALI {0x0980, 0x09FF, "BENGALI"};
-const Unicode::Block Unicode::GURMUKHI {0x0A00, 0x0A7F, "GURMUKHI"};
-const Unicode::Block Unicode::GUJARATI {0x0A80, 0x0AFF, "GUJARATI"};
-const Unicode::Block Unicode::ORIYA {0x0B00, 0x0B7F, "ORIYA"};
-const Unicode::Block Unicode::TAMIL {0x0B80, 0x0BFF, "TAMIL"};
-const Unicode::Block Unicode::TELUGU {0x0C00, 0x0C7F, "TELUGU"};
-const Unicode::Block Unicode::KANNADA {0x0C80, 0x0CFF, "KANNADA"};
-const Unicode::Block Unicode::MALAYALAM {0x0D00, 0x0D7F, "MALAYALAM"};
-const Unicode::Block Unicode::SINHALA {0x0D80, 0x0DFF, "SINHALA"};
-const Unicode::Block Unicode::THAI {0x0E00, 0x0E7F, "THAI"};
-const Unicode::Block Unicode::LAO {0x0E80, 0x0EFF, "LAO"};
-const Unicode::Block Unicode::TIBETAN {0x0F00, 0x0FFF, "TIBETAN"};
-const Unicode::Block Unicode::MYANMAR {0x1000, 0x109F, "MYANMAR"};
-const Unicode::Block Unicode::GEORGIAN {0x10A0, 0x10FF, "GEORGIAN"};
-const Unicode::Block Unicode::HANGUL_JAMO {0x1100, 0x11FF, "HANGUL_JAMO"};
-const Unicode::Block Unicode::ETHIOPIC {0x1200, 0x137F, "ETHIOPIC"};
-const Unicode::Block Unicode::ETHIOPIC_SUPPLEMENT {0x1380, 0x139F, "ETHIOPIC_SUPPLEMENT"};
-const Unicode::Block Unicode::CHEROKEE {0x13A0, 0x13FF, "CHEROKEE"};
-const Unicode::Block Unicode::UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS {0x1400, 0x167F, "UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS"};
-const Unicode::Block Unicode::OGHAM {0x1680, 0x169F, "OGHAM"};
-const Unicode::Block Unicode::RUNIC {0x16A0, 0x16FF, "RUNIC"};
-const Unicode::Block Unicode::TAGALOG {0x1700, 0x171F, "TAGALOG"};
-const Unicode::Block Unicode::HANUNOO {0x1720, 0x173F, "HANUNOO"};
-const Unicode::Block Unicode::BUHID {0x1740, 0x175F, "BUHID"};
-const Unicode::Block Unicode::TAGBANWA {0x1760, 0x177F, "TAGBANWA"};
-const Unicode::Block Unicode::KHMER {0x1780, 0x17FF, "KHMER"};
-const Unicode::Block Unicode::MONGOLIAN {0x1800, 0x18AF, "MONGOLIAN"};
-const Unicode::Block Unicode::UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED {0x18B0, 0x18FF, "UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED"};
-const Unicode::Block Unicode::LIMBU {0x1900, 0x194F, "LIMBU"};
-const Unicode::Block Unicode::TAI_LE {0x1950, 0x197F, "TAI_LE"};
-const Unicode::Block Unicode::NEW_TAI_LUE {0x1980, 0x19DF, "NEW_TAI_LUE"};
-const Unicode::Block Unicode::KHMER_SYMBOLS {0x19E0, 0x19FF, "KHMER_SYMBOLS"};
-const Unicode::Block Unicode::BUGINESE {0x1A00, 0x1A1F, "BUGINESE"};
-const Unicode::Block Unicode::TAI_THAM {0x1A20, 0x1AAF, "TAI_THAM"};
-const Unicode::Block Unicode::COMBINING_DIACRITICAL_MARKS_EXTENDED {0x1AB0, 0x1AFF, "COMBINING_DIACRITICAL_MARKS_EXTENDED"};
-const Unicode::Block Unicode::BALINESE {0x1B00, 0x1B7F, "BALINESE"};
-const Unicode::Block Unicode::SUNDANESE {0x1B80, 0x1BBF, "SUNDANESE"};
-const Unicode::Block Unicode::BATAK {0x1BC0, 0x1BFF, "BATAK"};
-const Unicode::Block Unicode::LEPCHA {0x1C00, 0x1C4F, "LEPCHA"};
-const Unicode::Block Unicode::OL_CHIKI {0x1C50, 0x1C7F, "OL_CHIKI"};
-const Unicode::Block Unicode::CYRILLIC_EXTENDED_C {0x1C80, 0x1C8F, "CYRILLIC_EXTENDED_C"};
-const Unicode::Block Unicode::GEORGIAN_EXTENDED {0x1C90, 0x1CBF, "GEORGIAN_EXTENDED"};
-const Unicode::Block Unicode::SUNDANESE_SUPPLEMENT {0x1CC0, 0x1CCF, "SUNDANESE_SUPPLEMENT"};
-const Unicode::Block Unicode::VEDIC_EXTENSIONS {0x1CD0, 0x1CFF, "VEDIC_EXTENSIONS"};
-const Unicode::Block Unicode::PHONETIC_EXTENSIONS {0x1D00, 0x1D7F, "PHONETIC_EXTENSIONS"};
-const Unicode::Block Unicode::PHONETIC_EXTENSIONS_SUPPLEMENT {0x1D80, 0x1DBF, "PHONETIC_EXTENSIONS_SUPPLEMENT"};
-const Unicode::Block Unicode::COMBINING_DIACRITICAL_MARKS_SUPPLEMENT {0x1DC0, 0x1DFF, "COMBINING_DIACRITICAL_MARKS_SUPPLEMENT"};
-const Unicode::Block Unicode::LATIN_EXTENDED_ADDITIONAL {0x1E00, 0x1EFF, "LATIN_EXTENDED_ADDITIONAL"};
-const Unicode::Block Unicode::GREEK_EXTENDED {0x1F00, 0x1FFF, "GREEK_EXTENDED"};
-const Unicode::Block Unicode::GENERAL_PUNCTUATION {0x2000, 0x206F, "GENERAL_PUNCTUATION"};
-const Unicode::Block Unicode::SUPERSCRIPTS_AND_SUBSCRIPTS {0x2070, 0x209F, "SUPERSCRIPTS_AND_SUBSCRIPTS"};
-const Unicode::Block Unicode::CURRENCY_SYMBOLS {0x20A0, 0x20CF, "CURRENCY_SYMBOLS"};
-const Unicode::Block Unicode::COMBINING_DIACRITICAL_MARKS_FOR_SYMBOLS {0x20D0, 0x20FF, "COMBINING_DIACRITICAL_MARKS_FOR_SYMBOLS"};
-const Unicode::Block Unicode::LETTERLIKE_SYMBOLS {0x2100, 0x214F, "LETTERLIKE_SYMBOLS"};
-const Unicode::Block Unicode::NUMBER_FORMS {0x2150, 0x218F, "NUMBER_FORMS"};
-const Unicode::Block Unicode::ARROWS {0x2190, 0x21FF, "ARROWS"};
-const Unicode::Block Unicode::MATHEMATICAL_OPERATORS {0x2200, 0x22FF, "MATHEMATICAL_OPERATORS"};
-const Unicode::Block Unicode::MISCELLANEOUS_TECHNICAL {0x2300, 0x23FF, "MISCELLANEOUS_TECHNICAL"};
-const Unicode::Block Unicode::CONTROL_PICTURES {0x2400, 0x243F, "CONTROL_PICTURES"};
-const Unicode::Block Unicode::OPTICAL_CHARACTER_RECOGNITION {0x2440, 0x245F, "OPTICAL_CHARACTER_RECOGNITION"};
-const Unicode::Block Unicode::ENCLOSED_ALPHANUMERICS {0x2460, 0x24FF, "ENCLOSED_ALPHANUMERICS"};
-const Unicode::Block Unicode::BOX_DRAWING {0x2500, 0x257F, "BOX_DRAWING"};
-const Unicode::Block Unicode::BLOCK_ELEMENTS {0x2580, 0x259F, "BLOCK_ELEMENTS"};
-const Unicode::Block Unicode::GEOMETRIC_SHAPES {0x25A0, 0x25FF, "GEOMETRIC_SHAPES"};
-const Unicode::Block Unicode::MISCELLANEOUS_SYMBOLS {0x2600, 0x26FF, "MISCELLANEOUS_SYMBOLS"};
-const Unicode::Block Unicode::DINGBATS {0x2700, 0x27BF, "DINGBATS"};
-const Unicode::Block Unicode::MISCELLANEOUS_MATHEMATICAL_SYMBOLS_A {0x27C0, 0x27EF, "MISCELLANEOUS_MATHEMATICAL_SYMBOLS_A"};
-const Unicode::Block Unicode::SUPPLEMENTAL_ARROWS_A {0x27F0, 0x27FF, "SUPPLEMENTAL_ARROWS_A"};
-const Unicode::Block Unicode::BRAILLE_PATTERNS {0x2800, 0x28FF, "BRAILLE_PATTERNS"};
-const Unicode::Block Unicode::SUPPLEMENTAL_ARROWS_B {0x2900, 0x297F, "SUPPLEMENTAL_ARROWS_B"};
-const Unicode::Block Unicode::MISCELLANEOUS_MATHEMATICAL_SYMBOLS_B {0x2980, 0x29FF, "MISCELLANEOUS_MATHEMATICAL_SYMBOLS_B"};
-const Unicode::Block Unicode::SUPPLEMENTAL_MATHEMATICAL_OPERATORS {0x2A00, 0x2AFF, "SUPPLEMENTAL_MATHEMATICAL_OPERATORS"};
-const Unicode::Block Unicode::MISCELLANEOUS_SYMBOLS_AND_ARROWS {0x2B00, 0x2BFF, "MISCELLANEOUS_SYMBOLS_AND_ARROWS"};
-const Unicode::Block Unicode::GLAGOLITIC {0x2C00, 0x2C5F, "GLAGOLITIC"};
-const Unicode::Block Unicode::LATIN_EXTENDED_C {0x2C60, 0x2C7F, "LATIN_EXTENDED_C"};
-const Unicode::Block Unicode::COPTIC {0x2C80, 0x2CFF, "COPTIC"};
-const Unicode::Block Unicode::GEORGIAN_SUPPLEMENT {0x2D00, 0x2D2F, "GEORGIAN_SUPPLEMENT"};
-const Unicode::Block Unicode::TIFINAGH {0x2D30, 0x2D7F, "TIFINAGH"};
-const Unicode::Block Unicode::ETHIOPIC_EXTENDED {0x2D80, 0x2DDF, "ETHIOPIC_EXTENDED"};
-const Unicode::Block Unicode::CYRILLIC_EXTENDED_A {0x2DE0, 0x2DFF, "CYRILLIC_EXTENDED_A"};
-const Unicode::Block Unicode::SUPPLEMENTAL_PUNCTUATION {0x2E00, 0x2E7F, "SUPPLEMENTAL_PUNCTUATION"};
-const Unicode::Block Unicode::CJK_RADICALS_SUPPLEMENT {0x2E80, 0x2EFF, "CJK_RADICALS_SUPPLEMENT"};
-const Unicode::Block Unicode::KANGXI_RADICALS {0x2F00, 0x2FDF, "KANGXI_RADICALS"};
-const Unicode::Block Unicode::IDEOGRAPHIC_DESCRIPTION_CHARACTERS {0x2FF0, 0x2FFF, "IDEOGRAPHIC_DESCRIPTION_CHARACTERS"};
-const Unicode::Block Unicode::CJK_SYMBOLS_AND_PUNCTUATION {0x3000, 0x303F, "CJK_SYMBOLS_AND_PUNCTUATION"};
-const Unicode::Block Unicode::HIRAGANA {0x3040, 0x309F, "HIRAGANA"};
-const Unicode::Block Unicode::KATAKANA {0x30A0, 0x30FF, "KATAKANA"};
-const Unicode::Block Unicode::BOPOMOFO {0x3100, 0x312F, "BOPOMOFO"};
-const Unicode::Block Unicode::HANGUL_COMPATIBILITY_JAMO {0x3130, 0x318F, "HANGUL_COMPATIBILITY_JAMO"};
-const Unicode::Block Unicode::KANBUN {0x3190, 0x319F, "KANBUN"};
-const Unicode::Block Unicode::BOPOMOFO_EXTENDED {0x31A0, 0x31BF, "BOPOMOFO_EXTENDED"};
-const Unicode::Block Unicode::CJK_STROKES {0x31C0, 0x31EF, "CJK_STROKES"};
-const Unicode::Block Unicode::KATAKANA_PHONETIC_EXTENSIONS {0x31F0, 0x31FF, "KATAKANA_PHONETIC_EXTENSIONS"};
-const Unicode::Block Unicode::ENCLOSED_CJK_LETTERS_AND_MONTHS {0x3200, 0x32FF, "ENCLOSED_CJK_LETTERS_AND_MONTHS"};
-const Unicode::Block Unicode::CJK_COMPATIBILITY {0x3300, 0x33FF, "CJK_COMPATIBILITY"};
-const Unicode::Block Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_A {0x3400, 0x4DBF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_A"};
-const Unicode::Block Unicode::YIJING_HEXAGRAM_SYMBOLS {0x4DC0, 0x4DFF, "YIJING_HEXAGRAM_SYMBOLS"};
-const Unicode::Block Unicode::CJK_UNIFIED_IDEOGRAPHS {0x4E00, 0x9FFF, "CJK_UNIFIED_IDEOGRAPHS"};
-const Unicode::Block Unicode::YI_SYLLABLES {0xA000, 0xA48F, "YI_SYLLABLES"};
-const Unicode::Block Unicode::YI_RADICALS {0xA490, 0xA4CF, "YI_RADICALS"};
-const Unicode::Block Unicode::LISU {0xA4D0, 0xA4FF, "LISU"};
-const Unicode::Block Unicode::VAI {0xA500, 0xA63F, "VAI"};
-const Unicode::Block Unicode::CYRILLIC_EXTENDED_B {0xA640, 0xA69F, "CYRILLIC_EXTENDED_B"};
-const Unicode::Block Unicode::BAMUM {0xA6A0, 0xA6FF, "BAMUM"};
-const Unicode::Block Unicode::MODIFIER_TONE_LETTERS {0xA700, 0xA71F, "MODIFIER_TONE_LETTERS"};
-const Unicode::Block Unicode::LATIN_EXTENDED_D {0xA720, 0xA7FF, "LATIN_EXTENDED_D"};
-const Unicode::Block Unicode::SYLOTI_NAGRI {0xA800, 0xA82F, "SYLOTI_NAGRI"};
-const Unicode::Block Unicode::COMMON_INDIC_NUMBER_FORMS {0xA830, 0xA83F, "COMMON_INDIC_NUMBER_FORMS"};
-const Unicode::Block Unicode::PHAGS_PA {0xA840, 0xA87F, "PHAGS_PA"};
-const Unicode::Block Unicode::SAURASHTRA {0xA880, 0xA8DF, "SAURASHTRA"};
-const Unicode::Block Unicode::DEVANAGARI_EXTENDED {0xA8E0, 0xA8FF, "DEVANAGARI_EXTENDED"};
-const Unicode::Block Unicode::KAYAH_LI {0xA900, 0xA92F, "KAYAH_LI"};
-const Unicode::Block Unicode::REJANG {0xA930, 0xA95F, "REJANG"};
-const Unicode::Block Unicode::HANGUL_JAMO_EXTENDED_A {0xA960, 0xA97F, "HANGUL_JAMO_EXTENDED_A"};
-const Unicode::Block Unicode::JAVANESE {0xA980, 0xA9DF, "JAVANESE"};
-const Unicode::Block Unicode::MYANMAR_EXTENDED_B {0xA9E0, 0xA9FF, "MYANMAR_EXTENDED_B"};
-const Unicode::Block Unicode::CHAM {0xAA00, 0xAA5F, "CHAM"};
-const Unicode::Block Unicode::MYANMAR_EXTENDED_A {0xAA60, 0xAA7F, "MYANMAR_EXTENDED_A"};
-const Unicode::Block Unicode::TAI_VIET {0xAA80, 0xAADF, "TAI_VIET"};
-const Unicode::Block Unicode::MEETEI_MAYEK_EXTENSIONS {0xAAE0, 0xAAFF, "MEETEI_MAYEK_EXTENSIONS"};
-const Unicode::Block Unicode::ETHIOPIC_EXTENDED_A {0xAB00, 0xAB2F, "ETHIOPIC_EXTENDED_A"};
-const Unicode::Block Unicode::LATIN_EXTENDED_E {0xAB30, 0xAB6F, "LATIN_EXTENDED_E"};
-const Unicode::Block Unicode::CHEROKEE_SUPPLEMENT {0xAB70, 0xABBF, "CHEROKEE_SUPPLEMENT"};
-const Unicode::Block Unicode::MEETEI_MAYEK {0xABC0, 0xABFF, "MEETEI_MAYEK"};
-const Unicode::Block Unicode::HANGUL_SYLLABLES {0xAC00, 0xD7AF, "HANGUL_SYLLABLES"};
-const Unicode::Block Unicode::HANGUL_JAMO_EXTENDED_B {0xD7B0, 0xD7FF, "HANGUL_JAMO_EXTENDED_B"};
-const Unicode::Block Unicode::HIGH_SURROGATES {0xD800, 0xDB7F, "HIGH_SURROGATES"};
-const Unicode::Block Unicode::HIGH_PRIVATE_USE_SURROGATES {0xDB80, 0xDBFF, "HIGH_PRIVATE_USE_SURROGATES"};
-const Unicode::Block Unicode::LOW_SURROGATES {0xDC00, 0xDFFF, "LOW_SURROGATES"};
-const Unicode::Block Unicode::PRIVATE_USE_AREA {0xE000, 0xF8FF, "PRIVATE_USE_AREA"};
-const Unicode::Block Unicode::CJK_COMPATIBILITY_IDEOGRAPHS {0xF900, 0xFAFF, "CJK_COMPATIBILITY_IDEOGRAPHS"};
-const Unicode::Block Unicode::ALPHABETIC_PRESENTATION_FORMS {0xFB00, 0xFB4F, "ALPHABETIC_PRESENTATION_FORMS"};
-const Unicode::Block Unicode::ARABIC_PRESENTATION_FORMS_A {0xFB50, 0xFDFF, "ARABIC_PRESENTATION_FORMS_A"};
-const Unicode::Block Unicode::VARIATION_SELECTORS {0xFE00, 0xFE0F, "VARIATION_SELECTORS"};
-const Unicode::Block Unicode::VERTICAL_FORMS {0xFE10, 0xFE1F, "VERTICAL_FORMS"};
-const Unicode::Block Unicode::COMBINING_HALF_MARKS {0xFE20, 0xFE2F, "COMBINING_HALF_MARKS"};
-const Unicode::Block Unicode::CJK_COMPATIBILITY_FORMS {0xFE30, 0xFE4F, "CJK_COMPATIBILITY_FORMS"};
-const Unicode::Block Unicode::SMALL_FORM_VARIANTS {0xFE50, 0xFE6F, "SMALL_FORM_VARIANTS"};
-const Unicode::Block Unicode::ARABIC_PRESENTATION_FORMS_B {0xFE70, 0xFEFF, "ARABIC_PRESENTATION_FORMS_B"};
-const Unicode::Block Unicode::HALFWIDTH_AND_FULLWIDTH_FORMS {0xFF00, 0xFFEF, "HALFWIDTH_AND_FULLWIDTH_FORMS"};
-const Unicode::Block Unicode::SPECIALS {0xFFF0, 0xFFFF, "SPECIALS"};
-const Unicode::Block Unicode::LINEAR_B_SYLLABARY {0x10000, 0x1007F, "LINEAR_B_SYLLABARY"};
-const Unicode::Block Unicode::LINEAR_B_IDEOGRAMS {0x10080, 0x100FF, "LINEAR_B_IDEOGRAMS"};
-const Unicode::Block Unicode::AEGEAN_NUMBERS {0x10100, 0x1013F, "AEGEAN_NUMBERS"};
-const Unicode::Block Unicode::ANCIENT_GREEK_NUMBERS {0x10140, 0x1018F, "ANCIENT_GREEK_NUMBERS"};
-const Unicode::Block Unicode::ANCIENT_SYMBOLS {0x10190, 0x101CF, "ANCIENT_SYMBOLS"};
-const Unicode::Block Unicode::PHAISTOS_DISC {0x101D0, 0x101FF, "PHAISTOS_DISC"};
-const Unicode::Block Unicode::LYCIAN {0x10280, 0x1029F, "LYCIAN"};
-const Unicode::Block Unicode::CARIAN {0x102A0, 0x102DF, "CARIAN"};
-const Unicode::Block Unicode::COPTIC_EPACT_NUMBERS {0x102E0, 0x102FF, "COPTIC_EPACT_NUMBERS"};
-const Unicode::Block Unicode::OLD_ITALIC {0x10300, 0x1032F, "OLD_ITALIC"};
-const Unicode::Block Unicode::GOTHIC {0x10330, 0x1034F, "GOTHIC"};
-const Unicode::Block Unicode::OLD_PERMIC {0x10350, 0x1037F, "OLD_PERMIC"};
-const Unicode::Block Unicode::UGARITIC {0x10380, 0x1039F, "UGARITIC"};
-const Unicode::Block Unicode::OLD_PERSIAN {0x103A0, 0x103DF, "OLD_PERSIAN"};
-const Unicode::Block Unicode::DESERET {0x10400, 0x1044F, "DESERET"};
-const Unicode::Block Unicode::SHAVIAN {0x10450, 0x1047F, "SHAVIAN"};
-const Unicode::Block Unicode::OSMANYA {0x10480, 0x104AF, "OSMANYA"};
-const Unicode::Block Unicode::OSAGE {0x104B0, 0x104FF, "OSAGE"};
-const Unicode::Block Unicode::ELBASAN {0x10500, 0x1052F, "ELBASAN"};
-const Unicode::Block Unicode::CAUCASIAN_ALBANIAN {0x10530, 0x1056F, "CAUCASIAN_ALBANIAN"};
-const Unicode::Block Unicode::LINEAR_A {0x10600, 0x1077F, "LINEAR_A"};
-const Unicode::Block Unicode::CYPRIOT_SYLLABARY {0x10800, 0x1083F, "CYPRIOT_SYLLABARY"};
-const Unicode::Block Unicode::IMPERIAL_ARAMAIC {0x10840, 0x1085F, "IMPERIAL_ARAMAIC"};
-const Unicode::Block Unicode::PALMYRENE {0x10860, 0x1087F, "PALMYRENE"};
-const Unicode::Block Unicode::NABATAEAN {0x10880, 0x108AF, "NABATAEAN"};
-const Unicode::Block Unicode::HATRAN {0x108E0, 0x108FF, "HATRAN"};
-const Unicode::Block Unicode::PHOENICIAN {0x10900, 0x1091F, "PHOENICIAN"};
-const Unicode::Block Unicode::LYDIAN {0x10920, 0x1093F, "LYDIAN"};
-const Unicode::Block Unicode::MEROITIC_HIEROGLYPHS {0x10980, 0x1099F, "MEROITIC_HIEROGLYPHS"};
-const Unicode::Block Unicode::MEROITIC_CURSIVE {0x109A0, 0x109FF, "MEROITIC_CURSIVE"};
-const Unicode::Block Unicode::KHAROSHTHI {0x10A00, 0x10A5F, "KHAROSHTHI"};
-const Unicode::Block Unicode::OLD_SOUTH_ARABIAN {0x10A60, 0x10A7F, "OLD_SOUTH_ARABIAN"};
-const Unicode::Block Unicode::OLD_NORTH_ARABIAN {0x10A80, 0x10A9F, "OLD_NORTH_ARABIAN"};
-const Unicode::Block Unicode::MANICHAEAN {0x10AC0, 0x10AFF, "MANICHAEAN"};
-const Unicode::Block Unicode::AVESTAN {0x10B00, 0x10B3F, "AVESTAN"};
-const Unicode::Block Unicode::INSCRIPTIONAL_PARTHIAN {0x10B40, 0x10B5F, "INSCRIPTIONAL_PARTHIAN"};
-const Unicode::Block Unicode::INSCRIPTIONAL_PAHLAVI {0x10B60, 0x10B7F, "INSCRIPTIONAL_PAHLAVI"};
-const Unicode::Block Unicode::PSALTER_PAHLAVI {0x10B80, 0x10BAF, "PSALTER_PAHLAVI"};
-const Unicode::Block Unicode::OLD_TURKIC {0x10C00, 0x10C4F, "OLD_TURKIC"};
-const Unicode::Block Unicode::OLD_HUNGARIAN {0x10C80, 0x10CFF, "OLD_HUNGARIAN"};
-const Unicode::Block Unicode::HANIFI_ROHINGYA {0x10D00, 0x10D3F, "HANIFI_ROHINGYA"};
-const Unicode::Block Unicode::RUMI_NUMERAL_SYMBOLS {0x10E60, 0x10E7F, "RUMI_NUMERAL_SYMBOLS"};
-const Unicode::Block Unicode::OLD_SOGDIAN {0x10F00, 0x10F2F, "OLD_SOGDIAN"};
-const Unicode::Block Unicode::SOGDIAN {0x10F30, 0x10F6F, "SOGDIAN"};
-const Unicode::Block Unicode::ELYMAIC {0x10FE0, 0x10FFF, "ELYMAIC"};
-const Unicode::Block Unicode::BRAHMI {0x11000, 0x1107F, "BRAHMI"};
-const Unicode::Block Unicode::KAITHI {0x11080, 0x110CF, "KAITHI"};
-const Unicode::Block Unicode::SORA_SOMPENG {0x110D0, 0x110FF, "SORA_SOMPENG"};
-const Unicode::Block Unicode::CHAKMA {0x11100, 0x1114F, "CHAKMA"};
-const Unicode::Block Unicode::MAHAJANI {0x11150, 0x1117F, "MAHAJANI"};
-const Unicode::Block Unicode::SHARADA {0x11180, 0x111DF, "SHARADA"};
-const Unicode::Block Unicode::SINHALA_ARCHAIC_NUMBERS {0x111E0, 0x111FF, "SINHALA_ARCHAIC_NUMBERS"};
-const Unicode::Block Unicode::KHOJKI {0x11200, 0x1124F, "KHOJKI"};
-const Unicode::Block Unicode::MULTANI {0x11280, 0x112AF, "MULTANI"};
-const Unicode::Block Unicode::KHUDAWADI {0x112B0, 0x112FF, "KHUDAWADI"};
-const Unicode::Block Unicode::GRANTHA {0x11300, 0x1137F, "GRANTHA"};
-const Unicode::Block Unicode::NEWA {0x11400, 0x1147F, "NEWA"};
-const Unicode::Block Unicode::TIRHUTA {0x11480, 0x114DF, "TIRHUTA"};
-const Unicode::Block Unicode::SIDDHAM {0x11580, 0x115FF, "SIDDHAM"};
-const Unicode::Block Unicode::MODI {0x11600, 0x1165F, "MODI"};
-const Unicode::Block Unicode::MONGOLIAN_SUPPLEMENT {0x11660, 0x1167F, "MONGOLIAN_SUPPLEMENT"};
-const Unicode::Block Unicode::TAKRI {0x11680, 0x116CF, "TAKRI"};
-const Unicode::Block Unicode::AHOM {0x11700, 0x1173F, "AHOM"};
-const Unicode::Block Unicode::DOGRA {0x11800, 0x1184F, "DOGRA"};
-const Unicode::Block Unicode::WARANG_CITI {0x118A0, 0x118FF, "WARANG_CITI"};
-const Unicode::Block Unicode::NANDINAGARI {0x119A0, 0x119FF, "NANDINAGARI"};
-const Unicode::Block Unicode::ZANABAZAR_SQUARE {0x11A00, 0x11A4F, "ZANABAZAR_SQUARE"};
-const Unicode::Block Unicode::SOYOMBO {0x11A50, 0x11AAF, "SOYOMBO"};
-const Unicode::Block Unicode::PAU_CIN_HAU {0x11AC0, 0x11AFF, "PAU_CIN_HAU"};
-const Unicode::Block Unicode::BHAIKSUKI {0x11C00, 0x11C6F, "BHAIKSUKI"};
-const Unicode::Block Unicode::MARCHEN {0x11C70, 0x11CBF, "MARCHEN"};
-const Unicode::Block Unicode::MASARAM_GONDI {0x11D00, 0x11D5F, "MASARAM_GONDI"};
-const Unicode::Block Unicode::GUNJALA_GONDI {0x11D60, 0x11DAF, "GUNJALA_GONDI"};
-const Unicode::Block Unicode::MAKASAR {0x11EE0, 0x11EFF, "MAKASAR"};
-const Unicode::Block Unicode::TAMIL_SUPPLEMENT {0x11FC0, 0x11FFF, "TAMIL_SUPPLEMENT"};
-const Unicode::Block Unicode::CUNEIFORM {0x12000, 0x123FF, "CUNEIFORM"};
-const Unicode::Block Unicode::CUNEIFORM_NUMBERS_AND_PUNCTUATION {0x12400, 0x1247F, "CUNEIFORM_NUMBERS_AND_PUNCTUATION"};
-const Unicode::Block Unicode::EARLY_DYNASTIC_CUNEIFORM {0x12480, 0x1254F, "EARLY_DYNASTIC_CUNEIFORM"};
-const Unicode::Block Unicode::EGYPTIAN_HIEROGLYPHS {0x13000, 0x1342F, "EGYPTIAN_HIEROGLYPHS"};
-const Unicode::Block Unicode::EGYPTIAN_HIEROGLYPH_FORMAT_CONTROLS {0x13430, 0x1343F, "EGYPTIAN_HIEROGLYPH_FORMAT_CONTROLS"};
-const Unicode::Block Unicode::ANATOLIAN_HIEROGLYPHS {0x14400, 0x1467F, "ANATOLIAN_HIEROGLYPHS"};
-const Unicode::Block Unicode::BAMUM_SUPPLEMENT {0x16800, 0x16A3F, "BAMUM_SUPPLEMENT"};
-const Unicode::Block Unicode::MRO {0x16A40, 0x16A6F, "MRO"};
-const Unicode::Block Unicode::BASSA_VAH {0x16AD0, 0x16AFF, "BASSA_VAH"};
-const Unicode::Block Unicode::PAHAWH_HMONG {0x16B00, 0x16B8F, "PAHAWH_HMONG"};
-const Unicode::Block Unicode::MEDEFAIDRIN {0x16E40, 0x16E9F, "MEDEFAIDRIN"};
-const Unicode::Block Unicode::MIAO {0x16F00, 0x16F9F, "MIAO"};
-const Unicode::Block Unicode::IDEOGRAPHIC_SYMBOLS_AND_PUNCTUATION {0x16FE0, 0x16FFF, "IDEOGRAPHIC_SYMBOLS_AND_PUNCTUATION"};
-const Unicode::Block Unicode::TANGUT {0x17000, 0x187FF, "TANGUT"};
-const Unicode::Block Unicode::TANGUT_COMPONENTS {0x18800, 0x18AFF, "TANGUT_COMPONENTS"};
-const Unicode::Block Unicode::KANA_SUPPLEMENT {0x1B000, 0x1B0FF, "KANA_SUPPLEMENT"};
-const Unicode::Block Unicode::KANA_EXTENDED_A {0x1B100, 0x1B12F, "KANA_EXTENDED_A"};
-const Unicode::Block Unicode::SMALL_KANA_EXTENSION {0x1B130, 0x1B16F, "SMALL_KANA_EXTENSION"};
-const Unicode::Block Unicode::NUSHU {0x1B170, 0x1B2FF, "NUSHU"};
-const Unicode::Block Unicode::DUPLOYAN {0x1BC00, 0x1BC9F, "DUPLOYAN"};
-const Unicode::Block Unicode::SHORTHAND_FORMAT_CONTROLS {0x1BCA0, 0x1BCAF, "SHORTHAND_FORMAT_CONTROLS"};
-const Unicode::Block Unicode::BYZANTINE_MUSICAL_SYMBOLS {0x1D000, 0x1D0FF, "BYZANTINE_MUSICAL_SYMBOLS"};
-const Unicode::Block Unicode::MUSICAL_SYMBOLS {0x1D100, 0x1D1FF, "MUSICAL_SYMBOLS"};
-const Unicode::Block Unicode::ANCIENT_GREEK_MUSICAL_NOTATION {0x1D200, 0x1D24F, "ANCIENT_GREEK_MUSICAL_NOTATION"};
-const Unicode::Block Unicode::MAYAN_NUMERALS {0x1D2E0, 0x1D2FF, "MAYAN_NUMERALS"};
-const Unicode::Block Unicode::TAI_XUAN_JING_SYMBOLS {0x1D300, 0x1D35F, "TAI_XUAN_JING_SYMBOLS"};
-const Unicode::Block Unicode::COUNTING_ROD_NUMERALS {0x1D360, 0x1D37F, "COUNTING_ROD_NUMERALS"};
-const Unicode::Block Unicode::MATHEMATICAL_ALPHANUMERIC_SYMBOLS {0x1D400, 0x1D7FF, "MATHEMATICAL_ALPHANUMERIC_SYMBOLS"};
-const Unicode::Block Unicode::SUTTON_SIGNWRITING {0x1D800, 0x1DAAF, "SUTTON_SIGNWRITING"};
-const Unicode::Block Unicode::GLAGOLITIC_SUPPLEMENT {0x1E000, 0x1E02F, "GLAGOLITIC_SUPPLEMENT"};
-const Unicode::Block Unicode::NYIAKENG_PUACHUE_HMONG {0x1E100, 0x1E14F, "NYIAKENG_PUACHUE_HMONG"};
-const Unicode::Block Unicode::WANCHO {0x1E2C0, 0x1E2FF, "WANCHO"};
-const Unicode::Block Unicode::MENDE_KIKAKUI {0x1E800, 0x1E8DF, "MENDE_KIKAKUI"};
-const Unicode::Block Unicode::ADLAM {0x1E900, 0x1E95F, "ADLAM"};
-const Unicode::Block Unicode::INDIC_SIYAQ_NUMBERS {0x1EC70, 0x1ECBF, "INDIC_SIYAQ_NUMBERS"};
-const Unicode::Block Unicode::OTTOMAN_SIYAQ_NUMBERS {0x1ED00, 0x1ED4F, "OTTOMAN_SIYAQ_NUMBERS"};
-const Unicode::Block Unicode::ARABIC_MATHEMATICAL_ALPHABETIC_SYMBOLS {0x1EE00, 0x1EEFF, "ARABIC_MATHEMATICAL_ALPHABETIC_SYMBOLS"};
-const Unicode::Block Unicode::MAHJONG_TILES {0x1F000, 0x1F02F, "MAHJONG_TILES"};
-const Unicode::Block Unicode::DOMINO_TILES {0x1F030, 0x1F09F, "DOMINO_TILES"};
-const Unicode::Block Unicode::PLAYING_CARDS {0x1F0A0, 0x1F0FF, "PLAYING_CARDS"};
-const Unicode::Block Unicode::ENCLOSED_ALPHANUMERIC_SUPPLEMENT {0x1F100, 0x1F1FF, "ENCLOSED_ALPHANUMERIC_SUPPLEMENT"};
-const Unicode::Block Unicode::ENCLOSED_IDEOGRAPHIC_SUPPLEMENT {0x1F200, 0x1F2FF, "ENCLOSED_IDEOGRAPHIC_SUPPLEMENT"};
-const Unicode::Block Unicode::MISCELLANEOUS_SYMBOLS_AND_PICTOGRAPHS {0x1F300, 0x1F5FF, "MISCELLANEOUS_SYMBOLS_AND_PICTOGRAPHS"};
-const Unicode::Block Unicode::EMOTICONS {0x1F600, 0x1F64F, "EMOTICONS"};
-const Unicode::Block Unicode::ORNAMENTAL_DINGBATS {0x1F650, 0x1F67F, "ORNAMENTAL_DINGBATS"};
-const Unicode::Block Unicode::TRANSPORT_AND_MAP_SYMBOLS {0x1F680, 0x1F6FF, "TRANSPORT_AND_MAP_SYMBOLS"};
-const Unicode::Block Unicode::ALCHEMICAL_SYMBOLS {0x1F700, 0x1F77F, "ALCHEMICAL_SYMBOLS"};
-const Unicode::Block Unicode::GEOMETRIC_SHAPES_EXTENDED {0x1F780, 0x1F7FF, "GEOMETRIC_SHAPES_EXTENDED"};
-const Unicode::Block Unicode::SUPPLEMENTAL_ARROWS_C {0x1F800, 0x1F8FF, "SUPPLEMENTAL_ARROWS_C"};
-const Unicode::Block Unicode::SUPPLEMENTAL_SYMBOLS_AND_PICTOGRAPHS {0x1F900, 0x1F9FF, "SUPPLEMENTAL_SYMBOLS_AND_PICTOGRAPHS"};
-const Unicode::Block Unicode::CHESS_SYMBOLS {0x1FA00, 0x1FA6F, "CHESS_SYMBOLS"};
-const Unicode::Block Unicode::SYMBOLS_AND_PICTOGRAPHS_EXTENDED_A {0x1FA70, 0x1FAFF, "SYMBOLS_AND_PICTOGRAPHS_EXTENDED_A"};
-const Unicode::Block Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_B {0x20000, 0x2A6DF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_B"};
-const Unicode::Block Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_C {0x2A700, 0x2B73F, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_C"};
-const Unicode::Block Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_D {0x2B740, 0x2B81F, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_D"};
-const Unicode::Block Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_E {0x2B820, 0x2CEAF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_E"};
-const Unicode::Block Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_F {0x2CEB0, 0x2EBEF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_F"};
-const Unicode::Block Unicode::CJK_COMPATIBILITY_IDEOGRAPHS_SUPPLEMENT {0x2F800, 0x2FA1F, "CJK_COMPATIBILITY_IDEOGRAPHS_SUPPLEMENT"};
-const Unicode::Block Unicode::TAGS {0xE0000, 0xE007F, "TAGS"};
-const Unicode::Block Unicode::VARIATION_SELECTORS_SUPPLEMENT {0xE0100, 0xE01EF, "VARIATION_SELECTORS_SUPPLEMENT"};
-const Unicode::Block Unicode::SUPPLEMENTARY_PRIVATE_USE_AREA_A {0xF0000, 0xFFFFF, "SUPPLEMENTARY_PRIVATE_USE_AREA_A"};
-const Unicode::Block Unicode::SUPPLEMENTARY_PRIVATE_USE_AREA_B {0x100000, 0x10FFFF, "SUPPLEMENTARY_PRIVATE_USE_AREA_B"};
+std::u32string Unicode::Block::charset(CharsetFilter filter) const
+{
+    if (filter == CharsetFilter::ALL)
+        return charset();
 
+    std::u32string s;
 
-Linebreaker::Linebreaker(const std::string& language):
-    _language(language)
-{
+    for (char32_t codepoint: codepoints())
+    {
+        if (filter == CharsetFilter::PRINTABLE ? UTF32::isPrintable(codepoint)
+                                               : UTF32::isAssigned(codepoint))
+        {
+            s.push_back(codepoint);
+        }
+    }
+
+    return s;
 }
 
 
-Linebreaker::~Linebreaker()
+Unicode::CodepointRange Unicode::Block::codepoints() const
 {
+    return CodepointRange(begin, end);
 }
 
 
-const std::string& Linebreaker::language() const
+bool Unicode::Block::contains(char32_t codepoint) const
 {
-    return _language;
+    return codepoint >= begin && codepoint <= end;
 }
 
 
-std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(const std::string& text) const
+// BEGIN GENERATED UNICODE BLOCKS
+constexpr Unicode::Block BLOCK_TABLE[] = {
+    {0x0000, 0x007F, "BASIC_LATIN"},
+    {0x0080, 0x00FF, "LATIN_1_SUPPLEMENT"},
+    {0x0100, 0x017F, "LATIN_EXTENDED_A"},
+    {0x0180, 0x024F, "LATIN_EXTENDED_B"},
+    {0x0250, 0x02AF, "IPA_EXTENSIONS"},
+    {0x02B0, 0x02FF, "SPACING_MODIFIER_LETTERS"},
+    {0x0300, 0x036F, "COMBINING_DIACRITICAL_MARKS"},
+    {0x0370, 0x03FF, "GREEK_AND_COPTIC"},
+    {0x0400, 0x04FF, "CYRILLIC"},
+    {0x0500, 0x052F, "CYRILLIC_SUPPLEMENT"},
+    {0x0530, 0x058F, "ARMENIAN"},
+    {0x0590, 0x05FF, "HEBREW"},
+    {0x0600, 0x06FF, "ARABIC"},
+    {0x0700, 0x074F, "SYRIAC"},
+    {0x0750, 0x077F, "ARABIC_SUPPLEMENT"},
+    {0x0780, 0x07BF, "THAANA"},
+    {0x07C0, 0x07FF, "NKO"},
+    {0x0800, 0x083F, "SAMARITAN"},
+    {0x0840, 0x085F, "MANDAIC"},
+    {0x0860, 0x086F, "SYRIAC_SUPPLEMENT"},
+    {0x0870, 0x089F, "ARABIC_EXTENDED_B"},
+    {0x08A0, 0x08FF, "ARABIC_EXTENDED_A"},
+    {0x0900, 0x097F, "DEVANAGARI"},
+    {0x0980, 0x09FF, "BENGALI"},
+    {0x0A00, 0x0A7F, "GURMUKHI"},
+    {0x0A80, 0x0AFF, "GUJARATI"},
+    {0x0B00, 0x0B7F, "ORIYA"},
+    {0x0B80, 0x0BFF, "TAMIL"},
+    {0x0C00, 0x0C7F, "TELUGU"},
+    {0x0C80, 0x0CFF, "KANNADA"},
+    {0x0D00, 0x0D7F, "MALAYALAM"},
+    {0x0D80, 0x0DFF, "SINHALA"},
+    {0x0E00, 0x0E7F, "THAI"},
+    {0x0E80, 0x0EFF, "LAO"},
+    {0x0F00, 0x0FFF, "TIBETAN"},
+    {0x1000, 0x109F, "MYANMAR"},
+    {0x10A0, 0x10FF, "GEORGIAN"},
+    {0x1100, 0x11FF, "HANGUL_JAMO"},
+    {0x1200, 0x137F, "ETHIOPIC"},
+    {0x1380, 0x139F, "ETHIOPIC_SUPPLEMENT"},
+    {0x13A0, 0x13FF, "CHEROKEE"},
+    {0x1400, 0x167F, "UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS"},
+    {0x1680, 0x169F, "OGHAM"},
+    {0x16A0, 0x16FF, "RUNIC"},
+    {0x1700, 0x171F, "TAGALOG"},
+    {0x1720, 0x173F, "HANUNOO"},
+    {0x1740, 0x175F, "BUHID"},
+    {0x1760, 0x177F, "TAGBANWA"},
+    {0x1780, 0x17FF, "KHMER"},
+    {0x1800, 0x18AF, "MONGOLIAN"},
+    {0x18B0, 0x18FF, "UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED"},
+    {0x1900, 0x194F, "LIMBU"},
+    {0x1950, 0x197F, "TAI_LE"},
+    {0x1980, 0x19DF, "NEW_TAI_LUE"},
+    {0x19E0, 0x19FF, "KHMER_SYMBOLS"},
+    {0x1A00, 0x1A1F, "BUGINESE"},
+    {0x1A20, 0x1AAF, "TAI_THAM"},
+    {0x1AB0, 0x1AFF, "COMBINING_DIACRITICAL_MARKS_EXTENDED"},
+    {0x1B00, 0x1B7F, "BALINESE"},
+    {0x1B80, 0x1BBF, "SUNDANESE"},
+    {0x1BC0, 0x1BFF, "BATAK"},
+    {0x1C00, 0x1C4F, "LEPCHA"},
+    {0x1C50, 0x1C7F, "OL_CHIKI"},
+    {0x1C80, 0x1C8F, "CYRILLIC_EXTENDED_C"},
+    {0x1C90, 0x1CBF, "GEORGIAN_EXTENDED"},
+    {0x1CC0, 0x1CCF, "SUNDANESE_SUPPLEMENT"},
+    {0x1CD0, 0x1CFF, "VEDIC_EXTENSIONS"},
+    {0x1D00, 0x1D7F, "PHONETIC_EXTENSIONS"},
+    {0x1D80, 0x1DBF, "PHONETIC_EXTENSIONS_SUPPLEMENT"},
+    {0x1DC0, 0x1DFF, "COMBINING_DIACRITICAL_MARKS_SUPPLEMENT"},
+    {0x1E00, 0x1EFF, "LATIN_EXTENDED_ADDITIONAL"},
+    {0x1F00, 0x1FFF, "GREEK_EXTENDED"},
+    {0x2000, 0x206F, "GENERAL_PUNCTUATION"},
+    {0x2070, 0x209F, "SUPERSCRIPTS_AND_SUBSCRIPTS"},
+    {0x20A0, 0x20CF, "CURRENCY_SYMBOLS"},
+    {0x20D0, 0x20FF, "COMBINING_DIACRITICAL_MARKS_FOR_SYMBOLS"},
+    {0x2100, 0x214F, "LETTERLIKE_SYMBOLS"},
+    {0x2150, 0x218F, "NUMBER_FORMS"},
+    {0x2190, 0x21FF, "ARROWS"},
+    {0x2200, 0x22FF, "MATHEMATICAL_OPERATORS"},
+    {0x2300, 0x23FF, "MISCELLANEOUS_TECHNICAL"},
+    {0x2400, 0x243F, "CONTROL_PICTURES"},
+    {0x2440, 0x245F, "OPTICAL_CHARACTER_RECOGNITION"},
+    {0x2460, 0x24FF, "ENCLOSED_ALPHANUMERICS"},
+    {0x2500, 0x257F, "BOX_DRAWING"},
+    {0x2580, 0x259F, "BLOCK_ELEMENTS"},
+    {0x25A0, 0x25FF, "GEOMETRIC_SHAPES"},
+    {0x2600, 0x26FF, "MISCELLANEOUS_SYMBOLS"},
+    {0x2700, 0x27BF, "DINGBATS"},
+    {0x27C0, 0x27EF, "MISCELLANEOUS_MATHEMATICAL_SYMBOLS_A"},
+    {0x27F0, 0x27FF, "SUPPLEMENTAL_ARROWS_A"},
+    {0x2800, 0x28FF, "BRAILLE_PATTERNS"},
+    {0x2900, 0x297F, "SUPPLEMENTAL_ARROWS_B"},
+    {0x2980, 0x29FF, "MISCELLANEOUS_MATHEMATICAL_SYMBOLS_B"},
+    {0x2A00, 0x2AFF, "SUPPLEMENTAL_MATHEMATICAL_OPERATORS"},
+    {0x2B00, 0x2BFF, "MISCELLANEOUS_SYMBOLS_AND_ARROWS"},
+    {0x2C00, 0x2C5F, "GLAGOLITIC"},
+    {0x2C60, 0x2C7F, "LATIN_EXTENDED_C"},
+    {0x2C80, 0x2CFF, "COPTIC"},
+    {0x2D00, 0x2D2F, "GEORGIAN_SUPPLEMENT"},
+    {0x2D30, 0x2D7F, "TIFINAGH"},
+    {0x2D80, 0x2DDF, "ETHIOPIC_EXTENDED"},
+    {0x2DE0, 0x2DFF, "CYRILLIC_EXTENDED_A"},
+    {0x2E00, 0x2E7F, "SUPPLEMENTAL_PUNCTUATION"},
+    {0x2E80, 0x2EFF, "CJK_RADICALS_SUPPLEMENT"},
+    {0x2F00, 0x2FDF, "KANGXI_RADICALS"},
+    {0x2FF0, 0x2FFF, "IDEOGRAPHIC_DESCRIPTION_CHARACTERS"},
+    {0x3000, 0x303F, "CJK_SYMBOLS_AND_PUNCTUATION"},
+    {0x3040, 0x309F, "HIRAGANA"},
+    {0x30A0, 0x30FF, "KATAKANA"},
+    {0x3100, 0x312F, "BOPOMOFO"},
+    {0x3130, 0x318F, "HANGUL_COMPATIBILITY_JAMO"},
+    {0x3190, 0x319F, "KANBUN"},
+    {0x31A0, 0x31BF, "BOPOMOFO_EXTENDED"},
+    {0x31C0, 0x31EF, "CJK_STROKES"},
+    {0x31F0, 0x31FF, "KATAKANA_PHONETIC_EXTENSIONS"},
+    {0x3200, 0x32FF, "ENCLOSED_CJK_LETTERS_AND_MONTHS"},
+    {0x3300, 0x33FF, "CJK_COMPATIBILITY"},
+    {0x3400, 0x4DBF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_A"},
+    {0x4DC0, 0x4DFF, "YIJING_HEXAGRAM_SYMBOLS"},
+    {0x4E00, 0x9FFF, "CJK_UNIFIED_IDEOGRAPHS"},
+    {0xA000, 0xA48F, "YI_SYLLABLES"},
+    {0xA490, 0xA4CF, "YI_RADICALS"},
+    {0xA4D0, 0xA4FF, "LISU"},
+    {0xA500, 0xA63F, "VAI"},
+    {0xA640, 0xA69F, "CYRILLIC_EXTENDED_B"},
+    {0xA6A0, 0xA6FF, "BAMUM"},
+    {0xA700, 0xA71F, "MODIFIER_TONE_LETTERS"},
+    {0xA720, 0xA7FF, "LATIN_EXTENDED_D"},
+    {0xA800, 0xA82F, "SYLOTI_NAGRI"},
+    {0xA830, 0xA83F, "COMMON_INDIC_NUMBER_FORMS"},
+    {0xA840, 0xA87F, "PHAGS_PA"},
+    {0xA880, 0xA8DF, "SAURASHTRA"},
+    {0xA8E0, 0xA8FF, "DEVANAGARI_EXTENDED"},
+    {0xA900, 0xA92F, "KAYAH_LI"},
+    {0xA930, 0xA95F, "REJANG"},
+    {0xA960, 0xA97F, "HANGUL_JAMO_EXTENDED_A"},
+    {0xA980, 0xA9DF, "JAVANESE"},
+    {0xA9E0, 0xA9FF, "MYANMAR_EXTENDED_B"},
+    {0xAA00, 0xAA5F, "CHAM"},
+    {0xAA60, 0xAA7F, "MYANMAR_EXTENDED_A"},
+    {0xAA80, 0xAADF, "TAI_VIET"},
+    {0xAAE0, 0xAAFF, "MEETEI_MAYEK_EXTENSIONS"},
+    {0xAB00, 0xAB2F, "ETHIOPIC_EXTENDED_A"},
+    {0xAB30, 0xAB6F, "LATIN_EXTENDED_E"},
+    {0xAB70, 0xABBF, "CHEROKEE_SUPPLEMENT"},
+    {0xABC0, 0xABFF, "MEETEI_MAYEK"},
+    {0xAC00, 0xD7AF, "HANGUL_SYLLABLES"},
+    {0xD7B0, 0xD7FF, "HANGUL_JAMO_EXTENDED_B"},
+    {0xD800, 0xDB7F, "HIGH_SURROGATES"},
+    {0xDB80, 0xDBFF, "HIGH_PRIVATE_USE_SURROGATES"},
+    {0xDC00, 0xDFFF, "LOW_SURROGATES"},
+    {0xE000, 0xF8FF, "PRIVATE_USE_AREA"},
+    {0xF900, 0xFAFF, "CJK_COMPATIBILITY_IDEOGRAPHS"},
+    {0xFB00, 0xFB4F, "ALPHABETIC_PRESENTATION_FORMS"},
+    {0xFB50, 0xFDFF, "ARABIC_PRESENTATION_FORMS_A"},
+    {0xFE00, 0xFE0F, "VARIATION_SELECTORS"},
+    {0xFE10, 0xFE1F, "VERTICAL_FORMS"},
+    {0xFE20, 0xFE2F, "COMBINING_HALF_MARKS"},
+    {0xFE30, 0xFE4F, "CJK_COMPATIBILITY_FORMS"},
+    {0xFE50, 0xFE6F, "SMALL_FORM_VARIANTS"},
+    {0xFE70, 0xFEFF, "ARABIC_PRESENTATION_FORMS_B"},
+    {0xFF00, 0xFFEF, "HALFWIDTH_AND_FULLWIDTH_FORMS"},
+    {0xFFF0, 0xFFFF, "SPECIALS"},
+    {0x10000, 0x1007F, "LINEAR_B_SYLLABARY"},
+    {0x10080, 0x100FF, "LINEAR_B_IDEOGRAMS"},
+    {0x10100, 0x1013F, "AEGEAN_NUMBERS"},
+    {0x10140, 0x1018F, "ANCIENT_GREEK_NUMBERS"},
+    {0x10190, 0x101CF, "ANCIENT_SYMBOLS"},
+    {0x101D0, 0x101FF, "PHAISTOS_DISC"},
+    {0x10280, 0x1029F, "LYCIAN"},
+    {0x102A0, 0x102DF, "CARIAN"},
+    {0x102E0, 0x102FF, "COPTIC_EPACT_NUMBERS"},
+    {0x10300, 0x1032F, "OLD_ITALIC"},
+    {0x10330, 0x1034F, "GOTHIC"},
+    {0x10350, 0x1037F, "OLD_PERMIC"},
+    {0x10380, 0x1039F, "UGARITIC"},
+    {0x103A0, 0x103DF, "OLD_PERSIAN"},
+    {0x10400, 0x1044F, "DESERET"},
+    {0x10450, 0x1047F, "SHAVIAN"},
+    {0x10480, 0x104AF, "OSMANYA"},
+    {0x104B0, 0x104FF, "OSAGE"},
+    {0x10500, 0x1052F, "ELBASAN"},
+    {0x10530, 0x1056F, "CAUCASIAN_ALBANIAN"},
+    {0x10570, 0x105BF, "VITHKUQI"},
+    {0x10600, 0x1077F, "LINEAR_A"},
+    {0x10780, 0x107BF, "LATIN_EXTENDED_F"},
+    {0x10800, 0x1083F, "CYPRIOT_SYLLABARY"},
+    {0x10840, 0x1085F, "IMPERIAL_ARAMAIC"},
+    {0x10860, 0x1087F, "PALMYRENE"},
+    {0x10880, 0x108AF, "NABATAEAN"},
+    {0x108E0, 0x108FF, "HATRAN"},
+    {0x10900, 0x1091F, "PHOENICIAN"},
+    {0x10920, 0x1093F, "LYDIAN"},
+    {0x10980, 0x1099F, "MEROITIC_HIEROGLYPHS"},
+    {0x109A0, 0x109FF, "MEROITIC_CURSIVE"},
+    {0x10A00, 0x10A5F, "KHAROSHTHI"},
+    {0x10A60, 0x10A7F, "OLD_SOUTH_ARABIAN"},
+    {0x10A80, 0x10A9F, "OLD_NORTH_ARABIAN"},
+    {0x10AC0, 0x10AFF, "MANICHAEAN"},
+    {0x10B00, 0x10B3F, "AVESTAN"},
+    {0x10B40, 0x10B5F, "INSCRIPTIONAL_PARTHIAN"},
+    {0x10B60, 0x10B7F, "INSCRIPTIONAL_PAHLAVI"},
+    {0x10B80, 0x10BAF, "PSALTER_PAHLAVI"},
+    {0x10C00, 0x10C4F, "OLD_TURKIC"},
+    {0x10C80, 0x10CFF, "OLD_HUNGARIAN"},
+    {0x10D00, 0x10D3F, "HANIFI_ROHINGYA"},
+    {0x10E60, 0x10E7F, "RUMI_NUMERAL_SYMBOLS"},
+    {0x10E80, 0x10EBF, "YEZIDI"},
+    {0x10F00, 0x10F2F, "OLD_SOGDIAN"},
+    {0x10F30, 0x10F6F, "SOGDIAN"},
+    {0x10F70, 0x10FAF, "OLD_UYGHUR"},
+    {0x10FB0, 0x10FDF, "CHORASMIAN"},
+    {0x10FE0, 0x10FFF, "ELYMAIC"},
+    {0x11000, 0x1107F, "BRAHMI"},
+    {0x11080, 0x110CF, "KAITHI"},
+    {0x110D0, 0x110FF, "SORA_SOMPENG"},
+    {0x11100, 0x1114F, "CHAKMA"},
+    {0x11150, 0x1117F, "MAHAJANI"},
+    {0x11180, 0x111DF, "SHARADA"},
+    {0x111E0, 0x111FF, "SINHALA_ARCHAIC_NUMBERS"},
+    {0x11200, 0x1124F, "KHOJKI"},
+    {0x11280, 0x112AF, "MULTANI"},
+    {0x112B0, 0x112FF, "KHUDAWADI"},
+    {0x11300, 0x1137F, "GRANTHA"},
+    {0x11400, 0x1147F, "NEWA"},
+    {0x11480, 0x114DF, "TIRHUTA"},
+    {0x11580, 0x115FF, "SIDDHAM"},
+    {0x11600, 0x1165F, "MODI"},
+    {0x11660, 0x1167F, "MONGOLIAN_SUPPLEMENT"},
+    {0x11680, 0x116CF, "TAKRI"},
+    {0x11700, 0x1174F, "AHOM"},
+    {0x11800, 0x1184F, "DOGRA"},
+    {0x118A0, 0x118FF, "WARANG_CITI"},
+    {0x11900, 0x1195F, "DIVES_AKURU"},
+    {0x119A0, 0x119FF, "NANDINAGARI"},
+    {0x11A00, 0x11A4F, "ZANABAZAR_SQUARE"},
+    {0x11A50, 0x11AAF, "SOYOMBO"},
+    {0x11AB0, 0x11ABF, "UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED_A"},
+    {0x11AC0, 0x11AFF, "PAU_CIN_HAU"},
+    {0x11C00, 0x11C6F, "BHAIKSUKI"},
+    {0x11C70, 0x11CBF, "MARCHEN"},
+    {0x11D00, 0x11D5F, "MASARAM_GONDI"},
+    {0x11D60, 0x11DAF, "GUNJALA_GONDI"},
+    {0x11EE0, 0x11EFF, "MAKASAR"},
+    {0x11FB0, 0x11FBF, "LISU_SUPPLEMENT"},
+    {0x11FC0, 0x11FFF, "TAMIL_SUPPLEMENT"},
+    {0x12000, 0x123FF, "CUNEIFORM"},
+    {0x12400, 0x1247F, "CUNEIFORM_NUMBERS_AND_PUNCTUATION"},
+    {0x12480, 0x1254F, "EARLY_DYNASTIC_CUNEIFORM"},
+    {0x12F90, 0x12FFF, "CYPRO_MINOAN"},
+    {0x13000, 0x1342F, "EGYPTIAN_HIEROGLYPHS"},
+    {0x13430, 0x1343F, "EGYPTIAN_HIEROGLYPH_FORMAT_CONTROLS"},
+    {0x14400, 0x1467F, "ANATOLIAN_HIEROGLYPHS"},
+    {0x16800, 0x16A3F, "BAMUM_SUPPLEMENT"},
+    {0x16A40, 0x16A6F, "MRO"},
+    {0x16A70, 0x16ACF, "TANGSA"},
+    {0x16AD0, 0x16AFF, "BASSA_VAH"},
+    {0x16B00, 0x16B8F, "PAHAWH_HMONG"},
+    {0x16E40, 0x16E9F, "MEDEFAIDRIN"},
+    {0x16F00, 0x16F9F, "MIAO"},
+    {0x16FE0, 0x16FFF, "IDEOGRAPHIC_SYMBOLS_AND_PUNCTUATION"},
+    {0x17000, 0x187FF, "TANGUT"},
+    {0x18800, 0x18AFF, "TANGUT_COMPONENTS"},
+    {0x18B00, 0x18CFF, "KHITAN_SMALL_SCRIPT"},
+    {0x18D00, 0x18D7F, "TANGUT_SUPPLEMENT"},
+    {0x1AFF0, 0x1AFFF, "KANA_EXTENDED_B"},
+    {0x1B000, 0x1B0FF, "KANA_SUPPLEMENT"},
+    {0x1B100, 0x1B12F, "KANA_EXTENDED_A"},
+    {0x1B130, 0x1B16F, "SMALL_KANA_EXTENSION"},
+    {0x1B170, 0x1B2FF, "NUSHU"},
+    {0x1BC00, 0x1BC9F, "DUPLOYAN"},
+    {0x1BCA0, 0x1BCAF, "SHORTHAND_FORMAT_CONTROLS"},
+    {0x1CF00, 0x1CFCF, "ZNAMENNY_MUSICAL_NOTATION"},
+    {0x1D000, 0x1D0FF, "BYZANTINE_MUSICAL_SYMBOLS"},
+    {0x1D100, 0x1D1FF, "MUSICAL_SYMBOLS"},
+    {0x1D200, 0x1D24F, "ANCIENT_GREEK_MUSICAL_NOTATION"},
+    {0x1D2E0, 0x1D2FF, "MAYAN_NUMERALS"},
+    {0x1D300, 0x1D35F, "TAI_XUAN_JING_SYMBOLS"},
+    {0x1D360, 0x1D37F, "COUNTING_ROD_NUMERALS"},
+    {0x1D400, 0x1D7FF, "MATHEMATICAL_ALPHANUMERIC_SYMBOLS"},
+    {0x1D800, 0x1DAAF, "SUTTON_SIGNWRITING"},
+    {0x1DF00, 0x1DFFF, "LATIN_EXTENDED_G"},
+    {0x1E000, 0x1E02F, "GLAGOLITIC_SUPPLEMENT"},
+    {0x1E100, 0x1E14F, "NYIAKENG_PUACHUE_HMONG"},
+    {0x1E290, 0x1E2BF, "TOTO"},
+    {0x1E2C0, 0x1E2FF, "WANCHO"},
+    {0x1E7E0, 0x1E7FF, "ETHIOPIC_EXTENDED_B"},
+    {0x1E800, 0x1E8DF, "MENDE_KIKAKUI"},
+    {0x1E900, 0x1E95F, "ADLAM"},
+    {0x1EC70, 0x1ECBF, "INDIC_SIYAQ_NUMBERS"},
+    {0x1ED00, 0x1ED4F, "OTTOMAN_SIYAQ_NUMBERS"},
+    {0x1EE00, 0x1EEFF, "ARABIC_MATHEMATICAL_ALPHABETIC_SYMBOLS"},
+    {0x1F000, 0x1F02F, "MAHJONG_TILES"},
+    {0x1F030, 0x1F09F, "DOMINO_TILES"},
+    {0x1F0A0, 0x1F0FF, "PLAYING_CARDS"},
+    {0x1F100, 0x1F1FF, "ENCLOSED_ALPHANUMERIC_SUPPLEMENT"},
+    {0x1F200, 0x1F2FF, "ENCLOSED_IDEOGRAPHIC_SUPPLEMENT"},
+    {0x1F300, 0x1F5FF, "MISCELLANEOUS_SYMBOLS_AND_PICTOGRAPHS"},
+    {0x1F600, 0x1F64F, "EMOTICONS"},
+    {0x1F650, 0x1F67F, "ORNAMENTAL_DINGBATS"},
+    {0x1F680, 0x1F6FF, "TRANSPORT_AND_MAP_SYMBOLS"},
+    {0x1F700, 0x1F77F, "ALCHEMICAL_SYMBOLS"},
+    {0x1F780, 0x1F7FF, "GEOMETRIC_SHAPES_EXTENDED"},
+    {0x1F800, 0x1F8FF, "SUPPLEMENTAL_ARROWS_C"},
+    {0x1F900, 0x1F9FF, "SUPPLEMENTAL_SYMBOLS_AND_PICTOGRAPHS"},
+    {0x1FA00, 0x1FA6F, "CHESS_SYMBOLS"},
+    {0x1FA70, 0x1FAFF, "SYMBOLS_AND_PICTOGRAPHS_EXTENDED_A"},
+    {0x1FB00, 0x1FBFF, "SYMBOLS_FOR_LEGACY_COMPUTING"},
+    {0x20000, 0x2A6DF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_B"},
+    {0x2A700, 0x2B73F, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_C"},
+    {0x2B740, 0x2B81F, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_D"},
+    {0x2B820, 0x2CEAF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_E"},
+    {0x2CEB0, 0x2EBEF, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_F"},
+    {0x2F800, 0x2FA1F, "CJK_COMPATIBILITY_IDEOGRAPHS_SUPPLEMENT"},
+    {0x30000, 0x3134F, "CJK_UNIFIED_IDEOGRAPHS_EXTENSION_G"},
+    {0xE0000, 0xE007F, "TAGS"},
+    {0xE0100, 0xE01EF, "VARIATION_SELECTORS_SUPPLEMENT"},
+    {0xF0000, 0xFFFFF, "SUPPLEMENTARY_PRIVATE_USE_AREA_A"},
+    {0x100000, 0x10FFFF, "SUPPLEMENTARY_PRIVATE_USE_AREA_B"},
+};
+
+
+const Unicode::Block& Unicode::BASIC_LATIN = BLOCK_TABLE[0];
+const Unicode::Block& Unicode::LATIN_1_SUPPLEMENT = BLOCK_TABLE[1];
+const Unicode::Block& Unicode::LATIN_EXTENDED_A = BLOCK_TABLE[2];
+const Unicode::Block& Unicode::LATIN_EXTENDED_B = BLOCK_TABLE[3];
+const Unicode::Block& Unicode::IPA_EXTENSIONS = BLOCK_TABLE[4];
+const Unicode::Block& Unicode::SPACING_MODIFIER_LETTERS = BLOCK_TABLE[5];
+const Unicode::Block& Unicode::COMBINING_DIACRITICAL_MARKS = BLOCK_TABLE[6];
+const Unicode::Block& Unicode::GREEK_AND_COPTIC = BLOCK_TABLE[7];
+const Unicode::Block& Unicode::CYRILLIC = BLOCK_TABLE[8];
+const Unicode::Block& Unicode::CYRILLIC_SUPPLEMENT = BLOCK_TABLE[9];
+const Unicode::Block& Unicode::ARMENIAN = BLOCK_TABLE[10];
+const Unicode::Block& Unicode::HEBREW = BLOCK_TABLE[11];
+const Unicode::Block& Unicode::ARABIC = BLOCK_TABLE[12];
+const Unicode::Block& Unicode::SYRIAC = BLOCK_TABLE[13];
+const Unicode::Block& Unicode::ARABIC_SUPPLEMENT = BLOCK_TABLE[14];
+const Unicode::Block& Unicode::THAANA = BLOCK_TABLE[15];
+const Unicode::Block& Unicode::NKO = BLOCK_TABLE[16];
+const Unicode::Block& Unicode::SAMARITAN = BLOCK_TABLE[17];
+const Unicode::Block& Unicode::MANDAIC = BLOCK_TABLE[18];
+const Unicode::Block& Unicode::SYRIAC_SUPPLEMENT = BLOCK_TABLE[19];
+const Unicode::Block& Unicode::ARABIC_EXTENDED_B = BLOCK_TABLE[20];
+const Unicode::Block& Unicode::ARABIC_EXTENDED_A = BLOCK_TABLE[21];
+const Unicode::Block& Unicode::DEVANAGARI = BLOCK_TABLE[22];
+const Unicode::Block& Unicode::BENGALI = BLOCK_TABLE[23];
+const Unicode::Block& Unicode::GURMUKHI = BLOCK_TABLE[24];
+const Unicode::Block& Unicode::GUJARATI = BLOCK_TABLE[25];
+const Unicode::Block& Unicode::ORIYA = BLOCK_TABLE[26];
+const Unicode::Block& Unicode::TAMIL = BLOCK_TABLE[27];
+const Unicode::Block& Unicode::TELUGU = BLOCK_TABLE[28];
+const Unicode::Block& Unicode::KANNADA = BLOCK_TABLE[29];
+const Unicode::Block& Unicode::MALAYALAM = BLOCK_TABLE[30];
+const Unicode::Block& Unicode::SINHALA = BLOCK_TABLE[31];
+const Unicode::Block& Unicode::THAI = BLOCK_TABLE[32];
+const Unicode::Block& Unicode::LAO = BLOCK_TABLE[33];
+const Unicode::Block& Unicode::TIBETAN = BLOCK_TABLE[34];
+const Unicode::Block& Unicode::MYANMAR = BLOCK_TABLE[35];
+const Unicode::Block& Unicode::GEORGIAN = BLOCK_TABLE[36];
+const Unicode::Block& Unicode::HANGUL_JAMO = BLOCK_TABLE[37];
+const Unicode::Block& Unicode::ETHIOPIC = BLOCK_TABLE[38];
+const Unicode::Block& Unicode::ETHIOPIC_SUPPLEMENT = BLOCK_TABLE[39];
+const Unicode::Block& Unicode::CHEROKEE = BLOCK_TABLE[40];
+const Unicode::Block& Unicode::UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS = BLOCK_TABLE[41];
+const Unicode::Block& Unicode::OGHAM = BLOCK_TABLE[42];
+const Unicode::Block& Unicode::RUNIC = BLOCK_TABLE[43];
+const Unicode::Block& Unicode::TAGALOG = BLOCK_TABLE[44];
+const Unicode::Block& Unicode::HANUNOO = BLOCK_TABLE[45];
+const Unicode::Block& Unicode::BUHID = BLOCK_TABLE[46];
+const Unicode::Block& Unicode::TAGBANWA = BLOCK_TABLE[47];
+const Unicode::Block& Unicode::KHMER = BLOCK_TABLE[48];
+const Unicode::Block& Unicode::MONGOLIAN = BLOCK_TABLE[49];
+const Unicode::Block& Unicode::UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED = BLOCK_TABLE[50];
+const Unicode::Block& Unicode::LIMBU = BLOCK_TABLE[51];
+const Unicode::Block& Unicode::TAI_LE = BLOCK_TABLE[52];
+const Unicode::Block& Unicode::NEW_TAI_LUE = BLOCK_TABLE[53];
+const Unicode::Block& Unicode::KHMER_SYMBOLS = BLOCK_TABLE[54];
+const Unicode::Block& Unicode::BUGINESE = BLOCK_TABLE[55];
+const Unicode::Block& Unicode::TAI_THAM = BLOCK_TABLE[56];
+const Unicode::Block& Unicode::COMBINING_DIACRITICAL_MARKS_EXTENDED = BLOCK_TABLE[57];
+const Unicode::Block& Unicode::BALINESE = BLOCK_TABLE[58];
+const Unicode::Block& Unicode::SUNDANESE = BLOCK_TABLE[59];
+const Unicode::Block& Unicode::BATAK = BLOCK_TABLE[60];
+const Unicode::Block& Unicode::LEPCHA = BLOCK_TABLE[61];
+const Unicode::Block& Unicode::OL_CHIKI = BLOCK_TABLE[62];
+const Unicode::Block& Unicode::CYRILLIC_EXTENDED_C = BLOCK_TABLE[63];
+const Unicode::Block& Unicode::GEORGIAN_EXTENDED = BLOCK_TABLE[64];
+const Unicode::Block& Unicode::SUNDANESE_SUPPLEMENT = BLOCK_TABLE[65];
+const Unicode::Block& Unicode::VEDIC_EXTENSIONS = BLOCK_TABLE[66];
+const Unicode::Block& Unicode::PHONETIC_EXTENSIONS = BLOCK_TABLE[67];
+const Unicode::Block& Unicode::PHONETIC_EXTENSIONS_SUPPLEMENT = BLOCK_TABLE[68];
+const Unicode::Block& Unicode::COMBINING_DIACRITICAL_MARKS_SUPPLEMENT = BLOCK_TABLE[69];
+const Unicode::Block& Unicode::LATIN_EXTENDED_ADDITIONAL = BLOCK_TABLE[70];
+const Unicode::Block& Unicode::GREEK_EXTENDED = BLOCK_TABLE[71];
+const Unicode::Block& Unicode::GENERAL_PUNCTUATION = BLOCK_TABLE[72];
+const Unicode::Block& Unicode::SUPERSCRIPTS_AND_SUBSCRIPTS = BLOCK_TABLE[73];
+const Unicode::Block& Unicode::CURRENCY_SYMBOLS = BLOCK_TABLE[74];
+const Unicode::Block& Unicode::COMBINING_DIACRITICAL_MARKS_FOR_SYMBOLS = BLOCK_TABLE[75];
+const Unicode::Block& Unicode::LETTERLIKE_SYMBOLS = BLOCK_TABLE[76];
+const Unicode::Block& Unicode::NUMBER_FORMS = BLOCK_TABLE[77];
+const Unicode::Block& Unicode::ARROWS = BLOCK_TABLE[78];
+const Unicode::Block& Unicode::MATHEMATICAL_OPERATORS = BLOCK_TABLE[79];
+const Unicode::Block& Unicode::MISCELLANEOUS_TECHNICAL = BLOCK_TABLE[80];
+const Unicode::Block& Unicode::CONTROL_PICTURES = BLOCK_TABLE[81];
+const Unicode::Block& Unicode::OPTICAL_CHARACTER_RECOGNITION = BLOCK_TABLE[82];
+const Unicode::Block& Unicode::ENCLOSED_ALPHANUMERICS = BLOCK_TABLE[83];
+const Unicode::Block& Unicode::BOX_DRAWING = BLOCK_TABLE[84];
+const Unicode::Block& Unicode::BLOCK_ELEMENTS = BLOCK_TABLE[85];
+const Unicode::Block& Unicode::GEOMETRIC_SHAPES = BLOCK_TABLE[86];
+const Unicode::Block& Unicode::MISCELLANEOUS_SYMBOLS = BLOCK_TABLE[87];
+const Unicode::Block& Unicode::DINGBATS = BLOCK_TABLE[88];
+const Unicode::Block& Unicode::MISCELLANEOUS_MATHEMATICAL_SYMBOLS_A = BLOCK_TABLE[89];
+const Unicode::Block& Unicode::SUPPLEMENTAL_ARROWS_A = BLOCK_TABLE[90];
+const Unicode::Block& Unicode::BRAILLE_PATTERNS = BLOCK_TABLE[91];
+const Unicode::Block& Unicode::SUPPLEMENTAL_ARROWS_B = BLOCK_TABLE[92];
+const Unicode::Block& Unicode::MISCELLANEOUS_MATHEMATICAL_SYMBOLS_B = BLOCK_TABLE[93];
+const Unicode::Block& Unicode::SUPPLEMENTAL_MATHEMATICAL_OPERATORS = BLOCK_TABLE[94];
+const Unicode::Block& Unicode::MISCELLANEOUS_SYMBOLS_AND_ARROWS = BLOCK_TABLE[95];
+const Unicode::Block& Unicode::GLAGOLITIC = BLOCK_TABLE[96];
+const Unicode::Block& Unicode::LATIN_EXTENDED_C = BLOCK_TABLE[97];
+const Unicode::Block& Unicode::COPTIC = BLOCK_TABLE[98];
+const Unicode::Block& Unicode::GEORGIAN_SUPPLEMENT = BLOCK_TABLE[99];
+const Unicode::Block& Unicode::TIFINAGH = BLOCK_TABLE[100];
+const Unicode::Block& Unicode::ETHIOPIC_EXTENDED = BLOCK_TABLE[101];
+const Unicode::Block& Unicode::CYRILLIC_EXTENDED_A = BLOCK_TABLE[102];
+const Unicode::Block& Unicode::SUPPLEMENTAL_PUNCTUATION = BLOCK_TABLE[103];
+const Unicode::Block& Unicode::CJK_RADICALS_SUPPLEMENT = BLOCK_TABLE[104];
+const Unicode::Block& Unicode::KANGXI_RADICALS = BLOCK_TABLE[105];
+const Unicode::Block& Unicode::IDEOGRAPHIC_DESCRIPTION_CHARACTERS = BLOCK_TABLE[106];
+const Unicode::Block& Unicode::CJK_SYMBOLS_AND_PUNCTUATION = BLOCK_TABLE[107];
+const Unicode::Block& Unicode::HIRAGANA = BLOCK_TABLE[108];
+const Unicode::Block& Unicode::KATAKANA = BLOCK_TABLE[109];
+const Unicode::Block& Unicode::BOPOMOFO = BLOCK_TABLE[110];
+const Unicode::Block& Unicode::HANGUL_COMPATIBILITY_JAMO = BLOCK_TABLE[111];
+const Unicode::Block& Unicode::KANBUN = BLOCK_TABLE[112];
+const Unicode::Block& Unicode::BOPOMOFO_EXTENDED = BLOCK_TABLE[113];
+const Unicode::Block& Unicode::CJK_STROKES = BLOCK_TABLE[114];
+const Unicode::Block& Unicode::KATAKANA_PHONETIC_EXTENSIONS = BLOCK_TABLE[115];
+const Unicode::Block& Unicode::ENCLOSED_CJK_LETTERS_AND_MONTHS = BLOCK_TABLE[116];
+const Unicode::Block& Unicode::CJK_COMPATIBILITY = BLOCK_TABLE[117];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_A = BLOCK_TABLE[118];
+const Unicode::Block& Unicode::YIJING_HEXAGRAM_SYMBOLS = BLOCK_TABLE[119];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS = BLOCK_TABLE[120];
+const Unicode::Block& Unicode::YI_SYLLABLES = BLOCK_TABLE[121];
+const Unicode::Block& Unicode::YI_RADICALS = BLOCK_TABLE[122];
+const Unicode::Block& Unicode::LISU = BLOCK_TABLE[123];
+const Unicode::Block& Unicode::VAI = BLOCK_TABLE[124];
+const Unicode::Block& Unicode::CYRILLIC_EXTENDED_B = BLOCK_TABLE[125];
+const Unicode::Block& Unicode::BAMUM = BLOCK_TABLE[126];
+const Unicode::Block& Unicode::MODIFIER_TONE_LETTERS = BLOCK_TABLE[127];
+const Unicode::Block& Unicode::LATIN_EXTENDED_D = BLOCK_TABLE[128];
+const Unicode::Block& Unicode::SYLOTI_NAGRI = BLOCK_TABLE[129];
+const Unicode::Block& Unicode::COMMON_INDIC_NUMBER_FORMS = BLOCK_TABLE[130];
+const Unicode::Block& Unicode::PHAGS_PA = BLOCK_TABLE[131];
+const Unicode::Block& Unicode::SAURASHTRA = BLOCK_TABLE[132];
+const Unicode::Block& Unicode::DEVANAGARI_EXTENDED = BLOCK_TABLE[133];
+const Unicode::Block& Unicode::KAYAH_LI = BLOCK_TABLE[134];
+const Unicode::Block& Unicode::REJANG = BLOCK_TABLE[135];
+const Unicode::Block& Unicode::HANGUL_JAMO_EXTENDED_A = BLOCK_TABLE[136];
+const Unicode::Block& Unicode::JAVANESE = BLOCK_TABLE[137];
+const Unicode::Block& Unicode::MYANMAR_EXTENDED_B = BLOCK_TABLE[138];
+const Unicode::Block& Unicode::CHAM = BLOCK_TABLE[139];
+const Unicode::Block& Unicode::MYANMAR_EXTENDED_A = BLOCK_TABLE[140];
+const Unicode::Block& Unicode::TAI_VIET = BLOCK_TABLE[141];
+const Unicode::Block& Unicode::MEETEI_MAYEK_EXTENSIONS = BLOCK_TABLE[142];
+const Unicode::Block& Unicode::ETHIOPIC_EXTENDED_A = BLOCK_TABLE[143];
+const Unicode::Block& Unicode::LATIN_EXTENDED_E = BLOCK_TABLE[144];
+const Unicode::Block& Unicode::CHEROKEE_SUPPLEMENT = BLOCK_TABLE[145];
+const Unicode::Block& Unicode::MEETEI_MAYEK = BLOCK_TABLE[146];
+const Unicode::Block& Unicode::HANGUL_SYLLABLES = BLOCK_TABLE[147];
+const Unicode::Block& Unicode::HANGUL_JAMO_EXTENDED_B = BLOCK_TABLE[148];
+const Unicode::Block& Unicode::HIGH_SURROGATES = BLOCK_TABLE[149];
+const Unicode::Block& Unicode::HIGH_PRIVATE_USE_SURROGATES = BLOCK_TABLE[150];
+const Unicode::Block& Unicode::LOW_SURROGATES = BLOCK_TABLE[151];
+const Unicode::Block& Unicode::PRIVATE_USE_AREA = BLOCK_TABLE[152];
+const Unicode::Block& Unicode::CJK_COMPATIBILITY_IDEOGRAPHS = BLOCK_TABLE[153];
+const Unicode::Block& Unicode::ALPHABETIC_PRESENTATION_FORMS = BLOCK_TABLE[154];
+const Unicode::Block& Unicode::ARABIC_PRESENTATION_FORMS_A = BLOCK_TABLE[155];
+const Unicode::Block& Unicode::VARIATION_SELECTORS = BLOCK_TABLE[156];
+const Unicode::Block& Unicode::VERTICAL_FORMS = BLOCK_TABLE[157];
+const Unicode::Block& Unicode::COMBINING_HALF_MARKS = BLOCK_TABLE[158];
+const Unicode::Block& Unicode::CJK_COMPATIBILITY_FORMS = BLOCK_TABLE[159];
+const Unicode::Block& Unicode::SMALL_FORM_VARIANTS = BLOCK_TABLE[160];
+const Unicode::Block& Unicode::ARABIC_PRESENTATION_FORMS_B = BLOCK_TABLE[161];
+const Unicode::Block& Unicode::HALFWIDTH_AND_FULLWIDTH_FORMS = BLOCK_TABLE[162];
+const Unicode::Block& Unicode::SPECIALS = BLOCK_TABLE[163];
+const Unicode::Block& Unicode::LINEAR_B_SYLLABARY = BLOCK_TABLE[164];
+const Unicode::Block& Unicode::LINEAR_B_IDEOGRAMS = BLOCK_TABLE[165];
+const Unicode::Block& Unicode::AEGEAN_NUMBERS = BLOCK_TABLE[166];
+const Unicode::Block& Unicode::ANCIENT_GREEK_NUMBERS = BLOCK_TABLE[167];
+const Unicode::Block& Unicode::ANCIENT_SYMBOLS = BLOCK_TABLE[168];
+const Unicode::Block& Unicode::PHAISTOS_DISC = BLOCK_TABLE[169];
+const Unicode::Block& Unicode::LYCIAN = BLOCK_TABLE[170];
+const Unicode::Block& Unicode::CARIAN = BLOCK_TABLE[171];
+const Unicode::Block& Unicode::COPTIC_EPACT_NUMBERS = BLOCK_TABLE[172];
+const Unicode::Block& Unicode::OLD_ITALIC = BLOCK_TABLE[173];
+const Unicode::Block& Unicode::GOTHIC = BLOCK_TABLE[174];
+const Unicode::Block& Unicode::OLD_PERMIC = BLOCK_TABLE[175];
+const Unicode::Block& Unicode::UGARITIC = BLOCK_TABLE[176];
+const Unicode::Block& Unicode::OLD_PERSIAN = BLOCK_TABLE[177];
+const Unicode::Block& Unicode::DESERET = BLOCK_TABLE[178];
+const Unicode::Block& Unicode::SHAVIAN = BLOCK_TABLE[179];
+const Unicode::Block& Unicode::OSMANYA = BLOCK_TABLE[180];
+const Unicode::Block& Unicode::OSAGE = BLOCK_TABLE[181];
+const Unicode::Block& Unicode::ELBASAN = BLOCK_TABLE[182];
+const Unicode::Block& Unicode::CAUCASIAN_ALBANIAN = BLOCK_TABLE[183];
+const Unicode::Block& Unicode::VITHKUQI = BLOCK_TABLE[184];
+const Unicode::Block& Unicode::LINEAR_A = BLOCK_TABLE[185];
+const Unicode::Block& Unicode::LATIN_EXTENDED_F = BLOCK_TABLE[186];
+const Unicode::Block& Unicode::CYPRIOT_SYLLABARY = BLOCK_TABLE[187];
+const Unicode::Block& Unicode::IMPERIAL_ARAMAIC = BLOCK_TABLE[188];
+const Unicode::Block& Unicode::PALMYRENE = BLOCK_TABLE[189];
+const Unicode::Block& Unicode::NABATAEAN = BLOCK_TABLE[190];
+const Unicode::Block& Unicode::HATRAN = BLOCK_TABLE[191];
+const Unicode::Block& Unicode::PHOENICIAN = BLOCK_TABLE[192];
+const Unicode::Block& Unicode::LYDIAN = BLOCK_TABLE[193];
+const Unicode::Block& Unicode::MEROITIC_HIEROGLYPHS = BLOCK_TABLE[194];
+const Unicode::Block& Unicode::MEROITIC_CURSIVE = BLOCK_TABLE[195];
+const Unicode::Block& Unicode::KHAROSHTHI = BLOCK_TABLE[196];
+const Unicode::Block& Unicode::OLD_SOUTH_ARABIAN = BLOCK_TABLE[197];
+const Unicode::Block& Unicode::OLD_NORTH_ARABIAN = BLOCK_TABLE[198];
+const Unicode::Block& Unicode::MANICHAEAN = BLOCK_TABLE[199];
+const Unicode::Block& Unicode::AVESTAN = BLOCK_TABLE[200];
+const Unicode::Block& Unicode::INSCRIPTIONAL_PARTHIAN = BLOCK_TABLE[201];
+const Unicode::Block& Unicode::INSCRIPTIONAL_PAHLAVI = BLOCK_TABLE[202];
+const Unicode::Block& Unicode::PSALTER_PAHLAVI = BLOCK_TABLE[203];
+const Unicode::Block& Unicode::OLD_TURKIC = BLOCK_TABLE[204];
+const Unicode::Block& Unicode::OLD_HUNGARIAN = BLOCK_TABLE[205];
+const Unicode::Block& Unicode::HANIFI_ROHINGYA = BLOCK_TABLE[206];
+const Unicode::Block& Unicode::RUMI_NUMERAL_SYMBOLS = BLOCK_TABLE[207];
+const Unicode::Block& Unicode::YEZIDI = BLOCK_TABLE[208];
+const Unicode::Block& Unicode::OLD_SOGDIAN = BLOCK_TABLE[209];
+const Unicode::Block& Unicode::SOGDIAN = BLOCK_TABLE[210];
+const Unicode::Block& Unicode::OLD_UYGHUR = BLOCK_TABLE[211];
+const Unicode::Block& Unicode::CHORASMIAN = BLOCK_TABLE[212];
+const Unicode::Block& Unicode::ELYMAIC = BLOCK_TABLE[213];
+const Unicode::Block& Unicode::BRAHMI = BLOCK_TABLE[214];
+const Unicode::Block& Unicode::KAITHI = BLOCK_TABLE[215];
+const Unicode::Block& Unicode::SORA_SOMPENG = BLOCK_TABLE[216];
+const Unicode::Block& Unicode::CHAKMA = BLOCK_TABLE[217];
+const Unicode::Block& Unicode::MAHAJANI = BLOCK_TABLE[218];
+const Unicode::Block& Unicode::SHARADA = BLOCK_TABLE[219];
+const Unicode::Block& Unicode::SINHALA_ARCHAIC_NUMBERS = BLOCK_TABLE[220];
+const Unicode::Block& Unicode::KHOJKI = BLOCK_TABLE[221];
+const Unicode::Block& Unicode::MULTANI = BLOCK_TABLE[222];
+const Unicode::Block& Unicode::KHUDAWADI = BLOCK_TABLE[223];
+const Unicode::Block& Unicode::GRANTHA = BLOCK_TABLE[224];
+const Unicode::Block& Unicode::NEWA = BLOCK_TABLE[225];
+const Unicode::Block& Unicode::TIRHUTA = BLOCK_TABLE[226];
+const Unicode::Block& Unicode::SIDDHAM = BLOCK_TABLE[227];
+const Unicode::Block& Unicode::MODI = BLOCK_TABLE[228];
+const Unicode::Block& Unicode::MONGOLIAN_SUPPLEMENT = BLOCK_TABLE[229];
+const Unicode::Block& Unicode::TAKRI = BLOCK_TABLE[230];
+const Unicode::Block& Unicode::AHOM = BLOCK_TABLE[231];
+const Unicode::Block& Unicode::DOGRA = BLOCK_TABLE[232];
+const Unicode::Block& Unicode::WARANG_CITI = BLOCK_TABLE[233];
+const Unicode::Block& Unicode::DIVES_AKURU = BLOCK_TABLE[234];
+const Unicode::Block& Unicode::NANDINAGARI = BLOCK_TABLE[235];
+const Unicode::Block& Unicode::ZANABAZAR_SQUARE = BLOCK_TABLE[236];
+const Unicode::Block& Unicode::SOYOMBO = BLOCK_TABLE[237];
+const Unicode::Block& Unicode::UNIFIED_CANADIAN_ABORIGINAL_SYLLABICS_EXTENDED_A = BLOCK_TABLE[238];
+const Unicode::Block& Unicode::PAU_CIN_HAU = BLOCK_TABLE[239];
+const Unicode::Block& Unicode::BHAIKSUKI = BLOCK_TABLE[240];
+const Unicode::Block& Unicode::MARCHEN = BLOCK_TABLE[241];
+const Unicode::Block& Unicode::MASARAM_GONDI = BLOCK_TABLE[242];
+const Unicode::Block& Unicode::GUNJALA_GONDI = BLOCK_TABLE[243];
+const Unicode::Block& Unicode::MAKASAR = BLOCK_TABLE[244];
+const Unicode::Block& Unicode::LISU_SUPPLEMENT = BLOCK_TABLE[245];
+const Unicode::Block& Unicode::TAMIL_SUPPLEMENT = BLOCK_TABLE[246];
+const Unicode::Block& Unicode::CUNEIFORM = BLOCK_TABLE[247];
+const Unicode::Block& Unicode::CUNEIFORM_NUMBERS_AND_PUNCTUATION = BLOCK_TABLE[248];
+const Unicode::Block& Unicode::EARLY_DYNASTIC_CUNEIFORM = BLOCK_TABLE[249];
+const Unicode::Block& Unicode::CYPRO_MINOAN = BLOCK_TABLE[250];
+const Unicode::Block& Unicode::EGYPTIAN_HIEROGLYPHS = BLOCK_TABLE[251];
+const Unicode::Block& Unicode::EGYPTIAN_HIEROGLYPH_FORMAT_CONTROLS = BLOCK_TABLE[252];
+const Unicode::Block& Unicode::ANATOLIAN_HIEROGLYPHS = BLOCK_TABLE[253];
+const Unicode::Block& Unicode::BAMUM_SUPPLEMENT = BLOCK_TABLE[254];
+const Unicode::Block& Unicode::MRO = BLOCK_TABLE[255];
+const Unicode::Block& Unicode::TANGSA = BLOCK_TABLE[256];
+const Unicode::Block& Unicode::BASSA_VAH = BLOCK_TABLE[257];
+const Unicode::Block& Unicode::PAHAWH_HMONG = BLOCK_TABLE[258];
+const Unicode::Block& Unicode::MEDEFAIDRIN = BLOCK_TABLE[259];
+const Unicode::Block& Unicode::MIAO = BLOCK_TABLE[260];
+const Unicode::Block& Unicode::IDEOGRAPHIC_SYMBOLS_AND_PUNCTUATION = BLOCK_TABLE[261];
+const Unicode::Block& Unicode::TANGUT = BLOCK_TABLE[262];
+const Unicode::Block& Unicode::TANGUT_COMPONENTS = BLOCK_TABLE[263];
+const Unicode::Block& Unicode::KHITAN_SMALL_SCRIPT = BLOCK_TABLE[264];
+const Unicode::Block& Unicode::TANGUT_SUPPLEMENT = BLOCK_TABLE[265];
+const Unicode::Block& Unicode::KANA_EXTENDED_B = BLOCK_TABLE[266];
+const Unicode::Block& Unicode::KANA_SUPPLEMENT = BLOCK_TABLE[267];
+const Unicode::Block& Unicode::KANA_EXTENDED_A = BLOCK_TABLE[268];
+const Unicode::Block& Unicode::SMALL_KANA_EXTENSION = BLOCK_TABLE[269];
+const Unicode::Block& Unicode::NUSHU = BLOCK_TABLE[270];
+const Unicode::Block& Unicode::DUPLOYAN = BLOCK_TABLE[271];
+const Unicode::Block& Unicode::SHORTHAND_FORMAT_CONTROLS = BLOCK_TABLE[272];
+const Unicode::Block& Unicode::ZNAMENNY_MUSICAL_NOTATION = BLOCK_TABLE[273];
+const Unicode::Block& Unicode::BYZANTINE_MUSICAL_SYMBOLS = BLOCK_TABLE[274];
+const Unicode::Block& Unicode::MUSICAL_SYMBOLS = BLOCK_TABLE[275];
+const Unicode::Block& Unicode::ANCIENT_GREEK_MUSICAL_NOTATION = BLOCK_TABLE[276];
+const Unicode::Block& Unicode::MAYAN_NUMERALS = BLOCK_TABLE[277];
+const Unicode::Block& Unicode::TAI_XUAN_JING_SYMBOLS = BLOCK_TABLE[278];
+const Unicode::Block& Unicode::COUNTING_ROD_NUMERALS = BLOCK_TABLE[279];
+const Unicode::Block& Unicode::MATHEMATICAL_ALPHANUMERIC_SYMBOLS = BLOCK_TABLE[280];
+const Unicode::Block& Unicode::SUTTON_SIGNWRITING = BLOCK_TABLE[281];
+const Unicode::Block& Unicode::LATIN_EXTENDED_G = BLOCK_TABLE[282];
+const Unicode::Block& Unicode::GLAGOLITIC_SUPPLEMENT = BLOCK_TABLE[283];
+const Unicode::Block& Unicode::NYIAKENG_PUACHUE_HMONG = BLOCK_TABLE[284];
+const Unicode::Block& Unicode::TOTO = BLOCK_TABLE[285];
+const Unicode::Block& Unicode::WANCHO = BLOCK_TABLE[286];
+const Unicode::Block& Unicode::ETHIOPIC_EXTENDED_B = BLOCK_TABLE[287];
+const Unicode::Block& Unicode::MENDE_KIKAKUI = BLOCK_TABLE[288];
+const Unicode::Block& Unicode::ADLAM = BLOCK_TABLE[289];
+const Unicode::Block& Unicode::INDIC_SIYAQ_NUMBERS = BLOCK_TABLE[290];
+const Unicode::Block& Unicode::OTTOMAN_SIYAQ_NUMBERS = BLOCK_TABLE[291];
+const Unicode::Block& Unicode::ARABIC_MATHEMATICAL_ALPHABETIC_SYMBOLS = BLOCK_TABLE[292];
+const Unicode::Block& Unicode::MAHJONG_TILES = BLOCK_TABLE[293];
+const Unicode::Block& Unicode::DOMINO_TILES = BLOCK_TABLE[294];
+const Unicode::Block& Unicode::PLAYING_CARDS = BLOCK_TABLE[295];
+const Unicode::Block& Unicode::ENCLOSED_ALPHANUMERIC_SUPPLEMENT = BLOCK_TABLE[296];
+const Unicode::Block& Unicode::ENCLOSED_IDEOGRAPHIC_SUPPLEMENT = BLOCK_TABLE[297];
+const Unicode::Block& Unicode::MISCELLANEOUS_SYMBOLS_AND_PICTOGRAPHS = BLOCK_TABLE[298];
+const Unicode::Block& Unicode::EMOTICONS = BLOCK_TABLE[299];
+const Unicode::Block& Unicode::ORNAMENTAL_DINGBATS = BLOCK_TABLE[300];
+const Unicode::Block& Unicode::TRANSPORT_AND_MAP_SYMBOLS = BLOCK_TABLE[301];
+const Unicode::Block& Unicode::ALCHEMICAL_SYMBOLS = BLOCK_TABLE[302];
+const Unicode::Block& Unicode::GEOMETRIC_SHAPES_EXTENDED = BLOCK_TABLE[303];
+const Unicode::Block& Unicode::SUPPLEMENTAL_ARROWS_C = BLOCK_TABLE[304];
+const Unicode::Block& Unicode::SUPPLEMENTAL_SYMBOLS_AND_PICTOGRAPHS = BLOCK_TABLE[305];
+const Unicode::Block& Unicode::CHESS_SYMBOLS = BLOCK_TABLE[306];
+const Unicode::Block& Unicode::SYMBOLS_AND_PICTOGRAPHS_EXTENDED_A = BLOCK_TABLE[307];
+const Unicode::Block& Unicode::SYMBOLS_FOR_LEGACY_COMPUTING = BLOCK_TABLE[308];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_B = BLOCK_TABLE[309];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_C = BLOCK_TABLE[310];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_D = BLOCK_TABLE[311];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_E = BLOCK_TABLE[312];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_F = BLOCK_TABLE[313];
+const Unicode::Block& Unicode::CJK_COMPATIBILITY_IDEOGRAPHS_SUPPLEMENT = BLOCK_TABLE[314];
+const Unicode::Block& Unicode::CJK_UNIFIED_IDEOGRAPHS_EXTENSION_G = BLOCK_TABLE[315];
+const Unicode::Block& Unicode::TAGS = BLOCK_TABLE[316];
+const Unicode::Block& Unicode::VARIATION_SELECTORS_SUPPLEMENT = BLOCK_TABLE[317];
+const Unicode::Block& Unicode::SUPPLEMENTARY_PRIVATE_USE_AREA_A = BLOCK_TABLE[318];
+const Unicode::Block& Unicode::SUPPLEMENTARY_PRIVATE_USE_AREA_B = BLOCK_TABLE[319];
+// END GENERATED UNICODE BLOCKS
+
+
+namespace {
+
+
+const std::size_t BLOCK_TABLE_SIZE = sizeof(BLOCK_TABLE) / sizeof(BLOCK_TABLE[0]);
+
+
+/// \brief True if the character is ignored when comparing Block names.
+inline bool isIgnoredInBlockName(char c)
 {
-    return findBreaks(text, _language);
+    return c == ' ' || c == '\t' || c == '-' || c == '_';
 }
 
 
-std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(const std::u16string& text) const
+/// \brief Lowercase an ASCII character.
+inline char toLowerASCII(char c)
 {
-    return findBreaks(text, _language);
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
 }
 
 
-std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(const std::u32string& text) const
+/// \brief Hash a Block name as if it were canonicalized.
+///
+/// This is a seeded FNV-1a hash over the lowercased name with ignored
+/// characters removed.
+uint64_t hashBlockName(std::string_view name, uint64_t seed)
 {
-    return findBreaks(text, _language);
+    uint64_t hash = 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+
+    for (char c: name)
+    {
+        if (!isIgnoredInBlockName(c))
+        {
+            hash ^= static_cast<unsigned char>(toLowerASCII(c));
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    // Final avalanche so that low bits depend on the whole name.
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
 }
 
 
-std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(const std::string& text,
-                                                            const std::string& language)
+/// \brief Compare two Block names as if they were canonicalized.
+bool blockNamesEqual(std::string_view name0, std::string_view name1)
 {
-    std::vector<Linebreaker::BreakType> breaks(text.size());
+    auto i0 = name0.begin();
+    auto i1 = name1.begin();
 
-    set_linebreaks_utf8(reinterpret_cast<const utf8_t*>(text.data()),
-                        text.size(),
-                        language.data(),
-                        reinterpret_cast<char*>(breaks.data()));
+    while (true)
+    {
+        while (i0 != name0.end() && isIgnoredInBlockName(*i0)) ++i0;
+        while (i1 != name1.end() && isIgnoredInBlockName(*i1)) ++i1;
 
-    return breaks;
+        if (i0 == name0.end() || i1 == name1.end())
+            return i0 == name0.end() && i1 == name1.end();
+
+        if (toLowerASCII(*i0++) != toLowerASCII(*i1++))
+            return false;
+    }
 }
 
 
-std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(const std::u16string& text,
-                                                            const std::string& language)
+/// \brief A minimal perfect hash over the canonicalized Block names.
+///
+/// This uses the "hash and displace" construction. Each name is first
+/// assigned to a bucket. Buckets are then placed, largest first, by searching
+/// for a seed that sends every name in the bucket to a free slot. A lookup
+/// costs two hashes and one name comparison.
+class BlockNameHash
 {
-    std::vector<Linebreaker::BreakType> breaks(text.size());
+public:
+    BlockNameHash()
+    {
+        std::vector<std::vector<std::size_t>> buckets(NUM_BUCKETS);
 
-    set_linebreaks_utf16(reinterpret_cast<const utf16_t*>(text.data()),
-                        text.size(),
-                        language.data(),
-                        reinterpret_cast<char*>(breaks.data()));
-    
-    return breaks;
-}
+        for (std::size_t i = 0; i < BLOCK_TABLE_SIZE; ++i)
+            buckets[hashBlockName(BLOCK_TABLE[i].name, 0) % NUM_BUCKETS].push_back(i);
 
+        std::vector<std::size_t> order(NUM_BUCKETS);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
 
-std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(const std::u32string& text,
-                                                            const std::string& language)
-{
-    std::vector<Linebreaker::BreakType> breaks(text.size());
+        _slots.fill(nullptr);
+        _seeds.fill(0);
 
-    set_linebreaks_utf32(reinterpret_cast<const utf32_t*>(text.data()),
-                        text.size(),
-                        language.data(),
-                        reinterpret_cast<char*>(breaks.data()));
-    
-    return breaks;
-}
+        for (std::size_t bucket: order)
+        {
+            const auto& names = buckets[bucket];
 
+            if (names.empty())
+                break;
 
-Wordbreaker::Wordbreaker(const std::string& language):
-    _language(language)
+            for (uint32_t seed = 1; ; ++seed)
+            {
+                std::vector<std::size_t> slots;
+                bool placed = true;
+
+                for (std::size_t i: names)
+                {
+                    std::size_t slot = hashBlockName(BLOCK_TABLE[i].name, seed) % NUM_SLOTS;
+
+                    if (_slots[slot] != nullptr
+                    ||  std::find(slots.begin(), slots.end(), slot) != slots.end())
+                    {
+                        placed = false;
+                        break;
+                    }
+
+                    slots.push_back(slot);
+                }
+
+                if (placed)
+                {
+                    for (std::size_t j = 0; j < names.size(); ++j)
+                        _slots[slots[j]] = &BLOCK_TABLE[names[j]];
+
+                    _seeds[bucket] = seed;
+                    break;
+                }
+            }
+        }
+    }
+
+    const Unicode::Block* find(std::string_view name) const
+    {
+        uint32_t seed = _seeds[hashBlockName(name, 0) % NUM_BUCKETS];
+
+        if (seed == 0)
+            return nullptr;
+
+        const Unicode::Block* block = _slots[hashBlockName(name, seed) % NUM_SLOTS];
+
+        if (block && blockNamesEqual(block->name, name))
+            return block;
+
+        return nullptr;
+    }
+
+private:
+    /// \brief The number of slots, with a little headroom for new Blocks.
+    static const std::size_t NUM_SLOTS = 512;
+
+    /// \brief The number of displacement buckets.
+    static const std::size_t NUM_BUCKETS = 128;
+
+    /// \brief The displacement seed for each bucket, 0 if empty.
+    std::array<uint32_t, NUM_BUCKETS> _seeds;
+
+    /// \brief The Block placed in each slot.
+    std::array<const Unicode::Block*, NUM_SLOTS> _slots;
+
+};
+
+
+} // namespace
+
+
+const std::vector<const Unicode::Block*>& Unicode::blocks()
 {
+    static const std::vector<const Block*> registry = [] {
+        std::vector<const Block*> blocks;
+        for (const auto& block: BLOCK_TABLE)
+            blocks.push_back(&block);
+        return blocks;
+    }();
+
+    return registry;
 }
 
 
-Wordbreaker::~Wordbreaker()
+const Unicode::Block* Unicode::blockOf(char32_t codepoint)
 {
+    // Find the first Block that begins after the code point. The Block before
+    // it, if any, is the only one that could contain the code point.
+    auto iter = std::upper_bound(std::begin(BLOCK_TABLE),
+                                 std::end(BLOCK_TABLE),
+                                 codepoint,
+                                 [](char32_t c, const Block& block) {
+        return c < block.begin;
+    });
+
+    if (iter != std::begin(BLOCK_TABLE) && (iter - 1)->contains(codepoint))
+        return &*(iter - 1);
+
+    return nullptr;
 }
 
 
-const std::string& Wordbreaker::language() const
+const Unicode::Block* Unicode::blockByName(std::string_view name)
 {
-    return _language;
+    static const BlockNameHash hash;
+    return hash.find(name);
 }
 
 
-std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(const std::string& text) const
+namespace {
+
+
+/// \brief Initialize libunibreak's line breaking data once.
+void initLinebreaks()
 {
-    return findBreaks(text, _language);
+    static std::once_flag flag;
+    std::call_once(flag, init_linebreak);
 }
 
 
-std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(const std::u16string& text) const
+/// \brief Initialize libunibreak's word breaking data once.
+void initWordbreaks()
 {
-    return findBreaks(text, _language);
+    static std::once_flag flag;
+    std::call_once(flag, init_wordbreak);
 }
 
 
-std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(const std::u32string& text) const
+/// \brief Resolve a language to its libunibreak line breaking tailoring.
+///
+/// libunibreak searches lb_prop_lang_map whenever it is given a language.
+/// The result here is the matching map entry, or nullptr when the language
+/// has no tailoring, and is passed to initLinebreakContext() instead, so the
+/// map is searched once per Linebreaker rather than once per call. The entry
+/// is static storage and stays valid when its owner is copied.
+///
+/// \param language The language to resolve.
+/// \returns the resolved tailoring or nullptr.
+const LineBreakPropertiesLang* resolveLinebreakLanguage(const std::string& language)
 {
-    return findBreaks(text, _language);
+    for (const LineBreakPropertiesLang* entry = lb_prop_lang_map; entry->lang != nullptr; ++entry)
+        if (std::strncmp(language.c_str(), entry->lang, entry->namelen) == 0)
+            return entry;
+
+    return nullptr;
 }
 
 
-std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(const std::string& text,
-                                                            const std::string& language)
+/// \brief Start a line breaking context at the first code point of a text.
+///
+/// This is lb_init_break_context() without the lb_prop_lang_map search. The
+/// context is started without a language and the tailoring is set on it
+/// directly. The class of the first code point depends on the tailoring, so
+/// it is taken from a second context where the code point follows a
+/// mandatory break, which libunibreak classifies as a first code point.
+///
+/// \param context The context to start.
+/// \param codepoint The first code point.
+/// \param tailoring The resolved tailoring or nullptr.
+void initLinebreakContext(LineBreakContext& context,
+                          char32_t codepoint,
+                          const LineBreakPropertiesLang* tailoring)
 {
-    std::vector<Wordbreaker::BreakType> breaks(text.size());
+    lb_init_break_context(&context, codepoint, nullptr);
 
-    set_wordbreaks_utf8(reinterpret_cast<const utf8_t*>(text.data()),
-                        text.size(),
-                        language.data(),
-                        reinterpret_cast<char*>(breaks.data()));
+    if (tailoring == nullptr)
+        return;
 
-    return breaks;
+    LineBreakContext first;
+    lb_init_break_context(&first, U'\n', nullptr);
+    first.lang = tailoring->lang;
+    first.lbpLang = tailoring->lbp;
+    lb_process_next_char(&first, codepoint);
+
+    context.lang = tailoring->lang;
+    context.lbpLang = tailoring->lbp;
+    context.lbcCur = first.lbcCur;
 }
 
 
-std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(const std::u16string& text,
-                                                            const std::string& language)
+/// \brief Get the language name libunibreak expects for a tailoring.
+const char* linebreakLanguage(const LineBreakPropertiesLang* tailoring)
 {
-    std::vector<Wordbreaker::BreakType> breaks(text.size());
+    return tailoring != nullptr ? tailoring->lang : nullptr;
+}
 
-    set_wordbreaks_utf16(reinterpret_cast<const utf16_t*>(text.data()),
-                         text.size(),
-                         language.data(),
-                         reinterpret_cast<char*>(breaks.data()));
 
-    return breaks;
+utf32_t nextLinebreakCharacter(std::string_view text, std::size_t& i)
+{
+    return ub_get_next_char_utf8(reinterpret_cast<const utf8_t*>(text.data()), text.size(), &i);
 }
 
 
-std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(const std::u32string& text,
-                                                            const std::string& language)
+utf32_t nextLinebreakCharacter(std::u16string_view text, std::size_t& i)
 {
-    std::vector<Wordbreaker::BreakType> breaks(text.size());
-    
-    set_wordbreaks_utf32(reinterpret_cast<const utf32_t*>(text.data()),
-                         text.size(),
-                         language.data(),
-                         reinterpret_cast<char*>(breaks.data()));
-    
-    return breaks;
+    return ub_get_next_char_utf16(reinterpret_cast<const utf16_t*>(text.data()), text.size(), &i);
 }
 
 
-std::string UTF8::normalize(const std::string& utf8,
-                            Unicode::NormalizationForm form)
+utf32_t nextLinebreakCharacter(std::u32string_view text, std::size_t& i)
 {
-    utf8proc_uint8_t* retval = nullptr;
+    return ub_get_next_char_utf32(reinterpret_cast<const utf32_t*>(text.data()), text.size(), &i);
+}
 
-    switch (form)
-    {
-        case Unicode::NormalizationForm::NFC:
-            retval = utf8proc_NFC(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
-            break;
-        case Unicode::NormalizationForm::NFD:
-            retval = utf8proc_NFD(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
-            break;
-        case Unicode::NormalizationForm::NFKC:
-            retval = utf8proc_NFKC(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
-            break;
-        case Unicode::NormalizationForm::NFKD:
-            retval = utf8proc_NFKD(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
-            break;
-    }
 
-    if (retval)
-    {
-        std::string out(reinterpret_cast<char*>(retval));
-        free(retval);
-        return out;
-    }
+/// \brief Find the line breaks of a text, as set_linebreaks_*() does.
+template<typename Text>
+void setLinebreaks(Text text, const LineBreakPropertiesLang* tailoring, char* breaks)
+{
+    initLinebreaks();
 
-    ofLogError("UTF8::normalize") << "Unable to normalize: " << utf8;
-    return utf8;
-}
+    std::size_t i = 0;
+    utf32_t codepoint = nextLinebreakCharacter(text, i);
 
+    if (codepoint == EOS)
+        return;
 
-std::string UTF8::casefold(const std::string& utf8)
-{
-    utf8proc_uint8_t* retval = nullptr;
-    
-    utf8proc_ssize_t result = utf8proc_map(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()),
-                                           0,
-                                           &retval,
-                                           static_cast<utf8proc_option_t>(UTF8PROC_NULLTERM | UTF8PROC_STABLE | UTF8PROC_CASEFOLD));
+    LineBreakContext context;
+    initLinebreakContext(context, codepoint, tailoring);
 
-    if (result > 0)
+    std::size_t begin = 0;
+
+    for (;;)
     {
-        std::string out(reinterpret_cast<char*>(retval), result);
-        free(retval);
-        return out;
+        std::fill(breaks + begin, breaks + i - 1, LINEBREAK_INSIDEACHAR);
+
+        std::size_t last = i - 1;
+        begin = i;
+        codepoint = nextLinebreakCharacter(text, i);
+
+        if (codepoint == EOS)
+        {
+            // The end of the text is always a break.
+            breaks[last] = LINEBREAK_MUSTBREAK;
+            return;
+        }
+
+        breaks[last] = lb_process_next_char(&context, codepoint);
     }
+}
 
-    ofLogError("UTF8::casefold") << "Unable to casefold: " << utf8;
-    return utf8;
+
+void setWordbreaks(std::string_view text, const char* lang, char* breaks)
+{
+    initWordbreaks();
+    set_wordbreaks_utf8(reinterpret_cast<const utf8_t*>(text.data()),
+                        text.size(),
+                        lang,
+                        breaks);
 }
 
 
-bool UTF8::isValid(const std::string& txt)
+void setWordbreaks(std::u16string_view text, const char* lang, char* breaks)
 {
-    try
-    {
-        return utf8::is_valid(txt.begin(), txt.end());
-    }
-    catch (const utf8::exception& utfcpp_ex)
-    {
-        ofLogError("UTF8::isValid") << utfcpp_ex.what();
-        return false;
-    }
+    initWordbreaks();
+    set_wordbreaks_utf16(reinterpret_cast<const utf16_t*>(text.data()),
+                         text.size(),
+                         lang,
+                         breaks);
 }
 
 
-bool UTF8::startsWithBOM(const std::string& txt)
+void setWordbreaks(std::u32string_view text, const char* lang, char* breaks)
 {
-    return utf8::starts_with_bom(txt.begin(), txt.end());
+    initWordbreaks();
+    set_wordbreaks_utf32(reinterpret_cast<const utf32_t*>(text.data()),
+                         text.size(),
+                         lang,
+                         breaks);
 }
 
 
-std::string UTF8::repair(const std::string& txt, char32_t replacement)
+/// \brief The largest scratch buffer kept between calls, in bytes.
+const std::size_t MAX_RETAINED_SCRATCH_SIZE = 1 << 20;
+
+
+/// \brief A per-thread scratch buffer for intermediate break results.
+///
+/// The buffer is reused by later calls on the same thread, unless it grew
+/// past MAX_RETAINED_SCRATCH_SIZE, in which case it is released when the
+/// BreakScratch is destroyed.
+class BreakScratch
 {
-    std::string temp;
+public:
+    /// \brief Get the scratch buffer.
+    /// \param size The minimum size of the buffer.
+    BreakScratch(std::size_t size): _buffer(buffer())
+    {
+        if (_buffer.size() < size)
+            _buffer.resize(size);
+    }
 
-    try
+    ~BreakScratch()
     {
-        if (replacement == -1)
-        {
-            utf8::replace_invalid(txt.begin(), txt.end(), std::back_inserter(temp));
-        }
-        else
-        {
-            utf8::replace_invalid(txt.begin(), txt.end(), std::back_inserter(temp), replacement);
-        }
+        if (_buffer.size() > MAX_RETAINED_SCRATCH_SIZE)
+            std::vector<char>().swap(_buffer);
     }
-    catch (const utf8::exception& utfcpp_ex)
+
+    /// \returns the scratch buffer.
+    char* data()
     {
-        ofLogError("UTF8::repair") << utfcpp_ex.what();
+        return _buffer.data();
     }
 
-    return temp;
-}
+private:
+    static std::vector<char>& buffer()
+    {
+        thread_local std::vector<char> scratch;
+        return scratch;
+    }
 
+    std::vector<char>& _buffer;
 
-std::string& UTF8::repairInPlace(std::string& txt, char32_t replacement)
+};
+
+
+/// \brief Collect the break opportunities from a list of breaks.
+template<typename Breaker>
+std::vector<typename Breaker::Break> compactBreaks(const char* breaks, std::size_t size)
 {
-    txt = repair(txt, replacement);
-    return txt;
+    typedef typename Breaker::BreakType BreakType;
+
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < size; ++i)
+        count += Breaker::isBreak(static_cast<BreakType>(breaks[i]));
+
+    std::vector<typename Breaker::Break> results;
+    results.reserve(count);
+
+    for (std::size_t i = 0; i < size; ++i)
+        if (Breaker::isBreak(static_cast<BreakType>(breaks[i])))
+            results.push_back({ i, static_cast<BreakType>(breaks[i]) });
+
+    return results;
 }
 
 
-std::size_t UTF8::distance(const std::string& txt)
+template<typename Text>
+std::size_t findLinebreaks(Text text,
+                           const LineBreakPropertiesLang* tailoring,
+                           Linebreaker::BreakType* breaks,
+                           std::size_t size)
 {
-    try
-    {
-        return utf8::distance(txt.begin(), txt.end());
-    }
-    catch (const utf8::exception& utfcpp_ex)
+    if (size < text.size())
     {
-        ofLogError("ofUTF8::distance") << utfcpp_ex.what();
+        ofLogError("Linebreaker::findBreaks") << "The break buffer is too small.";
         return 0;
     }
+
+    setLinebreaks(text, tailoring, reinterpret_cast<char*>(breaks));
+    return text.size();
 }
 
 
-int UTF8::icompare(const std::string& utf8String0,
-                   const std::string& utf8String1)
+template<typename Text>
+std::vector<Linebreaker::Break> findLinebreakOffsets(Text text, const LineBreakPropertiesLang* tailoring)
 {
-    // Get correct pointers.
-    const utf8proc_uint8_t* s0 = reinterpret_cast<const utf8proc_uint8_t*>(utf8String0.data());
-    const utf8proc_uint8_t* s1 = reinterpret_cast<const utf8proc_uint8_t*>(utf8String1.data());
-
-    // Normalize and casefold.
-    utf8proc_option_t flags = static_cast<utf8proc_option_t>(UTF8PROC_NULLTERM | UTF8PROC_STABLE | UTF8PROC_CASEFOLD | UTF8PROC_COMPOSE);
-    utf8proc_uint8_t* _s0 = nullptr;
-    utf8proc_uint8_t* _s1 = nullptr;
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+    setLinebreaks(text, tailoring, breaks);
+    return compactBreaks<Linebreaker>(breaks, text.size());
+}
 
-    utf8proc_map(s0, 0, &_s0, flags);
-    utf8proc_map(s1, 0, &_s1, flags);
 
-    int result = 0;
-    bool success = false;
+template<typename Text>
+PackedBreaks<Linebreaker> findPackedLinebreaks(Text text, const LineBreakPropertiesLang* tailoring)
+{
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+    setLinebreaks(text, tailoring, breaks);
+    return PackedBreaks<Linebreaker>(reinterpret_cast<const Linebreaker::BreakType*>(breaks), text.size());
+}
 
-    if (_s0 && _s1)
-    {
-        result = std::strcmp(reinterpret_cast<const char*>(_s0),
-                             reinterpret_cast<const char*>(_s1));
-        success = true;
-    }
 
-    free(_s0);
-    free(_s1);
+} // namespace
 
-    if (!success)
-    {
-        ofLogError("UTF8::icompare") << "Unable to compare: " << utf8String0 << " and " << utf8String1;
-    }
 
-    return result;
+Linebreaker::Linebreaker(const std::string& language):
+    _language(language),
+    _resolvedLanguage(resolveLinebreakLanguage(language))
+{
+    initLinebreaks();
 }
 
 
-std::string UTF8::toUpper(const std::string& str)
+Linebreaker::~Linebreaker()
 {
-    return UTF32::toUTF8(UTF32::toUpper(toUTF32(str)));
 }
 
 
-std::string& UTF8::toUpperInPlace(std::string& str)
+const std::string& Linebreaker::language() const
 {
-    str = toUpper(str);
-    return str;
+    return _language;
 }
 
 
-std::string UTF8::toLower(const std::string& str)
+std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(std::string_view text) const
 {
-    return UTF32::toUTF8(UTF32::toLower(toUTF32(str)));
+    std::vector<BreakType> breaks;
+    findBreaks(text, breaks);
+    return breaks;
 }
 
 
-std::string& UTF8::toLowerInPlace(std::string& str)
+void Linebreaker::findBreaks(std::string_view text, std::vector<BreakType>& breaks) const
 {
-    str = toLower(str);
-    return str;
+    breaks.resize(text.size());
+    findBreaks(text, breaks.data(), breaks.size());
 }
 
 
-std::u16string UTF8::toUTF16(const std::string& input)
+std::size_t Linebreaker::findBreaks(std::string_view text, BreakType* breaks, std::size_t size) const
 {
-    std::u16string utf16result;
-
-    try
-    {
-        utf8::utf8to16(input.begin(),
-                       input.end(),
-                       std::back_inserter(utf16result));
+    return findLinebreaks(text, _resolvedLanguage, breaks, size);
+}
 
-    }
-    catch (const utf8::exception& utfcpp_ex)
-    {
-        ofLogError("TextConverter::toUTF16") << utfcpp_ex.what();
-    }
 
-    return utf16result;
+std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(std::u16string_view text) const
+{
+    std::vector<BreakType> breaks;
+    findBreaks(text, breaks);
+    return breaks;
 }
 
 
-
-std::u32string UTF8::toUTF32(const std::string& input)
+void Linebreaker::findBreaks(std::u16string_view text, std::vector<BreakType>& breaks) const
 {
-    std::u32string utf32result;
+    breaks.resize(text.size());
+    findBreaks(text, breaks.data(), breaks.size());
+}
 
-    try
-    {
-        utf8::utf8to32(input.begin(),
-                       input.end(),
-                       std::back_inserter(utf32result));
-    }
-    catch (const utf8::exception& utfcpp_ex)
-    {
-        ofLogError("TextConverter::toUTF32") << utfcpp_ex.what();
-    }
 
-    return utf32result;
+std::size_t Linebreaker::findBreaks(std::u16string_view text, BreakType* breaks, std::size_t size) const
+{
+    return findLinebreaks(text, _resolvedLanguage, breaks, size);
 }
 
 
-std::string UTF16::toUTF8(const std::u16string& input)
+std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(std::u32string_view text) const
 {
-    std::string utf8result;
+    std::vector<BreakType> breaks;
+    findBreaks(text, breaks);
+    return breaks;
+}
 
-    try
-    {
-        utf8::utf16to8(input.begin(), input.end(), std::back_inserter(utf8result));
-    }
-    catch (const utf8::exception& utfcpp_ex)
-    {
-        ofLogError("TextConverter::toUTF8") << utfcpp_ex.what();
-    }
 
-    return utf8result;
+void Linebreaker::findBreaks(std::u32string_view text, std::vector<BreakType>& breaks) const
+{
+    breaks.resize(text.size());
+    findBreaks(text, breaks.data(), breaks.size());
 }
 
 
-    
-std::u32string UTF16::toUTF32(const std::u16string& input)
+std::size_t Linebreaker::findBreaks(std::u32string_view text, BreakType* breaks, std::size_t size) const
 {
-    return UTF8::toUTF32(toUTF8(input));
+    return findLinebreaks(text, _resolvedLanguage, breaks, size);
 }
 
 
-bool UTF32::isValid(char32_t unichar)
+std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(std::string_view text,
+                                                            const std::string& language)
 {
-    return !((unichar > 0x0010ffffu) || (unichar >= 0xd800u && unichar <= 0xdfffu));
+    std::vector<Linebreaker::BreakType> breaks;
+    findBreaks(text, language, breaks);
+    return breaks;
 }
 
 
-bool UTF32::isPrintable(char32_t unichar)
+void Linebreaker::findBreaks(std::string_view text,
+                             const std::string& language,
+                             std::vector<BreakType>& breaks)
 {
-    // aka is graphic.
-    int category = ucdn_get_general_category(unichar);
-
-    return category != UCDN_GENERAL_CATEGORY_CC
-        && category != UCDN_GENERAL_CATEGORY_CF
-        && category != UCDN_GENERAL_CATEGORY_CN
-        && category != UCDN_GENERAL_CATEGORY_CO
-        && category != UCDN_GENERAL_CATEGORY_CS
-        && category != UCDN_GENERAL_CATEGORY_ZL
-        && category != UCDN_GENERAL_CATEGORY_ZP;
+    breaks.resize(text.size());
+    findBreaks(text, language, breaks.data(), breaks.size());
 }
 
 
-bool UTF32::isControl(char32_t unichar)
+std::size_t Linebreaker::findBreaks(std::string_view text,
+                                    const std::string& language,
+                                    BreakType* breaks,
+                                    std::size_t size)
 {
-    // True if unichar is:
-    //    ISO 8-bit control character (U+0000..U+001f and U+007f..U+009f)
-    //    U_CONTROL_CHAR (Cc)
-    //    U_FORMAT_CHAR (Cf)
-    //    U_LINE_SEPARATOR (Zl)
-    //    U_PARAGRAPH_SEPARATOR (Zp)
-    // This definition shared with ICU's isCntrl function
-    // https://ssl.icu-project.org/apiref/icu4c/uchar_8h.html
+    return findLinebreaks(text, resolveLinebreakLanguage(language), breaks, size);
+}
 
-    if ((unichar <= 0x001F) || (unichar >= 0x007F && unichar <= 0x009F))
-    {
-        return true;
-    }
-    else
-    {
-        int category = ucdn_get_general_category(unichar);
 
-        return category == UCDN_GENERAL_CATEGORY_CC
-            || category == UCDN_GENERAL_CATEGORY_CF
-            || category == UCDN_GENERAL_CATEGORY_ZL
-            || category == UCDN_GENERAL_CATEGORY_ZP;
-    }
+std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(std::u16string_view text,
+                                                            const std::string& language)
+{
+    std::vector<Linebreaker::BreakType> breaks;
+    findBreaks(text, language, breaks);
+    return breaks;
 }
 
 
-bool UTF32::isTitle(char32_t unichar)
+void Linebreaker::findBreaks(std::u16string_view text,
+                             const std::string& language,
+                             std::vector<BreakType>& breaks)
 {
-    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_LT;
+    breaks.resize(text.size());
+    findBreaks(text, language, breaks.data(), breaks.size());
 }
 
 
-bool UTF32::isSpace(char32_t unichar)
+std::size_t Linebreaker::findBreaks(std::u16string_view text,
+                                    const std::string& language,
+                                    BreakType* breaks,
+                                    std::size_t size)
 {
-    int category = ucdn_get_general_category(unichar);
-
-    return category == UCDN_GENERAL_CATEGORY_ZS
-        || category == UCDN_GENERAL_CATEGORY_ZL
-        || category == UCDN_GENERAL_CATEGORY_ZP;
+    return findLinebreaks(text, resolveLinebreakLanguage(language), breaks, size);
 }
 
 
-bool UTF32::isDigit(char32_t unichar)
+std::vector<Linebreaker::BreakType> Linebreaker::findBreaks(std::u32string_view text,
+                                                            const std::string& language)
 {
-    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_ND;
+    std::vector<Linebreaker::BreakType> breaks;
+    findBreaks(text, language, breaks);
+    return breaks;
 }
 
 
-bool UTF32::isPunct(char32_t unichar)
+void Linebreaker::findBreaks(std::u32string_view text,
+                             const std::string& language,
+                             std::vector<BreakType>& breaks)
 {
-    int category = ucdn_get_general_category(unichar);
-
-    return category == UCDN_GENERAL_CATEGORY_PC
-        || category == UCDN_GENERAL_CATEGORY_PD
-        || category == UCDN_GENERAL_CATEGORY_PE
-        || category == UCDN_GENERAL_CATEGORY_PF
-        || category == UCDN_GENERAL_CATEGORY_PI
-        || category == UCDN_GENERAL_CATEGORY_PO
-        || category == UCDN_GENERAL_CATEGORY_PS;
+    breaks.resize(text.size());
+    findBreaks(text, language, breaks.data(), breaks.size());
 }
 
 
-bool UTF32::isAlpha(char32_t unichar)
+std::size_t Linebreaker::findBreaks(std::u32string_view text,
+                                    const std::string& language,
+                                    BreakType* breaks,
+                                    std::size_t size)
 {
-    int category = ucdn_get_general_category(unichar);
-
-    return category == UCDN_GENERAL_CATEGORY_LL
-        || category == UCDN_GENERAL_CATEGORY_LM
-        || category == UCDN_GENERAL_CATEGORY_LO
-        || category == UCDN_GENERAL_CATEGORY_LT
-        || category == UCDN_GENERAL_CATEGORY_LU;
+    return findLinebreaks(text, resolveLinebreakLanguage(language), breaks, size);
 }
 
 
-bool UTF32::isAlphaNumeric(char32_t unichar)
+namespace {
+
+
+/// \brief Find the next line feed in a text.
+///
+/// For UTF-8 this uses std::memchr, which the C library implements with
+/// vectorized scanning.
+///
+/// \returns the offset of the line feed or std::string::npos.
+std::size_t findLineFeed(std::string_view text, std::size_t from)
 {
-    int category = ucdn_get_general_category(unichar);
+    if (from >= text.size())
+        return std::string::npos;
 
-    return category == UCDN_GENERAL_CATEGORY_ND // digit
-        || category == UCDN_GENERAL_CATEGORY_LL
-        || category == UCDN_GENERAL_CATEGORY_LM
-        || category == UCDN_GENERAL_CATEGORY_LO
-        || category == UCDN_GENERAL_CATEGORY_LT
-        || category == UCDN_GENERAL_CATEGORY_LU;
+    const void* found = std::memchr(text.data() + from, '\n', text.size() - from);
+    return found ? static_cast<const char*>(found) - text.data() : std::string::npos;
 }
 
 
-bool UTF32::isLower(char32_t unichar)
+template<typename Char>
+std::size_t findLineFeed(std::basic_string_view<Char> text, std::size_t from)
 {
-    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_LL;
+    return text.find(Char('\n'), from);
 }
 
 
-bool UTF32::isUpper(char32_t unichar)
+/// \brief Break a text on multiple threads, split after line feeds.
+template<typename Char>
+void findBreaksParallel(std::basic_string_view<Char> text,
+                        const LineBreakPropertiesLang* tailoring,
+                        Linebreaker::BreakType* breaks,
+                        const Linebreaker::ParallelSettings& settings)
 {
-    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_LU;
-}
+    std::size_t chunkSize = std::max(std::size_t(1), settings.minChunkSize);
 
+    // Precompute the work items. Each one ends just after a line feed, or at
+    // the end of the text, and is at least chunkSize units long.
+    std::vector<std::size_t> boundaries(1, 0);
 
-char32_t UTF32::toLower(char32_t unichar)
-{
-    return utf8proc_tolower(unichar);
-}
+    while (boundaries.back() < text.size())
+    {
+        std::size_t lineFeed = findLineFeed(text, boundaries.back() + chunkSize - 1);
+        boundaries.push_back(lineFeed == std::string::npos ? text.size() : lineFeed + 1);
+    }
 
+    std::size_t numItems = boundaries.size() - 1;
+    std::size_t numThreads = settings.numThreads;
 
-char32_t UTF32::toUpper(char32_t unichar)
-{
-    return utf8proc_toupper(unichar);
-}
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
 
+    numThreads = std::min(numThreads, numItems);
 
-char32_t& UTF32::toLowerInPlace(char32_t& unichar)
-{
-    unichar = toLower(unichar); 
-    return unichar;
+    std::atomic<std::size_t> nextItem(0);
+
+    auto worker = [&]() {
+        std::size_t i;
+
+        while ((i = nextItem.fetch_add(1)) < numItems)
+        {
+            std::size_t begin = boundaries[i];
+            std::size_t size = boundaries[i + 1] - begin;
+
+            findLinebreaks(text.substr(begin, size), tailoring, breaks + begin, size);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < numThreads; ++i)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread: threads)
+        thread.join();
 }
 
 
-char32_t& UTF32::toUpperInPlace(char32_t& unichar)
+} // namespace
+
+
+void Linebreaker::findBreaksParallel(std::string_view text,
+                                     std::vector<BreakType>& breaks,
+                                     const ParallelSettings& settings) const
 {
-    unichar = toUpper(unichar); 
-    return unichar;
+    breaks.resize(text.size());
+    ofx::findBreaksParallel(text, _resolvedLanguage, breaks.data(), settings);
 }
 
 
-std::u32string UTF32::toLower(const std::u32string& unichar)
+void Linebreaker::findBreaksParallel(std::u16string_view text,
+                                     std::vector<BreakType>& breaks,
+                                     const ParallelSettings& settings) const
 {
-    std::u32string out;
-    auto it = unichar.cbegin();
-    while (it != unichar.end()) {out.push_back(toLower(*(it++)));}
-    return out;
+    breaks.resize(text.size());
+    ofx::findBreaksParallel(text, _resolvedLanguage, breaks.data(), settings);
 }
 
 
-std::u32string UTF32::toUpper(const std::u32string& unichar)
+void Linebreaker::findBreaksParallel(std::u32string_view text,
+                                     std::vector<BreakType>& breaks,
+                                     const ParallelSettings& settings) const
 {
-    std::u32string out;
-    auto it = unichar.cbegin();
-    while (it != unichar.end()) {out.push_back(toUpper(*(it++)));}
-    return out;
+    breaks.resize(text.size());
+    ofx::findBreaksParallel(text, _resolvedLanguage, breaks.data(), settings);
 }
 
 
-std::u32string& UTF32::toLowerInPlace(std::u32string& unichar)
+void Linebreaker::findBreaksParallel(std::string_view text,
+                                     const std::string& language,
+                                     std::vector<BreakType>& breaks,
+                                     const ParallelSettings& settings)
 {
-    auto it = unichar.begin();
-    while (it != unichar.end()) {toUpperInPlace(*(it++));}
-    return unichar;
+    breaks.resize(text.size());
+    ofx::findBreaksParallel(text, resolveLinebreakLanguage(language), breaks.data(), settings);
 }
 
 
-std::u32string& UTF32::toUpperInPlace(std::u32string& unichar)
+void Linebreaker::findBreaksParallel(std::u16string_view text,
+                                     const std::string& language,
+                                     std::vector<BreakType>& breaks,
+                                     const ParallelSettings& settings)
 {
-    auto it = unichar.begin();
-    while (it != unichar.end()) {toLowerInPlace(*(it++));}
-    return unichar;
+    breaks.resize(text.size());
+    ofx::findBreaksParallel(text, resolveLinebreakLanguage(language), breaks.data(), settings);
 }
 
 
-std::string UTF32::toUTF8(char32_t input)
+void Linebreaker::findBreaksParallel(std::u32string_view text,
+                                     const std::string& language,
+                                     std::vector<BreakType>& breaks,
+                                     const ParallelSettings& settings)
 {
-    std::string txt;
-
-    try
-    {
-        utf8::append(input, std::back_inserter(txt));
-    }
-    catch (const utf8::exception& utfcpp_ex)
-    {
-        ofLogError("TextConverter::toUTF8") << utfcpp_ex.what();
-    }
-    return txt;
+    breaks.resize(text.size());
+    ofx::findBreaksParallel(text, resolveLinebreakLanguage(language), breaks.data(), settings);
 }
 
 
-std::string UTF32::toUTF8(const std::u32string& input)
+std::vector<Linebreaker::Break> Linebreaker::findBreakOffsets(std::string_view text) const
 {
-    std::string utf8result;
+    return findLinebreakOffsets(text, _resolvedLanguage);
+}
 
-    try
-    {
-        utf8::utf32to8(input.begin(), input.end(), std::back_inserter(utf8result));
-    }
-    catch (const utf8::exception& utfcpp_ex)
-    {
-        ofLogError("TextConverter::toUTF8") << utfcpp_ex.what();
-    }
 
-    return utf8result;
+std::vector<Linebreaker::Break> Linebreaker::findBreakOffsets(std::u16string_view text) const
+{
+    return findLinebreakOffsets(text, _resolvedLanguage);
 }
 
 
-std::u16string UTF32::toUTF16(char32_t input)
+std::vector<Linebreaker::Break> Linebreaker::findBreakOffsets(std::u32string_view text) const
 {
-    return UTF8::toUTF16(toUTF8(input));
+    return findLinebreakOffsets(text, _resolvedLanguage);
 }
 
 
-std::u16string UTF32::toUTF16(const std::u32string& input)
+std::vector<Linebreaker::Break> Linebreaker::findBreakOffsets(std::string_view text,
+                                                              const std::string& language)
 {
-    return UTF8::toUTF16(toUTF8(input));
+    return findLinebreakOffsets(text, resolveLinebreakLanguage(language));
 }
 
 
-#include <iconv.h>
+std::vector<Linebreaker::Break> Linebreaker::findBreakOffsets(std::u16string_view text,
+                                                              const std::string& language)
+{
+    return findLinebreakOffsets(text, resolveLinebreakLanguage(language));
+}
 
 
-const iconv_t INVALID_CD = (iconv_t) - 1;
-const std::size_t INVALID_CONVERSION = (std::size_t) - 1;
+std::vector<Linebreaker::Break> Linebreaker::findBreakOffsets(std::u32string_view text,
+                                                              const std::string& language)
+{
+    return findLinebreakOffsets(text, resolveLinebreakLanguage(language));
+}
 
 
-const std::string TextConverter::ENCODING_ASCII = "ASCII";
-const std::string TextConverter::ENCODING_UTF8 = "UTF-8";
-const std::string TextConverter::ENCODING_UTF16 = "UTF-16";
-const std::string TextConverter::ENCODING_UTF32 = "UTF-32";
-const std::string TextConverter::ENCODING_ISO_8859_1 = "ISO-8859-1";
-const std::string TextConverter::ENCODING_LATIN_1 = ENCODING_ISO_8859_1;
-const std::string TextConverter::ENCODING_ISO_8859_2 = "ISO-8859-2";
-const std::string TextConverter::ENCODING_LATIN_2 = ENCODING_ISO_8859_2;
-const std::string TextConverter::ENCODING_ISO_8859_15 = "ISO-8859-15";
-const std::string TextConverter::ENCODING_LATIN_9 = ENCODING_ISO_8859_15;
-const std::string TextConverter::ENCODING_WINDOWS_1250 = "windows-1250";
-const std::string TextConverter::ENCODING_WINDOWS_1251 = "windows-1251";
-const std::string TextConverter::ENCODING_WINDOWS_1252 = "windows-1252";
+PackedBreaks<Linebreaker> Linebreaker::findPackedBreaks(std::string_view text) const
+{
+    return findPackedLinebreaks(text, _resolvedLanguage);
+}
 
 
-TextConverter::TextConverter()
+PackedBreaks<Linebreaker> Linebreaker::findPackedBreaks(std::u16string_view text) const
 {
+    return findPackedLinebreaks(text, _resolvedLanguage);
 }
 
 
-TextConverter::TextConverter(const std::string& inputEncoding,
-                             const std::string& outputEncoding)
+PackedBreaks<Linebreaker> Linebreaker::findPackedBreaks(std::u32string_view text) const
 {
-    Settings settings;
-    settings.inputEncoding = inputEncoding;
-    settings.outputEncoding = outputEncoding;
-    setup(settings);
+    return findPackedLinebreaks(text, _resolvedLanguage);
 }
 
 
-TextConverter::TextConverter(const Settings& settings)
+PackedBreaks<Linebreaker> Linebreaker::findPackedBreaks(std::string_view text,
+                                                        const std::string& language)
 {
-    setup(settings);
+    return findPackedLinebreaks(text, resolveLinebreakLanguage(language));
 }
 
 
-TextConverter::~TextConverter()
+PackedBreaks<Linebreaker> Linebreaker::findPackedBreaks(std::u16string_view text,
+                                                        const std::string& language)
 {
+    return findPackedLinebreaks(text, resolveLinebreakLanguage(language));
 }
 
 
-bool TextConverter::setup(const std::string& outputEncoding)
+PackedBreaks<Linebreaker> Linebreaker::findPackedBreaks(std::u32string_view text,
+                                                        const std::string& language)
 {
-    Settings settings;
-    settings.inputEncoding = "UTF-8";
-    settings.outputEncoding = outputEncoding;
-    return setup(settings);
+    return findPackedLinebreaks(text, resolveLinebreakLanguage(language));
 }
 
 
-bool TextConverter::setup(const Settings& settings)
+Linebreaker::Stream Linebreaker::stream() const
 {
-    _cd.reset();
+    return Stream(_language);
+}
 
-    // Input and output encoding are backwards in the iconv api.
-    // This allocates a conversion descriptor.
 
-    std::string outputEncoding = settings.outputEncoding;
+namespace {
 
-    if (settings.transliterate)
-        outputEncoding += "//TRANSLIT";
 
-    iconv_t cd = iconv_open(outputEncoding.data(),
-                            settings.inputEncoding.data());
+/// \brief The replacement character used for invalid sequences.
+const char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+
+/// \brief Decode a complete UTF-8 sequence.
+/// \param units The code units of the sequence.
+/// \param length The number of code units in the sequence.
+/// \returns the code point or REPLACEMENT_CHARACTER if it is invalid.
+char32_t decodeUTF8Sequence(const char32_t* units, std::size_t length)
+{
+    static const char32_t minimums[] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+    char32_t codepoint = units[0] & (0x7F >> length);
+
+    for (std::size_t i = 1; i < length; ++i)
+        codepoint = (codepoint << 6) | (units[i] & 0x3F);
+
+    if (codepoint < minimums[length]
+    ||  codepoint > 0x10FFFF
+    || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+    {
+        return REPLACEMENT_CHARACTER;
+    }
+
+    return codepoint;
+}
+
+
+/// \brief Get the length of a UTF-8 sequence from its lead byte.
+/// \returns the sequence length or 0 if the byte cannot start a sequence.
+std::size_t utf8SequenceLength(unsigned char lead)
+{
+    if (lead < 0x80)
+        return 1;
+    else if (lead >= 0xC2 && lead <= 0xDF)
+        return 2;
+    else if (lead >= 0xE0 && lead <= 0xEF)
+        return 3;
+    else if (lead >= 0xF0 && lead <= 0xF4)
+        return 4;
+
+    return 0;
+}
+
+
+/// \brief Decode the UTF-8 character starting at an offset.
+///
+/// Invalid or truncated sequences decode as REPLACEMENT_CHARACTER and consume
+/// the bytes up to the first one that does not continue the sequence.
+///
+/// \param utf8 The UTF-8 encoded text.
+/// \param offset The byte offset of the character.
+/// \param length Set to the number of bytes consumed.
+/// \returns the decoded code point.
+char32_t nextUTF8Character(std::string_view utf8,
+                           std::size_t offset,
+                           std::size_t& length)
+{
+    unsigned char lead = static_cast<unsigned char>(utf8[offset]);
+    std::size_t expected = utf8SequenceLength(lead);
+
+    if (expected == 1)
+    {
+        length = 1;
+        return lead;
+    }
+
+    char32_t units[4] = { lead, 0, 0, 0 };
+    length = 1;
+
+    while (length < expected
+        && offset + length < utf8.size()
+        && (static_cast<unsigned char>(utf8[offset + length]) & 0xC0) == 0x80)
+    {
+        units[length] = static_cast<unsigned char>(utf8[offset + length]);
+        ++length;
+    }
+
+    if (expected == 0 || length < expected)
+        return REPLACEMENT_CHARACTER;
+
+    return decodeUTF8Sequence(units, length);
+}
+
+
+} // namespace
+
+
+Linebreaker::Stream::Stream(const std::string& language):
+    _language(language),
+    _resolvedLanguage(resolveLinebreakLanguage(language))
+{
+    initLinebreaks();
+}
+
+
+Linebreaker::Stream::~Stream()
+{
+}
+
+
+const std::string& Linebreaker::Stream::language() const
+{
+    return _language;
+}
+
+
+std::size_t Linebreaker::Stream::feed(std::string_view chunk,
+                                      std::vector<Break>& breaks)
+{
+    std::size_t numBreaks = 0;
+
+    for (std::size_t i = 0; i < chunk.size(); )
+    {
+        unsigned char unit = static_cast<unsigned char>(chunk[i]);
+        std::size_t offset = _offset + i;
+
+        if (_numPending == 0)
+        {
+            std::size_t length = utf8SequenceLength(unit);
+
+            if (length == 1)
+            {
+                numBreaks += process(unit, offset, breaks);
+            }
+            else if (length == 0)
+            {
+                numBreaks += process(REPLACEMENT_CHARACTER, offset, breaks);
+            }
+            else
+            {
+                _pending[_numPending++] = unit;
+                _numExpected = length;
+            }
+
+            ++i;
+        }
+        else if ((unit & 0xC0) == 0x80)
+        {
+            _pending[_numPending++] = unit;
+
+            if (_numPending == _numExpected)
+            {
+                numBreaks += process(decodeUTF8Sequence(_pending, _numPending),
+                                     offset,
+                                     breaks);
+                _numPending = 0;
+            }
+
+            ++i;
+        }
+        else
+        {
+            // The sequence was cut short. Replace it and then reprocess this
+            // unit as the start of a new sequence.
+            numBreaks += process(REPLACEMENT_CHARACTER, offset - 1, breaks);
+            _numPending = 0;
+        }
+    }
+
+    _offset += chunk.size();
+    return numBreaks;
+}
+
+
+std::size_t Linebreaker::Stream::feed(std::u16string_view chunk,
+                                      std::vector<Break>& breaks)
+{
+    std::size_t numBreaks = 0;
+
+    for (std::size_t i = 0; i < chunk.size(); )
+    {
+        char32_t unit = chunk[i];
+        std::size_t offset = _offset + i;
+
+        if (_numPending == 0)
+        {
+            if (unit >= 0xD800 && unit <= 0xDBFF)
+                _pending[_numPending++] = unit;
+            else if (unit >= 0xDC00 && unit <= 0xDFFF)
+                numBreaks += process(REPLACEMENT_CHARACTER, offset, breaks);
+            else
+                numBreaks += process(unit, offset, breaks);
+
+            ++i;
+        }
+        else if (unit >= 0xDC00 && unit <= 0xDFFF)
+        {
+            char32_t codepoint = 0x10000 + ((_pending[0] - 0xD800) << 10) + (unit - 0xDC00);
+            numBreaks += process(codepoint, offset, breaks);
+            _numPending = 0;
+            ++i;
+        }
+        else
+        {
+            // An unpaired high surrogate. Replace it and reprocess this unit.
+            numBreaks += process(REPLACEMENT_CHARACTER, offset - 1, breaks);
+            _numPending = 0;
+        }
+    }
+
+    _offset += chunk.size();
+    return numBreaks;
+}
+
+
+std::size_t Linebreaker::Stream::feed(std::u32string_view chunk,
+                                      std::vector<Break>& breaks)
+{
+    std::size_t numBreaks = 0;
+
+    for (std::size_t i = 0; i < chunk.size(); ++i)
+    {
+        char32_t codepoint = UTF32::isValid(chunk[i]) ? chunk[i] : REPLACEMENT_CHARACTER;
+        numBreaks += process(codepoint, _offset + i, breaks);
+    }
+
+    _offset += chunk.size();
+    return numBreaks;
+}
+
+
+std::size_t Linebreaker::Stream::finish(std::vector<Break>& breaks)
+{
+    std::size_t numBreaks = 0;
+
+    if (_started)
+    {
+        breaks.push_back({ _previousLast, BreakType::MUST_BREAK });
+        ++numBreaks;
+    }
+
+    reset();
+    return numBreaks;
+}
+
+
+void Linebreaker::Stream::reset()
+{
+    _started = false;
+    _previousLast = 0;
+    _offset = 0;
+    _numPending = 0;
+    _numExpected = 0;
+}
+
+
+std::size_t Linebreaker::Stream::offset() const
+{
+    return _offset;
+}
+
+
+std::size_t Linebreaker::Stream::process(char32_t codepoint,
+                                         std::size_t last,
+                                         std::vector<Break>& breaks)
+{
+    std::size_t numBreaks = 0;
+
+    if (!_started)
+    {
+        initLinebreakContext(_context, codepoint, _resolvedLanguage);
+        _started = true;
+    }
+    else
+    {
+        int result = lb_process_next_char(&_context, codepoint);
+
+        if (result == LINEBREAK_MUSTBREAK || result == LINEBREAK_ALLOWBREAK)
+        {
+            breaks.push_back({ _previousLast, static_cast<BreakType>(result) });
+            ++numBreaks;
+        }
+    }
+
+    _previousLast = last;
+    return numBreaks;
+}
+
+
+Linebreaker::Index::Index(const std::string& text,
+                          const std::string& language):
+    _language(language),
+    _resolvedLanguage(resolveLinebreakLanguage(language))
+{
+    initLinebreaks();
+    setText(text);
+}
+
+
+Linebreaker::Index::~Index()
+{
+}
+
+
+void Linebreaker::Index::setText(const std::string& text)
+{
+    _text = text;
+    _breaks.assign(_text.size(), BreakType::NO_BREAK);
+    rebreak(0, std::string::npos);
+}
+
+
+std::pair<std::size_t, std::size_t> Linebreaker::Index::edit(std::size_t offset,
+                                                             std::size_t removed,
+                                                             const std::string& inserted)
+{
+    offset = std::min(offset, _text.size());
+    removed = std::min(removed, _text.size() - offset);
+
+    _text.replace(offset, removed, inserted);
+
+    // Splice the break list so that breaks after the edit keep their old
+    // values at their new positions.
+    _breaks.erase(_breaks.begin() + offset, _breaks.begin() + offset + removed);
+    _breaks.insert(_breaks.begin() + offset, inserted.size(), BreakType::NO_BREAK);
+
+    // Find a stable restart point. A break at p was decided by the
+    // characters up to and including the one starting at p + 1, so it is only
+    // unaffected by the edit if p + 1 < offset. Restarting after a break
+    // opportunity resets the pairwise context, and a mandatory break resets
+    // it completely. We go back two opportunities to leave a margin for the
+    // rules that look behind a break.
+    std::size_t begin = 0;
+    std::size_t numOpportunities = 0;
+
+    for (std::size_t p = offset; p-- > 1; )
+    {
+        if (p + 1 < offset
+        && (_breaks[p] == BreakType::ALLOW_BREAK || _breaks[p] == BreakType::MUST_BREAK))
+        {
+            if (_breaks[p] == BreakType::MUST_BREAK || ++numOpportunities == 2)
+            {
+                begin = p + 1;
+                break;
+            }
+        }
+    }
+
+    std::size_t end = rebreak(begin, offset + inserted.size());
+    return std::make_pair(begin, end);
+}
+
+
+const std::string& Linebreaker::Index::text() const
+{
+    return _text;
+}
+
+
+const std::vector<Linebreaker::BreakType>& Linebreaker::Index::breaks() const
+{
+    return _breaks;
+}
+
+
+const std::string& Linebreaker::Index::language() const
+{
+    return _language;
+}
+
+
+std::size_t Linebreaker::Index::rebreak(std::size_t begin,
+                                        std::size_t stableAfter)
+{
+    LineBreakContext context;
+    bool started = false;
+    std::size_t previousLast = 0;
+    std::size_t i = begin;
+
+    while (i < _text.size())
+    {
+        std::size_t length = 0;
+        char32_t codepoint = nextUTF8Character(_text, i, length);
+
+        if (!started)
+        {
+            initLinebreakContext(context, codepoint, _resolvedLanguage);
+            started = true;
+        }
+        else
+        {
+            BreakType result = static_cast<BreakType>(lb_process_next_char(&context, codepoint));
+            BreakType old = _breaks[previousLast];
+            _breaks[previousLast] = result;
+
+            // Once past the edit, matching a previous break opportunity means
+            // the rest of the old breaks are still valid.
+            if (previousLast >= stableAfter
+            &&  result == old
+            && (result == BreakType::ALLOW_BREAK || result == BreakType::MUST_BREAK))
+            {
+                return previousLast + 1;
+            }
+        }
+
+        for (std::size_t j = 0; j + 1 < length; ++j)
+            _breaks[i + j] = BreakType::INSIDE_CHAR;
+
+        previousLast = i + length - 1;
+        i += length;
+    }
+
+    // The end of the text is always a mandatory break.
+    if (started)
+        _breaks[previousLast] = BreakType::MUST_BREAK;
+
+    return _text.size();
+}
+
+
+Wordbreaker::Wordbreaker(const std::string& language):
+    _language(language)
+{
+    initWordbreaks();
+}
+
+
+Wordbreaker::~Wordbreaker()
+{
+}
+
+
+const std::string& Wordbreaker::language() const
+{
+    return _language;
+}
+
+
+std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(std::string_view text) const
+{
+    return findBreaks(text, _language);
+}
+
+
+void Wordbreaker::findBreaks(std::string_view text, std::vector<BreakType>& breaks) const
+{
+    findBreaks(text, _language, breaks);
+}
+
+
+std::size_t Wordbreaker::findBreaks(std::string_view text, BreakType* breaks, std::size_t size) const
+{
+    return findBreaks(text, _language, breaks, size);
+}
+
+
+std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(std::u16string_view text) const
+{
+    return findBreaks(text, _language);
+}
+
+
+void Wordbreaker::findBreaks(std::u16string_view text, std::vector<BreakType>& breaks) const
+{
+    findBreaks(text, _language, breaks);
+}
+
+
+std::size_t Wordbreaker::findBreaks(std::u16string_view text, BreakType* breaks, std::size_t size) const
+{
+    return findBreaks(text, _language, breaks, size);
+}
+
+
+std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(std::u32string_view text) const
+{
+    return findBreaks(text, _language);
+}
+
+
+void Wordbreaker::findBreaks(std::u32string_view text, std::vector<BreakType>& breaks) const
+{
+    findBreaks(text, _language, breaks);
+}
+
+
+std::size_t Wordbreaker::findBreaks(std::u32string_view text, BreakType* breaks, std::size_t size) const
+{
+    return findBreaks(text, _language, breaks, size);
+}
+
+
+std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(std::string_view text,
+                                                            const std::string& language)
+{
+    std::vector<Wordbreaker::BreakType> breaks;
+    findBreaks(text, language, breaks);
+    return breaks;
+}
+
+
+void Wordbreaker::findBreaks(std::string_view text,
+                             const std::string& language,
+                             std::vector<BreakType>& breaks)
+{
+    breaks.resize(text.size());
+    findBreaks(text, language, breaks.data(), breaks.size());
+}
+
+
+std::size_t Wordbreaker::findBreaks(std::string_view text,
+                                    const std::string& language,
+                                    BreakType* breaks,
+                                    std::size_t size)
+{
+    if (size < text.size())
+    {
+        ofLogError("Wordbreaker::findBreaks") << "The break buffer is too small.";
+        return 0;
+    }
+
+    setWordbreaks(text, language.data(), reinterpret_cast<char*>(breaks));
+
+    return text.size();
+}
+
+
+std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(std::u16string_view text,
+                                                            const std::string& language)
+{
+    std::vector<Wordbreaker::BreakType> breaks;
+    findBreaks(text, language, breaks);
+    return breaks;
+}
+
+
+void Wordbreaker::findBreaks(std::u16string_view text,
+                             const std::string& language,
+                             std::vector<BreakType>& breaks)
+{
+    breaks.resize(text.size());
+    findBreaks(text, language, breaks.data(), breaks.size());
+}
+
+
+std::size_t Wordbreaker::findBreaks(std::u16string_view text,
+                                    const std::string& language,
+                                    BreakType* breaks,
+                                    std::size_t size)
+{
+    if (size < text.size())
+    {
+        ofLogError("Wordbreaker::findBreaks") << "The break buffer is too small.";
+        return 0;
+    }
+
+    setWordbreaks(text, language.data(), reinterpret_cast<char*>(breaks));
+
+    return text.size();
+}
+
+
+std::vector<Wordbreaker::BreakType> Wordbreaker::findBreaks(std::u32string_view text,
+                                                            const std::string& language)
+{
+    std::vector<Wordbreaker::BreakType> breaks;
+    findBreaks(text, language, breaks);
+    return breaks;
+}
+
+
+void Wordbreaker::findBreaks(std::u32string_view text,
+                             const std::string& language,
+                             std::vector<BreakType>& breaks)
+{
+    breaks.resize(text.size());
+    findBreaks(text, language, breaks.data(), breaks.size());
+}
+
+
+std::size_t Wordbreaker::findBreaks(std::u32string_view text,
+                                    const std::string& language,
+                                    BreakType* breaks,
+                                    std::size_t size)
+{
+    if (size < text.size())
+    {
+        ofLogError("Wordbreaker::findBreaks") << "The break buffer is too small.";
+        return 0;
+    }
+
+    setWordbreaks(text, language.data(), reinterpret_cast<char*>(breaks));
+
+    return text.size();
+}
+
+
+std::vector<Wordbreaker::Break> Wordbreaker::findBreakOffsets(std::string_view text) const
+{
+    return findBreakOffsets(text, _language);
+}
+
+
+std::vector<Wordbreaker::Break> Wordbreaker::findBreakOffsets(std::u16string_view text) const
+{
+    return findBreakOffsets(text, _language);
+}
+
+
+std::vector<Wordbreaker::Break> Wordbreaker::findBreakOffsets(std::u32string_view text) const
+{
+    return findBreakOffsets(text, _language);
+}
+
+
+std::vector<Wordbreaker::Break> Wordbreaker::findBreakOffsets(std::string_view text,
+                                                              const std::string& language)
+{
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+
+    setWordbreaks(text, language.data(), breaks);
+
+    return compactBreaks<Wordbreaker>(breaks, text.size());
+}
+
+
+std::vector<Wordbreaker::Break> Wordbreaker::findBreakOffsets(std::u16string_view text,
+                                                              const std::string& language)
+{
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+
+    setWordbreaks(text, language.data(), breaks);
+
+    return compactBreaks<Wordbreaker>(breaks, text.size());
+}
+
+
+std::vector<Wordbreaker::Break> Wordbreaker::findBreakOffsets(std::u32string_view text,
+                                                              const std::string& language)
+{
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+
+    setWordbreaks(text, language.data(), breaks);
+
+    return compactBreaks<Wordbreaker>(breaks, text.size());
+}
+
+
+PackedBreaks<Wordbreaker> Wordbreaker::findPackedBreaks(std::string_view text) const
+{
+    return findPackedBreaks(text, _language);
+}
+
+
+PackedBreaks<Wordbreaker> Wordbreaker::findPackedBreaks(std::u16string_view text) const
+{
+    return findPackedBreaks(text, _language);
+}
+
+
+PackedBreaks<Wordbreaker> Wordbreaker::findPackedBreaks(std::u32string_view text) const
+{
+    return findPackedBreaks(text, _language);
+}
+
+
+PackedBreaks<Wordbreaker> Wordbreaker::findPackedBreaks(std::string_view text,
+                                                        const std::string& language)
+{
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+
+    setWordbreaks(text, language.data(), breaks);
+
+    return PackedBreaks<Wordbreaker>(reinterpret_cast<const BreakType*>(breaks), text.size());
+}
+
+
+PackedBreaks<Wordbreaker> Wordbreaker::findPackedBreaks(std::u16string_view text,
+                                                        const std::string& language)
+{
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+
+    setWordbreaks(text, language.data(), breaks);
+
+    return PackedBreaks<Wordbreaker>(reinterpret_cast<const BreakType*>(breaks), text.size());
+}
+
+
+PackedBreaks<Wordbreaker> Wordbreaker::findPackedBreaks(std::u32string_view text,
+                                                        const std::string& language)
+{
+    BreakScratch scratch(text.size());
+    char* breaks = scratch.data();
+
+    setWordbreaks(text, language.data(), breaks);
+
+    return PackedBreaks<Wordbreaker>(reinterpret_cast<const BreakType*>(breaks), text.size());
+}
+
+
+namespace {
+
+
+/// \brief Segment a UTF-8 text with an already resolved tailoring.
+void segmentUTF8(std::string_view utf8,
+                 const LineBreakPropertiesLang* tailoring,
+                 Segmenter::Result& result,
+                 std::size_t checkpointInterval)
+{
+    checkpointInterval = std::max(std::size_t(1), checkpointInterval);
+
+    result.lineBreaks.resize(utf8.size());
+    result.wordBreaks.resize(utf8.size());
+    result.graphemeBreaks.resize(utf8.size());
+    result.checkpoints.clear();
+    result.checkpointInterval = checkpointInterval;
+    result.numCodepoints = 0;
+
+    if (utf8.empty())
+        return;
+
+    // Word breaking in libunibreak has no per-character interface, so the
+    // decoded code points are kept and broken in a second pass at the end.
+    std::u32string codepoints;
+    codepoints.reserve(utf8.size());
+
+    LineBreakContext context;
+    utf8proc_int32_t graphemeState = 0;
+    char32_t previous = 0;
+    std::size_t previousLast = 0;
+    std::size_t i = 0;
+
+    while (i < utf8.size())
+    {
+        std::size_t length = 0;
+        char32_t codepoint = nextUTF8Character(utf8, i, length);
+
+        if (codepoints.size() % checkpointInterval == 0)
+            result.checkpoints.push_back(i);
+
+        if (codepoints.empty())
+        {
+            initLinebreakContext(context, codepoint, tailoring);
+        }
+        else
+        {
+            // Both results belong to the last byte of the previous character.
+            result.lineBreaks[previousLast] = static_cast<Linebreaker::BreakType>(lb_process_next_char(&context, codepoint));
+            result.graphemeBreaks[previousLast] = utf8proc_grapheme_break_stateful(previous, codepoint, &graphemeState) ? 1 : 0;
+        }
+
+        for (std::size_t j = 0; j + 1 < length; ++j)
+        {
+            result.lineBreaks[i + j] = Linebreaker::BreakType::INSIDE_CHAR;
+            result.wordBreaks[i + j] = Wordbreaker::BreakType::INSIDE_CHAR;
+            result.graphemeBreaks[i + j] = 0;
+        }
+
+        codepoints.push_back(codepoint);
+        previous = codepoint;
+        previousLast = i + length - 1;
+        i += length;
+    }
+
+    // The end of the text is always a break.
+    result.lineBreaks[previousLast] = Linebreaker::BreakType::MUST_BREAK;
+    result.graphemeBreaks[previousLast] = 1;
+    result.numCodepoints = codepoints.size();
+
+    BreakScratch scratch(codepoints.size());
+    char* wordBreaks = scratch.data();
+
+    setWordbreaks(codepoints, linebreakLanguage(tailoring), wordBreaks);
+
+    // Scatter the per-code point word breaks to the last byte of each
+    // character.
+    std::size_t codepoint = 0;
+
+    for (std::size_t j = 0; j < utf8.size(); ++j)
+    {
+        if (result.lineBreaks[j] != Linebreaker::BreakType::INSIDE_CHAR)
+            result.wordBreaks[j] = static_cast<Wordbreaker::BreakType>(wordBreaks[codepoint++]);
+    }
+}
+
+
+} // namespace
+
+
+std::size_t Segmenter::Result::offsetOf(std::string_view utf8,
+                                       std::size_t index) const
+{
+    if (index >= numCodepoints || checkpointInterval == 0)
+        return utf8.size();
+
+    std::size_t checkpoint = index / checkpointInterval;
+
+    if (checkpoint >= checkpoints.size())
+        return utf8.size();
+
+    std::size_t offset = checkpoints[checkpoint];
+
+    for (std::size_t i = checkpoint * checkpointInterval; i < index && offset < utf8.size(); ++i)
+    {
+        std::size_t length = 0;
+        nextUTF8Character(utf8, offset, length);
+        offset += length;
+    }
+
+    return offset;
+}
+
+
+Segmenter::Segmenter(const std::string& language,
+                     std::size_t checkpointInterval):
+    _language(language),
+    _resolvedLanguage(resolveLinebreakLanguage(language)),
+    _checkpointInterval(std::max(std::size_t(1), checkpointInterval))
+{
+    initLinebreaks();
+    initWordbreaks();
+}
+
+
+Segmenter::~Segmenter()
+{
+}
+
+
+const std::string& Segmenter::language() const
+{
+    return _language;
+}
+
+
+std::size_t Segmenter::checkpointInterval() const
+{
+    return _checkpointInterval;
+}
+
+
+Segmenter::Result Segmenter::segment(std::string_view utf8) const
+{
+    Result result;
+    segmentUTF8(utf8, _resolvedLanguage, result, _checkpointInterval);
+    return result;
+}
+
+
+void Segmenter::segment(std::string_view utf8, Result& result) const
+{
+    segmentUTF8(utf8, _resolvedLanguage, result, _checkpointInterval);
+}
+
+
+Segmenter::Result Segmenter::segment(std::string_view utf8,
+                                     const std::string& language)
+{
+    Result result;
+    segment(utf8, language, result);
+    return result;
+}
+
+
+void Segmenter::segment(std::string_view utf8,
+                        const std::string& language,
+                        Result& result,
+                        std::size_t checkpointInterval)
+{
+    initLinebreaks();
+    initWordbreaks();
+    segmentUTF8(utf8, resolveLinebreakLanguage(language), result, checkpointInterval);
+}
+
+
+std::string UTF8::normalize(const std::string& utf8,
+                            Unicode::NormalizationForm form)
+{
+    utf8proc_uint8_t* retval = nullptr;
+
+    switch (form)
+    {
+        case Unicode::NormalizationForm::NFC:
+            retval = utf8proc_NFC(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
+            break;
+        case Unicode::NormalizationForm::NFD:
+            retval = utf8proc_NFD(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
+            break;
+        case Unicode::NormalizationForm::NFKC:
+            retval = utf8proc_NFKC(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
+            break;
+        case Unicode::NormalizationForm::NFKD:
+            retval = utf8proc_NFKD(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()));
+            break;
+    }
+
+    if (retval)
+    {
+        std::string out(reinterpret_cast<char*>(retval));
+        free(retval);
+        return out;
+    }
+
+    ofLogError("UTF8::normalize") << "Unable to normalize: " << utf8;
+    return utf8;
+}
+
+
+std::string UTF8::casefold(const std::string& utf8)
+{
+    utf8proc_uint8_t* retval = nullptr;
+    
+    utf8proc_ssize_t result = utf8proc_map(reinterpret_cast<const utf8proc_uint8_t*>(utf8.data()),
+                                           0,
+                                           &retval,
+                                           static_cast<utf8proc_option_t>(UTF8PROC_NULLTERM | UTF8PROC_STABLE | UTF8PROC_CASEFOLD));
+
+    if (result > 0)
+    {
+        std::string out(reinterpret_cast<char*>(retval), result);
+        free(retval);
+        return out;
+    }
+
+    ofLogError("UTF8::casefold") << "Unable to casefold: " << utf8;
+    return utf8;
+}
+
+
+bool UTF8::isValid(const std::string& txt)
+{
+    try
+    {
+        return utf8::is_valid(txt.begin(), txt.end());
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("UTF8::isValid") << utfcpp_ex.what();
+        return false;
+    }
+}
+
+
+bool UTF8::startsWithBOM(const std::string& txt)
+{
+    return utf8::starts_with_bom(txt.begin(), txt.end());
+}
+
+
+std::string UTF8::repair(const std::string& txt, char32_t replacement)
+{
+    std::string temp;
+
+    try
+    {
+        if (replacement == -1)
+        {
+            utf8::replace_invalid(txt.begin(), txt.end(), std::back_inserter(temp));
+        }
+        else
+        {
+            utf8::replace_invalid(txt.begin(), txt.end(), std::back_inserter(temp), replacement);
+        }
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("UTF8::repair") << utfcpp_ex.what();
+    }
+
+    return temp;
+}
+
+
+std::string& UTF8::repairInPlace(std::string& txt, char32_t replacement)
+{
+    txt = repair(txt, replacement);
+    return txt;
+}
+
+
+std::size_t UTF8::distance(const std::string& txt)
+{
+    try
+    {
+        return utf8::distance(txt.begin(), txt.end());
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("ofUTF8::distance") << utfcpp_ex.what();
+        return 0;
+    }
+}
+
+
+int UTF8::icompare(const std::string& utf8String0,
+                   const std::string& utf8String1)
+{
+    // Get correct pointers.
+    const utf8proc_uint8_t* s0 = reinterpret_cast<const utf8proc_uint8_t*>(utf8String0.data());
+    const utf8proc_uint8_t* s1 = reinterpret_cast<const utf8proc_uint8_t*>(utf8String1.data());
+
+    // Normalize and casefold.
+    utf8proc_option_t flags = static_cast<utf8proc_option_t>(UTF8PROC_NULLTERM | UTF8PROC_STABLE | UTF8PROC_CASEFOLD | UTF8PROC_COMPOSE);
+    utf8proc_uint8_t* _s0 = nullptr;
+    utf8proc_uint8_t* _s1 = nullptr;
+
+    utf8proc_map(s0, 0, &_s0, flags);
+    utf8proc_map(s1, 0, &_s1, flags);
+
+    int result = 0;
+    bool success = false;
+
+    if (_s0 && _s1)
+    {
+        result = std::strcmp(reinterpret_cast<const char*>(_s0),
+                             reinterpret_cast<const char*>(_s1));
+        success = true;
+    }
+
+    free(_s0);
+    free(_s1);
+
+    if (!success)
+    {
+        ofLogError("UTF8::icompare") << "Unable to compare: " << utf8String0 << " and " << utf8String1;
+    }
+
+    return result;
+}
+
+
+std::string UTF8::toUpper(const std::string& str)
+{
+    return UTF32::toUTF8(UTF32::toUpper(toUTF32(str)));
+}
+
+
+std::string& UTF8::toUpperInPlace(std::string& str)
+{
+    str = toUpper(str);
+    return str;
+}
+
+
+std::string UTF8::toLower(const std::string& str)
+{
+    return UTF32::toUTF8(UTF32::toLower(toUTF32(str)));
+}
+
+
+std::string& UTF8::toLowerInPlace(std::string& str)
+{
+    str = toLower(str);
+    return str;
+}
+
+
+std::u16string UTF8::toUTF16(const std::string& input)
+{
+    std::u16string utf16result;
+
+    try
+    {
+        utf8::utf8to16(input.begin(),
+                       input.end(),
+                       std::back_inserter(utf16result));
+
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("TextConverter::toUTF16") << utfcpp_ex.what();
+    }
+
+    return utf16result;
+}
+
+
+
+std::u32string UTF8::toUTF32(const std::string& input)
+{
+    std::u32string utf32result;
+
+    try
+    {
+        utf8::utf8to32(input.begin(),
+                       input.end(),
+                       std::back_inserter(utf32result));
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("TextConverter::toUTF32") << utfcpp_ex.what();
+    }
+
+    return utf32result;
+}
+
+
+std::string UTF16::toUTF8(const std::u16string& input)
+{
+    std::string utf8result;
+
+    try
+    {
+        utf8::utf16to8(input.begin(), input.end(), std::back_inserter(utf8result));
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("TextConverter::toUTF8") << utfcpp_ex.what();
+    }
+
+    return utf8result;
+}
+
+
+    
+std::u32string UTF16::toUTF32(const std::u16string& input)
+{
+    return UTF8::toUTF32(toUTF8(input));
+}
+
+
+bool UTF32::isValid(char32_t unichar)
+{
+    return !((unichar > 0x0010ffffu) || (unichar >= 0xd800u && unichar <= 0xdfffu));
+}
+
+
+bool UTF32::isAssigned(char32_t unichar)
+{
+    return ucdn_get_general_category(unichar) != UCDN_GENERAL_CATEGORY_CN;
+}
+
+
+bool UTF32::isPrintable(char32_t unichar)
+{
+    // aka is graphic.
+    int category = ucdn_get_general_category(unichar);
+
+    return category != UCDN_GENERAL_CATEGORY_CC
+        && category != UCDN_GENERAL_CATEGORY_CF
+        && category != UCDN_GENERAL_CATEGORY_CN
+        && category != UCDN_GENERAL_CATEGORY_CO
+        && category != UCDN_GENERAL_CATEGORY_CS
+        && category != UCDN_GENERAL_CATEGORY_ZL
+        && category != UCDN_GENERAL_CATEGORY_ZP;
+}
+
+
+bool UTF32::isControl(char32_t unichar)
+{
+    // True if unichar is:
+    //    ISO 8-bit control character (U+0000..U+001f and U+007f..U+009f)
+    //    U_CONTROL_CHAR (Cc)
+    //    U_FORMAT_CHAR (Cf)
+    //    U_LINE_SEPARATOR (Zl)
+    //    U_PARAGRAPH_SEPARATOR (Zp)
+    // This definition shared with ICU's isCntrl function
+    // https://ssl.icu-project.org/apiref/icu4c/uchar_8h.html
+
+    if ((unichar <= 0x001F) || (unichar >= 0x007F && unichar <= 0x009F))
+    {
+        return true;
+    }
+    else
+    {
+        int category = ucdn_get_general_category(unichar);
+
+        return category == UCDN_GENERAL_CATEGORY_CC
+            || category == UCDN_GENERAL_CATEGORY_CF
+            || category == UCDN_GENERAL_CATEGORY_ZL
+            || category == UCDN_GENERAL_CATEGORY_ZP;
+    }
+}
+
+
+bool UTF32::isTitle(char32_t unichar)
+{
+    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_LT;
+}
+
+
+bool UTF32::isSpace(char32_t unichar)
+{
+    int category = ucdn_get_general_category(unichar);
+
+    return category == UCDN_GENERAL_CATEGORY_ZS
+        || category == UCDN_GENERAL_CATEGORY_ZL
+        || category == UCDN_GENERAL_CATEGORY_ZP;
+}
+
+
+bool UTF32::isDigit(char32_t unichar)
+{
+    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_ND;
+}
+
+
+bool UTF32::isPunct(char32_t unichar)
+{
+    int category = ucdn_get_general_category(unichar);
+
+    return category == UCDN_GENERAL_CATEGORY_PC
+        || category == UCDN_GENERAL_CATEGORY_PD
+        || category == UCDN_GENERAL_CATEGORY_PE
+        || category == UCDN_GENERAL_CATEGORY_PF
+        || category == UCDN_GENERAL_CATEGORY_PI
+        || category == UCDN_GENERAL_CATEGORY_PO
+        || category == UCDN_GENERAL_CATEGORY_PS;
+}
+
+
+bool UTF32::isAlpha(char32_t unichar)
+{
+    int category = ucdn_get_general_category(unichar);
+
+    return category == UCDN_GENERAL_CATEGORY_LL
+        || category == UCDN_GENERAL_CATEGORY_LM
+        || category == UCDN_GENERAL_CATEGORY_LO
+        || category == UCDN_GENERAL_CATEGORY_LT
+        || category == UCDN_GENERAL_CATEGORY_LU;
+}
+
+
+bool UTF32::isAlphaNumeric(char32_t unichar)
+{
+    int category = ucdn_get_general_category(unichar);
+
+    return category == UCDN_GENERAL_CATEGORY_ND // digit
+        || category == UCDN_GENERAL_CATEGORY_LL
+        || category == UCDN_GENERAL_CATEGORY_LM
+        || category == UCDN_GENERAL_CATEGORY_LO
+        || category == UCDN_GENERAL_CATEGORY_LT
+        || category == UCDN_GENERAL_CATEGORY_LU;
+}
+
+
+bool UTF32::isLower(char32_t unichar)
+{
+    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_LL;
+}
+
+
+bool UTF32::isUpper(char32_t unichar)
+{
+    return ucdn_get_general_category(unichar) == UCDN_GENERAL_CATEGORY_LU;
+}
+
+
+char32_t UTF32::toLower(char32_t unichar)
+{
+    return utf8proc_tolower(unichar);
+}
+
+
+char32_t UTF32::toUpper(char32_t unichar)
+{
+    return utf8proc_toupper(unichar);
+}
+
+
+char32_t& UTF32::toLowerInPlace(char32_t& unichar)
+{
+    unichar = toLower(unichar); 
+    return unichar;
+}
+
+
+char32_t& UTF32::toUpperInPlace(char32_t& unichar)
+{
+    unichar = toUpper(unichar); 
+    return unichar;
+}
+
+
+std::u32string UTF32::toLower(const std::u32string& unichar)
+{
+    std::u32string out;
+    auto it = unichar.cbegin();
+    while (it != unichar.end()) {out.push_back(toLower(*(it++)));}
+    return out;
+}
+
+
+std::u32string UTF32::toUpper(const std::u32string& unichar)
+{
+    std::u32string out;
+    auto it = unichar.cbegin();
+    while (it != unichar.end()) {out.push_back(toUpper(*(it++)));}
+    return out;
+}
+
+
+std::u32string& UTF32::toLowerInPlace(std::u32string& unichar)
+{
+    auto it = unichar.begin();
+    while (it != unichar.end()) {toUpperInPlace(*(it++));}
+    return unichar;
+}
+
+
+std::u32string& UTF32::toUpperInPlace(std::u32string& unichar)
+{
+    auto it = unichar.begin();
+    while (it != unichar.end()) {toLowerInPlace(*(it++));}
+    return unichar;
+}
+
+
+std::string UTF32::toUTF8(char32_t input)
+{
+    std::string txt;
+
+    try
+    {
+        utf8::append(input, std::back_inserter(txt));
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("TextConverter::toUTF8") << utfcpp_ex.what();
+    }
+    return txt;
+}
+
+
+std::string UTF32::toUTF8(const std::u32string& input)
+{
+    std::string utf8result;
+
+    try
+    {
+        utf8::utf32to8(input.begin(), input.end(), std::back_inserter(utf8result));
+    }
+    catch (const utf8::exception& utfcpp_ex)
+    {
+        ofLogError("TextConverter::toUTF8") << utfcpp_ex.what();
+    }
+
+    return utf8result;
+}
+
+
+std::u16string UTF32::toUTF16(char32_t input)
+{
+    return UTF8::toUTF16(toUTF8(input));
+}
+
+
+std::u16string UTF32::toUTF16(const std::u32string& input)
+{
+    return UTF8::toUTF16(toUTF8(input));
+}
+
+
+#include <iconv.h>
+
+
+namespace {
+
+
+const iconv_t INVALID_CD = (iconv_t) - 1;
+const std::size_t INVALID_CONVERSION = (std::size_t) - 1;
+
+/// \brief The longest character of a stateless encoding in bytes.
+const std::size_t MAX_CHARACTER_SIZE = 4;
+
+/// \brief The most output of a few bytes of input, including shift
+///        sequences.
+const std::size_t MAX_PREFIX_OUTPUT_SIZE = 32;
+
+
+} // namespace
+
+
+const std::string TextConverter::ENCODING_ASCII = "ASCII";
+const std::string TextConverter::ENCODING_UTF8 = "UTF-8";
+const std::string TextConverter::ENCODING_UTF16 = "UTF-16";
+const std::string TextConverter::ENCODING_UTF32 = "UTF-32";
+const std::string TextConverter::ENCODING_ISO_8859_1 = "ISO-8859-1";
+const std::string TextConverter::ENCODING_LATIN_1 = ENCODING_ISO_8859_1;
+const std::string TextConverter::ENCODING_ISO_8859_2 = "ISO-8859-2";
+const std::string TextConverter::ENCODING_LATIN_2 = ENCODING_ISO_8859_2;
+const std::string TextConverter::ENCODING_ISO_8859_15 = "ISO-8859-15";
+const std::string TextConverter::ENCODING_LATIN_9 = ENCODING_ISO_8859_15;
+const std::string TextConverter::ENCODING_WINDOWS_1250 = "windows-1250";
+const std::string TextConverter::ENCODING_WINDOWS_1251 = "windows-1251";
+const std::string TextConverter::ENCODING_WINDOWS_1252 = "windows-1252";
+
+
+namespace {
+
+
+/// \brief Normalize an encoding name for comparison.
+///
+/// Names are compared without case and without the punctuation that iconv
+/// ignores, so that "UTF-8", "utf8" and "Utf_8" share one entry.
+std::string normalizeEncodingName(const std::string& name)
+{
+    std::string normalized;
+    normalized.reserve(name.size());
+
+    for (char c: name)
+    {
+        if (c == '-' || c == '_' || c == ' ' || c == '.' || c == ':')
+            continue;
+
+        normalized += (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+    }
+
+    return normalized;
+}
+
+
+// BEGIN GENERATED SINGLE BYTE TABLES
+const char16_t ASCII_DECODE[] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+};
+
+const uint32_t ASCII_ENCODE[] = {
+    0x000000,
+};
+
+
+const char16_t ISO_8859_1_DECODE[] = {
+    0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087,
+    0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,
+    0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097,
+    0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,
+    0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+    0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+    0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+    0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+    0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+    0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+    0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+    0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+    0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF,
+};
+
+const uint32_t ISO_8859_1_ENCODE[] = {
+    0x008080, 0x008181, 0x008282, 0x008383, 0x008484, 0x008585, 0x008686, 0x008787,
+    0x008888, 0x008989, 0x008A8A, 0x008B8B, 0x008C8C, 0x008D8D, 0x008E8E, 0x008F8F,
+    0x009090, 0x009191, 0x009292, 0x009393, 0x009494, 0x009595, 0x009696, 0x009797,
+    0x009898, 0x009999, 0x009A9A, 0x009B9B, 0x009C9C, 0x009D9D, 0x009E9E, 0x009F9F,
+    0x00A0A0, 0x00A1A1, 0x00A2A2, 0x00A3A3, 0x00A4A4, 0x00A5A5, 0x00A6A6, 0x00A7A7,
+    0x00A8A8, 0x00A9A9, 0x00AAAA, 0x00ABAB, 0x00ACAC, 0x00ADAD, 0x00AEAE, 0x00AFAF,
+    0x00B0B0, 0x00B1B1, 0x00B2B2, 0x00B3B3, 0x00B4B4, 0x00B5B5, 0x00B6B6, 0x00B7B7,
+    0x00B8B8, 0x00B9B9, 0x00BABA, 0x00BBBB, 0x00BCBC, 0x00BDBD, 0x00BEBE, 0x00BFBF,
+    0x00C0C0, 0x00C1C1, 0x00C2C2, 0x00C3C3, 0x00C4C4, 0x00C5C5, 0x00C6C6, 0x00C7C7,
+    0x00C8C8, 0x00C9C9, 0x00CACA, 0x00CBCB, 0x00CCCC, 0x00CDCD, 0x00CECE, 0x00CFCF,
+    0x00D0D0, 0x00D1D1, 0x00D2D2, 0x00D3D3, 0x00D4D4, 0x00D5D5, 0x00D6D6, 0x00D7D7,
+    0x00D8D8, 0x00D9D9, 0x00DADA, 0x00DBDB, 0x00DCDC, 0x00DDDD, 0x00DEDE, 0x00DFDF,
+    0x00E0E0, 0x00E1E1, 0x00E2E2, 0x00E3E3, 0x00E4E4, 0x00E5E5, 0x00E6E6, 0x00E7E7,
+    0x00E8E8, 0x00E9E9, 0x00EAEA, 0x00EBEB, 0x00ECEC, 0x00EDED, 0x00EEEE, 0x00EFEF,
+    0x00F0F0, 0x00F1F1, 0x00F2F2, 0x00F3F3, 0x00F4F4, 0x00F5F5, 0x00F6F6, 0x00F7F7,
+    0x00F8F8, 0x00F9F9, 0x00FAFA, 0x00FBFB, 0x00FCFC, 0x00FDFD, 0x00FEFE, 0x00FFFF,
+};
+
+
+const char16_t ISO_8859_2_DECODE[] = {
+    0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087,
+    0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,
+    0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097,
+    0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,
+    0x00A0, 0x0104, 0x02D8, 0x0141, 0x00A4, 0x013D, 0x015A, 0x00A7,
+    0x00A8, 0x0160, 0x015E, 0x0164, 0x0179, 0x00AD, 0x017D, 0x017B,
+    0x00B0, 0x0105, 0x02DB, 0x0142, 0x00B4, 0x013E, 0x015B, 0x02C7,
+    0x00B8, 0x0161, 0x015F, 0x0165, 0x017A, 0x02DD, 0x017E, 0x017C,
+    0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7,
+    0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E,
+    0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7,
+    0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF,
+    0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7,
+    0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F,
+    0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7,
+    0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9,
+};
+
+const uint32_t ISO_8859_2_ENCODE[] = {
+    0x008080, 0x008181, 0x008282, 0x008383, 0x008484, 0x008585, 0x008686, 0x008787,
+    0x008888, 0x008989, 0x008A8A, 0x008B8B, 0x008C8C, 0x008D8D, 0x008E8E, 0x008F8F,
+    0x009090, 0x009191, 0x009292, 0x009393, 0x009494, 0x009595, 0x009696, 0x009797,
+    0x009898, 0x009999, 0x009A9A, 0x009B9B, 0x009C9C, 0x009D9D, 0x009E9E, 0x009F9F,
+    0x00A0A0, 0x00A4A4, 0x00A7A7, 0x00A8A8, 0x00ADAD, 0x00B0B0, 0x00B4B4, 0x00B8B8,
+    0x00C1C1, 0x00C2C2, 0x00C4C4, 0x00C7C7, 0x00C9C9, 0x00CBCB, 0x00CDCD, 0x00CECE,
+    0x00D3D3, 0x00D4D4, 0x00D6D6, 0x00D7D7, 0x00DADA, 0x00DCDC, 0x00DDDD, 0x00DFDF,
+    0x00E1E1, 0x00E2E2, 0x00E4E4, 0x00E7E7, 0x00E9E9, 0x00EBEB, 0x00EDED, 0x00EEEE,
+    0x00F3F3, 0x00F4F4, 0x00F6F6, 0x00F7F7, 0x00FAFA, 0x00FCFC, 0x00FDFD, 0x0102C3,
+    0x0103E3, 0x0104A1, 0x0105B1, 0x0106C6, 0x0107E6, 0x010CC8, 0x010DE8, 0x010ECF,
+    0x010FEF, 0x0110D0, 0x0111F0, 0x0118CA, 0x0119EA, 0x011ACC, 0x011BEC, 0x0139C5,
+    0x013AE5, 0x013DA5, 0x013EB5, 0x0141A3, 0x0142B3, 0x0143D1, 0x0144F1, 0x0147D2,
+    0x0148F2, 0x0150D5, 0x0151F5, 0x0154C0, 0x0155E0, 0x0158D8, 0x0159F8, 0x015AA6,
+    0x015BB6, 0x015EAA, 0x015FBA, 0x0160A9, 0x0161B9, 0x0162DE, 0x0163FE, 0x0164AB,
+    0x0165BB, 0x016ED9, 0x016FF9, 0x0170DB, 0x0171FB, 0x0179AC, 0x017ABC, 0x017BAF,
+    0x017CBF, 0x017DAE, 0x017EBE, 0x02C7B7, 0x02D8A2, 0x02D9FF, 0x02DBB2, 0x02DDBD,
+};
+
+
+const char16_t ISO_8859_15_DECODE[] = {
+    0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087,
+    0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,
+    0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097,
+    0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,
+    0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x20AC, 0x00A5, 0x0160, 0x00A7,
+    0x0161, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x017D, 0x00B5, 0x00B6, 0x00B7,
+    0x017E, 0x00B9, 0x00BA, 0x00BB, 0x0152, 0x0153, 0x0178, 0x00BF,
+    0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+    0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+    0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+    0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+    0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+    0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+    0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+    0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF,
+};
+
+const uint32_t ISO_8859_15_ENCODE[] = {
+    0x008080, 0x008181, 0x008282, 0x008383, 0x008484, 0x008585, 0x008686, 0x008787,
+    0x008888, 0x008989, 0x008A8A, 0x008B8B, 0x008C8C, 0x008D8D, 0x008E8E, 0x008F8F,
+    0x009090, 0x009191, 0x009292, 0x009393, 0x009494, 0x009595, 0x009696, 0x009797,
+    0x009898, 0x009999, 0x009A9A, 0x009B9B, 0x009C9C, 0x009D9D, 0x009E9E, 0x009F9F,
+    0x00A0A0, 0x00A1A1, 0x00A2A2, 0x00A3A3, 0x00A5A5, 0x00A7A7, 0x00A9A9, 0x00AAAA,
+    0x00ABAB, 0x00ACAC, 0x00ADAD, 0x00AEAE, 0x00AFAF, 0x00B0B0, 0x00B1B1, 0x00B2B2,
+    0x00B3B3, 0x00B5B5, 0x00B6B6, 0x00B7B7, 0x00B9B9, 0x00BABA, 0x00BBBB, 0x00BFBF,
+    0x00C0C0, 0x00C1C1, 0x00C2C2, 0x00C3C3, 0x00C4C4, 0x00C5C5, 0x00C6C6, 0x00C7C7,
+    0x00C8C8, 0x00C9C9, 0x00CACA, 0x00CBCB, 0x00CCCC, 0x00CDCD, 0x00CECE, 0x00CFCF,
+    0x00D0D0, 0x00D1D1, 0x00D2D2, 0x00D3D3, 0x00D4D4, 0x00D5D5, 0x00D6D6, 0x00D7D7,
+    0x00D8D8, 0x00D9D9, 0x00DADA, 0x00DBDB, 0x00DCDC, 0x00DDDD, 0x00DEDE, 0x00DFDF,
+    0x00E0E0, 0x00E1E1, 0x00E2E2, 0x00E3E3, 0x00E4E4, 0x00E5E5, 0x00E6E6, 0x00E7E7,
+    0x00E8E8, 0x00E9E9, 0x00EAEA, 0x00EBEB, 0x00ECEC, 0x00EDED, 0x00EEEE, 0x00EFEF,
+    0x00F0F0, 0x00F1F1, 0x00F2F2, 0x00F3F3, 0x00F4F4, 0x00F5F5, 0x00F6F6, 0x00F7F7,
+    0x00F8F8, 0x00F9F9, 0x00FAFA, 0x00FBFB, 0x00FCFC, 0x00FDFD, 0x00FEFE, 0x00FFFF,
+    0x0152BC, 0x0153BD, 0x0160A6, 0x0161A8, 0x0178BE, 0x017DB4, 0x017EB8, 0x20ACA4,
+};
+
+
+const char16_t WINDOWS_1250_DECODE[] = {
+    0x20AC, 0x0000, 0x201A, 0x0000, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x0000, 0x2030, 0x0160, 0x2039, 0x015A, 0x0164, 0x017D, 0x0179,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x0000, 0x2122, 0x0161, 0x203A, 0x015B, 0x0165, 0x017E, 0x017A,
+    0x00A0, 0x02C7, 0x02D8, 0x0141, 0x00A4, 0x0104, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x015E, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x017B,
+    0x00B0, 0x00B1, 0x02DB, 0x0142, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00B8, 0x0105, 0x015F, 0x00BB, 0x013D, 0x02DD, 0x013E, 0x017C,
+    0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7,
+    0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E,
+    0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7,
+    0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF,
+    0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7,
+    0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F,
+    0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7,
+    0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9,
+};
+
+const uint32_t WINDOWS_1250_ENCODE[] = {
+    0x00A0A0, 0x00A4A4, 0x00A6A6, 0x00A7A7, 0x00A8A8, 0x00A9A9, 0x00ABAB, 0x00ACAC,
+    0x00ADAD, 0x00AEAE, 0x00B0B0, 0x00B1B1, 0x00B4B4, 0x00B5B5, 0x00B6B6, 0x00B7B7,
+    0x00B8B8, 0x00BBBB, 0x00C1C1, 0x00C2C2, 0x00C4C4, 0x00C7C7, 0x00C9C9, 0x00CBCB,
+    0x00CDCD, 0x00CECE, 0x00D3D3, 0x00D4D4, 0x00D6D6, 0x00D7D7, 0x00DADA, 0x00DCDC,
+    0x00DDDD, 0x00DFDF, 0x00E1E1, 0x00E2E2, 0x00E4E4, 0x00E7E7, 0x00E9E9, 0x00EBEB,
+    0x00EDED, 0x00EEEE, 0x00F3F3, 0x00F4F4, 0x00F6F6, 0x00F7F7, 0x00FAFA, 0x00FCFC,
+    0x00FDFD, 0x0102C3, 0x0103E3, 0x0104A5, 0x0105B9, 0x0106C6, 0x0107E6, 0x010CC8,
+    0x010DE8, 0x010ECF, 0x010FEF, 0x0110D0, 0x0111F0, 0x0118CA, 0x0119EA, 0x011ACC,
+    0x011BEC, 0x0139C5, 0x013AE5, 0x013DBC, 0x013EBE, 0x0141A3, 0x0142B3, 0x0143D1,
+    0x0144F1, 0x0147D2, 0x0148F2, 0x0150D5, 0x0151F5, 0x0154C0, 0x0155E0, 0x0158D8,
+    0x0159F8, 0x015A8C, 0x015B9C, 0x015EAA, 0x015FBA, 0x01608A, 0x01619A, 0x0162DE,
+    0x0163FE, 0x01648D, 0x01659D, 0x016ED9, 0x016FF9, 0x0170DB, 0x0171FB, 0x01798F,
+    0x017A9F, 0x017BAF, 0x017CBF, 0x017D8E, 0x017E9E, 0x02C7A1, 0x02D8A2, 0x02D9FF,
+    0x02DBB2, 0x02DDBD, 0x201396, 0x201497, 0x201891, 0x201992, 0x201A82, 0x201C93,
+    0x201D94, 0x201E84, 0x202086, 0x202187, 0x202295, 0x202685, 0x203089, 0x20398B,
+    0x203A9B, 0x20AC80, 0x212299,
+};
+
+
+const char16_t WINDOWS_1251_DECODE[] = {
+    0x0402, 0x0403, 0x201A, 0x0453, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x20AC, 0x2030, 0x0409, 0x2039, 0x040A, 0x040C, 0x040B, 0x040F,
+    0x0452, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x0000, 0x2122, 0x0459, 0x203A, 0x045A, 0x045C, 0x045B, 0x045F,
+    0x00A0, 0x040E, 0x045E, 0x0408, 0x00A4, 0x0490, 0x00A6, 0x00A7,
+    0x0401, 0x00A9, 0x0404, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x0407,
+    0x00B0, 0x00B1, 0x0406, 0x0456, 0x0491, 0x00B5, 0x00B6, 0x00B7,
+    0x0451, 0x2116, 0x0454, 0x00BB, 0x0458, 0x0405, 0x0455, 0x0457,
+    0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+    0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E, 0x041F,
+    0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+    0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F,
+    0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+    0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E, 0x043F,
+    0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+    0x0448, 0x0449, 0x044A, 0x044B, 0x044C, 0x044D, 0x044E, 0x044F,
+};
+
+const uint32_t WINDOWS_1251_ENCODE[] = {
+    0x00A0A0, 0x00A4A4, 0x00A6A6, 0x00A7A7, 0x00A9A9, 0x00ABAB, 0x00ACAC, 0x00ADAD,
+    0x00AEAE, 0x00B0B0, 0x00B1B1, 0x00B5B5, 0x00B6B6, 0x00B7B7, 0x00BBBB, 0x0401A8,
+    0x040280, 0x040381, 0x0404AA, 0x0405BD, 0x0406B2, 0x0407AF, 0x0408A3, 0x04098A,
+    0x040A8C, 0x040B8E, 0x040C8D, 0x040EA1, 0x040F8F, 0x0410C0, 0x0411C1, 0x0412C2,
+    0x0413C3, 0x0414C4, 0x0415C5, 0x0416C6, 0x0417C7, 0x0418C8, 0x0419C9, 0x041ACA,
+    0x041BCB, 0x041CCC, 0x041DCD, 0x041ECE, 0x041FCF, 0x0420D0, 0x0421D1, 0x0422D2,
+    0x0423D3, 0x0424D4, 0x0425D5, 0x0426D6, 0x0427D7, 0x0428D8, 0x0429D9, 0x042ADA,
+    0x042BDB, 0x042CDC, 0x042DDD, 0x042EDE, 0x042FDF, 0x0430E0, 0x0431E1, 0x0432E2,
+    0x0433E3, 0x0434E4, 0x0435E5, 0x0436E6, 0x0437E7, 0x0438E8, 0x0439E9, 0x043AEA,
+    0x043BEB, 0x043CEC, 0x043DED, 0x043EEE, 0x043FEF, 0x0440F0, 0x0441F1, 0x0442F2,
+    0x0443F3, 0x0444F4, 0x0445F5, 0x0446F6, 0x0447F7, 0x0448F8, 0x0449F9, 0x044AFA,
+    0x044BFB, 0x044CFC, 0x044DFD, 0x044EFE, 0x044FFF, 0x0451B8, 0x045290, 0x045383,
+    0x0454BA, 0x0455BE, 0x0456B3, 0x0457BF, 0x0458BC, 0x04599A, 0x045A9C, 0x045B9E,
+    0x045C9D, 0x045EA2, 0x045F9F, 0x0490A5, 0x0491B4, 0x201396, 0x201497, 0x201891,
+    0x201992, 0x201A82, 0x201C93, 0x201D94, 0x201E84, 0x202086, 0x202187, 0x202295,
+    0x202685, 0x203089, 0x20398B, 0x203A9B, 0x20AC88, 0x2116B9, 0x212299,
+};
+
+
+const char16_t WINDOWS_1252_DECODE[] = {
+    0x20AC, 0x0000, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x017D, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x0000, 0x017E, 0x0178,
+    0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+    0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+    0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+    0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+    0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+    0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+    0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+    0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+    0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF,
+};
+
+const uint32_t WINDOWS_1252_ENCODE[] = {
+    0x00A0A0, 0x00A1A1, 0x00A2A2, 0x00A3A3, 0x00A4A4, 0x00A5A5, 0x00A6A6, 0x00A7A7,
+    0x00A8A8, 0x00A9A9, 0x00AAAA, 0x00ABAB, 0x00ACAC, 0x00ADAD, 0x00AEAE, 0x00AFAF,
+    0x00B0B0, 0x00B1B1, 0x00B2B2, 0x00B3B3, 0x00B4B4, 0x00B5B5, 0x00B6B6, 0x00B7B7,
+    0x00B8B8, 0x00B9B9, 0x00BABA, 0x00BBBB, 0x00BCBC, 0x00BDBD, 0x00BEBE, 0x00BFBF,
+    0x00C0C0, 0x00C1C1, 0x00C2C2, 0x00C3C3, 0x00C4C4, 0x00C5C5, 0x00C6C6, 0x00C7C7,
+    0x00C8C8, 0x00C9C9, 0x00CACA, 0x00CBCB, 0x00CCCC, 0x00CDCD, 0x00CECE, 0x00CFCF,
+    0x00D0D0, 0x00D1D1, 0x00D2D2, 0x00D3D3, 0x00D4D4, 0x00D5D5, 0x00D6D6, 0x00D7D7,
+    0x00D8D8, 0x00D9D9, 0x00DADA, 0x00DBDB, 0x00DCDC, 0x00DDDD, 0x00DEDE, 0x00DFDF,
+    0x00E0E0, 0x00E1E1, 0x00E2E2, 0x00E3E3, 0x00E4E4, 0x00E5E5, 0x00E6E6, 0x00E7E7,
+    0x00E8E8, 0x00E9E9, 0x00EAEA, 0x00EBEB, 0x00ECEC, 0x00EDED, 0x00EEEE, 0x00EFEF,
+    0x00F0F0, 0x00F1F1, 0x00F2F2, 0x00F3F3, 0x00F4F4, 0x00F5F5, 0x00F6F6, 0x00F7F7,
+    0x00F8F8, 0x00F9F9, 0x00FAFA, 0x00FBFB, 0x00FCFC, 0x00FDFD, 0x00FEFE, 0x00FFFF,
+    0x01528C, 0x01539C, 0x01608A, 0x01619A, 0x01789F, 0x017D8E, 0x017E9E, 0x019283,
+    0x02C688, 0x02DC98, 0x201396, 0x201497, 0x201891, 0x201992, 0x201A82, 0x201C93,
+    0x201D94, 0x201E84, 0x202086, 0x202187, 0x202295, 0x202685, 0x203089, 0x20398B,
+    0x203A9B, 0x20AC80, 0x212299,
+};
+// END GENERATED SINGLE BYTE TABLES
+
+
+} // namespace
+
+
+/// \brief A built-in codec for UTF-8 or a single-byte character set.
+struct NativeCodec
+{
+    /// \brief Decode table for bytes 0x80-0xFF, or nullptr for UTF-8.
+    const char16_t* decode;
+
+    /// \brief Sorted (codepoint << 8) | byte encode entries.
+    const uint32_t* encodeBegin;
+
+    /// \brief The end of the encode entries.
+    const uint32_t* encodeEnd;
+};
+
+
+namespace {
+
+
+#define NATIVE_SINGLE_BYTE_CODEC(NAME) { NAME##_DECODE, std::begin(NAME##_ENCODE), std::end(NAME##_ENCODE) }
+
+const NativeCodec NATIVE_CODECS[] = {
+    { nullptr, nullptr, nullptr },
+    NATIVE_SINGLE_BYTE_CODEC(ASCII),
+    NATIVE_SINGLE_BYTE_CODEC(ISO_8859_1),
+    NATIVE_SINGLE_BYTE_CODEC(ISO_8859_2),
+    NATIVE_SINGLE_BYTE_CODEC(ISO_8859_15),
+    NATIVE_SINGLE_BYTE_CODEC(WINDOWS_1250),
+    NATIVE_SINGLE_BYTE_CODEC(WINDOWS_1251),
+    NATIVE_SINGLE_BYTE_CODEC(WINDOWS_1252)
+};
+
+#undef NATIVE_SINGLE_BYTE_CODEC
+
+
+/// \brief The normalized names of the built-in codecs.
+const std::pair<const char*, const NativeCodec*> NATIVE_CODEC_NAMES[] = {
+    { "utf8", &NATIVE_CODECS[0] },
+    { "ascii", &NATIVE_CODECS[1] },
+    { "usascii", &NATIVE_CODECS[1] },
+    { "iso88591", &NATIVE_CODECS[2] },
+    { "latin1", &NATIVE_CODECS[2] },
+    { "l1", &NATIVE_CODECS[2] },
+    { "iso88592", &NATIVE_CODECS[3] },
+    { "latin2", &NATIVE_CODECS[3] },
+    { "l2", &NATIVE_CODECS[3] },
+    { "iso885915", &NATIVE_CODECS[4] },
+    { "latin9", &NATIVE_CODECS[4] },
+    { "l9", &NATIVE_CODECS[4] },
+    { "windows1250", &NATIVE_CODECS[5] },
+    { "cp1250", &NATIVE_CODECS[5] },
+    { "windows1251", &NATIVE_CODECS[6] },
+    { "cp1251", &NATIVE_CODECS[6] },
+    { "windows1252", &NATIVE_CODECS[7] },
+    { "cp1252", &NATIVE_CODECS[7] }
+};
+
+
+/// \brief Find the built-in codec for an encoding name.
+/// \returns the codec or nullptr if there is none.
+const NativeCodec* findNativeCodec(const std::string& encoding)
+{
+    std::string name = normalizeEncodingName(encoding);
+
+    for (const auto& entry: NATIVE_CODEC_NAMES)
+        if (name == entry.first)
+            return entry.second;
+
+    return nullptr;
+}
+
+
+/// \brief The number of bytes an encoding uses for the code points below
+///        0x80, 0x800, 0x10000 and 0x110000.
+struct EncodingWidths
+{
+    /// \brief The fewest bytes in each range, 0 if it cannot be encoded.
+    uint8_t min[4];
+
+    /// \brief The most bytes in each range, 0 if it cannot be encoded.
+    uint8_t max[4];
+};
+
+
+const EncodingWidths UTF8_WIDTHS = { { 1, 2, 3, 4 }, { 1, 2, 3, 4 } };
+const EncodingWidths UTF16_WIDTHS = { { 2, 2, 2, 4 }, { 2, 2, 2, 4 } };
+const EncodingWidths UTF32_WIDTHS = { { 4, 4, 4, 4 }, { 4, 4, 4, 4 } };
+const EncodingWidths UCS2_WIDTHS = { { 2, 2, 2, 0 }, { 2, 2, 2, 0 } };
+const EncodingWidths SINGLE_BYTE_WIDTHS = { { 1, 1, 1, 0 }, { 1, 1, 1, 0 } };
+const EncodingWidths UNKNOWN_WIDTHS = { { 1, 1, 1, 1 }, { 4, 4, 4, 4 } };
+
+
+/// \brief The widths of encodings by normalized name.
+const std::pair<const char*, EncodingWidths> ENCODING_WIDTHS[] = {
+    { "utf8", UTF8_WIDTHS },
+    { "utf16", UTF16_WIDTHS },
+    { "utf16le", UTF16_WIDTHS },
+    { "utf16be", UTF16_WIDTHS },
+    { "utf32", UTF32_WIDTHS },
+    { "utf32le", UTF32_WIDTHS },
+    { "utf32be", UTF32_WIDTHS },
+    { "ucs4", UTF32_WIDTHS },
+    { "ucs4le", UTF32_WIDTHS },
+    { "ucs4be", UTF32_WIDTHS },
+    { "ucs2", UCS2_WIDTHS },
+    { "ucs2le", UCS2_WIDTHS },
+    { "ucs2be", UCS2_WIDTHS },
+    { "ascii", SINGLE_BYTE_WIDTHS },
+    { "usascii", SINGLE_BYTE_WIDTHS },
+    { "shiftjis", { { 1, 1, 1, 0 }, { 1, 2, 2, 0 } } },
+    { "sjis", { { 1, 1, 1, 0 }, { 1, 2, 2, 0 } } },
+    { "cp932", { { 1, 1, 1, 0 }, { 1, 2, 2, 0 } } },
+    { "eucjp", { { 1, 2, 2, 0 }, { 1, 3, 3, 0 } } },
+    { "euckr", { { 1, 2, 2, 0 }, { 1, 2, 2, 0 } } },
+    { "cp949", { { 1, 2, 2, 0 }, { 1, 2, 2, 0 } } },
+    { "big5", { { 1, 2, 2, 0 }, { 1, 2, 2, 0 } } },
+    { "cp950", { { 1, 2, 2, 0 }, { 1, 2, 2, 0 } } },
+    { "gb2312", { { 1, 2, 2, 0 }, { 1, 2, 2, 0 } } },
+    { "euccn", { { 1, 2, 2, 0 }, { 1, 2, 2, 0 } } },
+    { "gbk", { { 1, 1, 1, 0 }, { 1, 2, 2, 0 } } },
+    { "cp936", { { 1, 1, 1, 0 }, { 1, 2, 2, 0 } } },
+    { "gb18030", { { 1, 2, 2, 4 }, { 1, 4, 4, 4 } } }
+};
+
+
+/// \brief Prefixes of normalized single-byte encoding names.
+const char* const SINGLE_BYTE_PREFIXES[] = {
+    "iso8859",
+    "latin",
+    "windows125",
+    "cp125",
+    "koi8"
+};
+
+
+/// \brief Find the widths of an encoding.
+/// \param encoding The encoding name.
+/// \param widths Set to the widths if the encoding is known.
+/// \returns true if the encoding is known.
+bool findEncodingWidths(const std::string& encoding, EncodingWidths& widths)
+{
+    std::string name = normalizeEncodingName(encoding);
+
+    for (const auto& entry: ENCODING_WIDTHS)
+    {
+        if (name == entry.first)
+        {
+            widths = entry.second;
+            return true;
+        }
+    }
+
+    for (const char* prefix: SINGLE_BYTE_PREFIXES)
+    {
+        if (name.compare(0, std::strlen(prefix), prefix) == 0)
+        {
+            widths = SINGLE_BYTE_WIDTHS;
+            return true;
+        }
+    }
+
+    widths = UNKNOWN_WIDTHS;
+    return false;
+}
+
+
+/// \brief Check whether an encoding has shift states.
+/// \param encoding The encoding name.
+/// \returns true if the meaning of bytes depends on earlier escape sequences.
+bool isStatefulEncoding(const std::string& encoding)
+{
+    static const char* const STATEFUL_PREFIXES[] = {
+        "iso2022",
+        "csiso2022",
+        "cp5022",
+        "utf7",
+        "hz"
+    };
+
+    std::string name = normalizeEncodingName(encoding);
+
+    for (const char* prefix: STATEFUL_PREFIXES)
+        if (name.compare(0, std::strlen(prefix), prefix) == 0)
+            return true;
+
+    return false;
+}
+
+
+/// \brief The properties of an encoding used to set up a TextConverter.
+struct EncodingTraits
+{
+    /// \brief The built-in codec, or nullptr if iconv is used.
+    const NativeCodec* codec = nullptr;
+
+    /// \brief The widths of the encoding.
+    EncodingWidths widths = UNKNOWN_WIDTHS;
+
+    /// \brief True if the widths are known.
+    bool isKnownWidth = false;
+
+    /// \brief True if the encoding is UTF-8.
+    bool isUTF8 = false;
+
+    /// \brief True if the encoding has shift states.
+    bool isStateful = false;
+
+    /// \brief The bytes written once before output, such as a byte order
+    ///        mark.
+    std::size_t prefixSize = 0;
+};
+
+
+/// \brief Find the properties of an encoding from its name.
+/// \param encoding The encoding name.
+/// \returns the properties, with unknown widths if the name is not known.
+EncodingTraits findEncodingTraits(const std::string& encoding)
+{
+    std::string name = normalizeEncodingName(encoding);
+
+    EncodingTraits traits;
+    traits.codec = findNativeCodec(encoding);
+    traits.isKnownWidth = findEncodingWidths(encoding, traits.widths);
+    traits.isUTF8 = name == "utf8";
+    traits.isStateful = isStatefulEncoding(encoding);
+
+    // Unmarked UTF-16 and UTF-32 output begins with a byte order mark.
+    traits.prefixSize = name == "utf16" ? 2 : (name == "utf32" ? 4 : 0);
+
+    return traits;
+}
+
+
+/// \brief Find the most output bytes per input byte for a conversion.
+///
+/// The expansion is the largest ratio of output to input bytes over each
+/// range of code points that the input can encode. Code points that the
+/// output cannot encode, and invalid input bytes, are written as
+/// defaultCharacter encoded in the output encoding.
+///
+/// \param input The input encoding.
+/// \param output The output encoding.
+/// \param transliterate True if the conversion transliterates.
+/// \param numerator Set to the numerator of the expansion.
+/// \param denominator Set to the denominator of the expansion.
+/// \returns true if the expansion is a bound rather than an estimate.
+bool findOutputExpansion(const EncodingTraits& input,
+                         const EncodingTraits& output,
+                         bool transliterate,
+                         std::size_t& numerator,
+                         std::size_t& denominator)
+{
+    // Each invalid input byte may be replaced by an encoded ASCII character.
+    numerator = output.widths.max[0];
+    denominator = 1;
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        if (input.widths.min[i] == 0)
+            continue;
+
+        std::size_t bytes = output.widths.max[i] == 0 ? 1 : output.widths.max[i];
+
+        if (bytes * denominator > numerator * input.widths.min[i])
+        {
+            numerator = bytes;
+            denominator = input.widths.min[i];
+        }
+    }
+
+    // Transliteration may replace one character with several.
+    return input.isKnownWidth && output.isKnownWidth && !transliterate;
+}
+
+
+/// \brief Decode one non-ASCII character.
+/// \param codec The input codec.
+/// \param p The first byte of the character.
+/// \param end The end of the input.
+/// \param codepoint Set to the decoded code point.
+/// \param length Set to the number of bytes consumed, 1 if invalid.
+/// \returns true if the character is valid.
+bool decodeNative(const NativeCodec& codec,
+                  const unsigned char* p,
+                  const unsigned char* end,
+                  char32_t& codepoint,
+                  std::size_t& length)
+{
+    length = 1;
+
+    if (codec.decode)
+    {
+        codepoint = codec.decode[*p - 0x80];
+        return codepoint != 0;
+    }
+
+    std::size_t expected = utf8SequenceLength(*p);
+
+    if (expected < 2 || std::size_t(end - p) < expected)
+        return false;
+
+    char32_t units[4] = { *p, 0, 0, 0 };
+
+    for (std::size_t i = 1; i < expected; ++i)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+            return false;
+
+        units[i] = p[i];
+    }
+
+    codepoint = decodeUTF8Sequence(units, expected);
+
+    // A decoded replacement character from a valid sequence is U+FFFD
+    // itself, which is always encoded as EF BF BD.
+    if (codepoint == REPLACEMENT_CHARACTER && !(expected == 3 && p[0] == 0xEF && p[1] == 0xBF && p[2] == 0xBD))
+        return false;
+
+    length = expected;
+    return true;
+}
+
+
+/// \brief Encode one code point.
+/// \param codec The output codec.
+/// \param codepoint The code point to encode.
+/// \param out The output position, advanced past the encoded bytes.
+/// \returns false if the code point cannot be encoded.
+bool encodeNative(const NativeCodec& codec, char32_t codepoint, char*& out)
+{
+    if (codepoint < 0x80)
+    {
+        *out++ = static_cast<char>(codepoint);
+        return true;
+    }
+
+    if (codec.decode)
+    {
+        const uint32_t* iter = std::lower_bound(codec.encodeBegin,
+                                                codec.encodeEnd,
+                                                static_cast<uint32_t>(codepoint) << 8);
+
+        if (iter == codec.encodeEnd || (*iter >> 8) != codepoint)
+            return false;
+
+        *out++ = static_cast<char>(*iter & 0xFF);
+        return true;
+    }
+
+    if (codepoint < 0x800)
+    {
+        *out++ = static_cast<char>(0xC0 | (codepoint >> 6));
+    }
+    else if (codepoint < 0x10000)
+    {
+        *out++ = static_cast<char>(0xE0 | (codepoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    }
+    else
+    {
+        *out++ = static_cast<char>(0xF0 | (codepoint >> 18));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    }
+
+    *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    return true;
+}
+
+
+/// \brief Find the length of a UTF-8 sequence that could not be converted.
+///
+/// A valid sequence is a character that the output cannot encode. Otherwise
+/// the run of bytes up to the next one that can begin a character is
+/// skipped in one step.
+///
+/// \param p The first byte of the sequence.
+/// \param end The end of the input.
+/// \returns the number of bytes to skip.
+std::size_t skippedUTF8Length(const unsigned char* p, const unsigned char* end)
+{
+    std::size_t expected = utf8SequenceLength(*p);
+
+    if (expected == 1)
+        return 1;
+
+    if (expected > 0 && std::size_t(end - p) >= expected)
+    {
+        char32_t codepoint = 0;
+        std::size_t length = 1;
+
+        if (decodeNative(NATIVE_CODECS[0], p, end, codepoint, length))
+            return length;
+    }
+
+    std::size_t length = 1;
+
+    while (p + length < end && utf8SequenceLength(p[length]) == 0)
+        ++length;
+
+    return length;
+}
+
+
+/// \brief Determine if a byte continues a run of invalid input.
+///
+/// For UTF-8 these are the bytes that cannot start a sequence, and for
+/// single-byte codecs the bytes that are not defined.
+///
+/// \param codec The input codec.
+/// \param byte The byte after an invalid sequence.
+/// \returns true if the byte belongs to the same run.
+bool continuesInvalidRun(const NativeCodec& codec, unsigned char byte)
+{
+    if (!codec.decode)
+        return utf8SequenceLength(byte) == 0;
+
+    return byte >= 0x80 && codec.decode[byte - 0x80] == 0;
+}
+
+
+/// \brief Find the length of an invalid sequence for a built-in codec.
+///
+/// A run of bytes that cannot be decoded is skipped in one step and
+/// replaced once.
+///
+/// \param codec The input codec.
+/// \param p The first byte of the invalid sequence.
+/// \param end The end of the input.
+/// \returns the number of bytes to skip.
+std::size_t invalidNativeLength(const NativeCodec& codec,
+                                const unsigned char* p,
+                                const unsigned char* end)
+{
+    if (!codec.decode)
+        return skippedUTF8Length(p, end);
+
+    std::size_t length = 1;
+
+    while (p + length < end && continuesInvalidRun(codec, p[length]))
+        ++length;
+
+    return length;
+}
+
+
+/// \brief Count the output bytes of a conversion between built-in codecs.
+/// \param input The input codec.
+/// \param output The output codec.
+/// \param p The input.
+/// \param end The end of the input.
+/// \returns the exact output size.
+std::size_t nativeOutputSize(const NativeCodec& input,
+                             const NativeCodec& output,
+                             const unsigned char* p,
+                             const unsigned char* end)
+{
+    std::size_t size = 0;
+
+    while (p < end)
+    {
+        if (*p < 0x80)
+        {
+            ++p;
+            ++size;
+            continue;
+        }
+
+        char32_t codepoint = 0;
+        std::size_t length = 1;
+
+        // A run of invalid bytes is replaced by one byte, as is a code point
+        // that a single-byte output cannot encode.
+        bool isValid = decodeNative(input, p, end, codepoint, length);
+
+        if (!isValid)
+            length = invalidNativeLength(input, p, end);
+
+        if (!isValid || output.decode)
+            ++size;
+        else
+            size += codepoint < 0x800 ? 2 : (codepoint < 0x10000 ? 3 : 4);
+
+        p += length;
+    }
+
+    return size;
+}
+
+
+/// \brief Find an incomplete UTF-8 sequence at the end of a buffer.
+/// \param begin The beginning of the buffer.
+/// \param end The end of the buffer.
+/// \returns the size of the incomplete sequence, or 0 if there is none.
+std::size_t incompleteUTF8Size(const unsigned char* begin, const unsigned char* end)
+{
+    for (std::size_t size = 1; size <= 3 && size <= std::size_t(end - begin); ++size)
+    {
+        unsigned char unit = *(end - size);
+
+        if ((unit & 0xC0) != 0x80)
+            return utf8SequenceLength(unit) > size ? size : 0;
+    }
+
+    return 0;
+}
+
+
+/// \brief Encode a replacement character in an output encoding.
+/// \param character The ASCII replacement character.
+/// \param outputEncoding The output encoding name.
+/// \param prefixSize The size of the byte order mark written first.
+/// \returns the encoded character, or the character itself if it cannot be
+///          encoded.
+std::string encodeReplacement(char character,
+                              const std::string& outputEncoding,
+                              std::size_t prefixSize)
+{
+    iconv_t cd = iconv_open(outputEncoding.data(), "ASCII");
+
+    if (cd == INVALID_CD)
+        return std::string(1, character);
+
+    char buffer[16];
+    char* pInput = &character;
+    std::size_t sInput = 1;
+    char* pOutput = buffer;
+    std::size_t sOutput = sizeof(buffer);
+
+    std::size_t res = iconv(cd, &pInput, &sInput, &pOutput, &sOutput);
+    iconv_close(cd);
+
+    if (res == INVALID_CONVERSION || std::size_t(pOutput - buffer) <= prefixSize)
+        return std::string(1, character);
+
+    // Unmarked UTF-16 and UTF-32 output begins with a byte order mark, which
+    // is written once by the converter and not with each replacement.
+    return std::string(buffer + prefixSize, pOutput);
+}
+
+
+/// \brief The encodings that glibc converts without gconv modules.
+///
+/// The first name of each is the canonical name and the rest are aliases.
+const char* const BUILTIN_ENCODINGS[][12] = {
+    { "UTF-8", "UTF8", "ISO-10646/UTF8", "ISO-10646/UTF-8", "ISO-IR-193", "OSF05010001" },
+    { "ASCII", "ANSI_X3.4-1968", "ANSI_X3.4-1986", "ISO-IR-6", "ISO_646.IRV:1991", "ISO646-US", "US-ASCII", "US", "IBM367", "CP367", "CSASCII", "OSF00010020" },
+    { "UCS-4", "UCS4", "UCS-4BE", "ISO-10646", "ISO-10646/UCS4", "CSUCS4", "10646-1:1993", "10646-1:1993/UCS4", "OSF00010104", "OSF00010105", "OSF00010106" },
+    { "UCS-4LE" },
+    { "UCS-2", "UCS2", "ISO-10646/UCS2", "CSUNICODE", "OSF00010100", "OSF00010101", "OSF00010102" },
+    { "UCS-2BE", "UNICODEBIG" },
+    { "UCS-2LE", "UNICODELITTLE" },
+    { "UTF-16", "UTF16" },
+    { "UTF-16LE", "UTF16LE" },
+    { "UTF-16BE", "UTF16BE" },
+    { "UTF-32", "UTF32" },
+    { "UTF-32LE", "UTF32LE" },
+    { "UTF-32BE", "UTF32BE" },
+    { "UTF-7", "UTF7" },
+    { "UTF-7-IMAP" },
+    { "WCHAR_T" }
+};
+
+
+/// \brief Remove the trailing slashes of a gconv encoding name.
+std::string trimGconvName(const std::string& name)
+{
+    std::size_t end = name.find_last_not_of('/');
+    return end == std::string::npos ? std::string() : name.substr(0, end + 1);
+}
+
+
+/// \brief Read the aliases and modules of a gconv configuration file.
+///
+/// Lines are "alias ALIAS// NAME//" or "module FROM// TO// FILE COST".
+///
+/// \param path The configuration file.
+/// \param groups The aliases of each canonical name, added to.
+void readGconvModules(const std::filesystem::path& path,
+                      std::map<std::string, std::vector<std::string>>& groups)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string type;
+        std::string from;
+        std::string to;
+
+        if (!(fields >> type >> from >> to))
+            continue;
+
+        from = trimGconvName(from);
+        to = trimGconvName(to);
+
+        if (from.empty() || to.empty())
+            continue;
+
+        if (type == "alias")
+        {
+            groups[to].push_back(from);
+        }
+        else if (type == "module")
+        {
+            // Modules convert to and from glibc's internal UCS-4.
+            if (from != "INTERNAL")
+                groups[from];
+
+            if (to != "INTERNAL")
+                groups[to];
+        }
+    }
+}
+
+
+/// \brief Find the directories that may hold the gconv configuration.
+///
+/// These are the GCONV_PATH directories followed by the usual install
+/// locations, including multiarch directories such as
+/// /usr/lib/x86_64-linux-gnu/gconv.
+std::vector<std::filesystem::path> gconvDirectories()
+{
+    std::vector<std::filesystem::path> directories;
+
+    if (const char* gconvPath = std::getenv("GCONV_PATH"))
+    {
+        std::istringstream paths(gconvPath);
+        std::string path;
+
+        while (std::getline(paths, path, ':'))
+            if (!path.empty())
+                directories.push_back(path);
+    }
+
+    directories.push_back("/usr/lib/gconv");
+    directories.push_back("/usr/lib64/gconv");
+
+    std::error_code error;
+
+    for (std::filesystem::directory_iterator iter("/usr/lib", error), end; !error && iter != end; iter.increment(error))
+        if (iter->path().filename().string().find("-linux-") != std::string::npos)
+            directories.push_back(iter->path() / "gconv");
+
+    return directories;
+}
+
+
+/// \brief A registry of the available encodings and their aliases.
+///
+/// Each name and alias is indexed by its normalized form, so a name is
+/// found with a single hash lookup. The properties that setup() needs are
+/// found once for each encoding.
+class EncodingRegistry
+{
+public:
+    /// \brief Build the registry from the iconv implementation.
+    EncodingRegistry()
+    {
+#if defined(_LIBICONV_VERSION)
+        // GNU libiconv lists each encoding with its aliases.
+        iconvlist([](unsigned int namescount,
+                     const char* const* names,
+                     void* data) -> int
+        {
+            std::vector<std::string> group;
+
+            for (unsigned int i = 0; i < namescount; ++i)
+                if (names[i] && std::strlen(names[i]) > 0)
+                    group.push_back(names[i]);
+
+            static_cast<EncodingRegistry*>(data)->add(group);
+            return 0;
+        }, this);
+#else
+        // glibc has no iconvlist(), so the built-in encodings are listed
+        // here and the rest are read from the gconv module configuration.
+        for (const auto& builtin: BUILTIN_ENCODINGS)
+        {
+            std::vector<std::string> group;
+
+            for (const char* name: builtin)
+                if (name)
+                    group.push_back(name);
+
+            add(group);
+        }
+
+        std::map<std::string, std::vector<std::string>> groups;
+
+        for (const auto& directory: gconvDirectories())
+        {
+            std::error_code error;
+
+            if (!std::filesystem::is_regular_file(directory / "gconv-modules", error))
+                continue;
+
+            readGconvModules(directory / "gconv-modules", groups);
+
+            for (std::filesystem::directory_iterator iter(directory / "gconv-modules.d", error), end; !error && iter != end; iter.increment(error))
+                if (iter->path().extension() == ".conf")
+                    readGconvModules(iter->path(), groups);
+        }
+
+        for (auto& group: groups)
+        {
+            group.second.insert(group.second.begin(), group.first);
+            add(group.second);
+        }
+#endif
+    }
+
+    /// \brief Add an encoding, or more aliases of a registered encoding.
+    /// \param names The canonical name followed by any aliases.
+    void add(const std::vector<std::string>& names)
+    {
+        if (names.empty())
+            return;
+
+        TextConverter::EncodingId id = find(names[0]);
+
+        if (id == TextConverter::UNKNOWN_ENCODING)
+        {
+            std::string key = normalizeEncodingName(names[0]);
+
+            if (key.empty())
+                return;
+
+            id = TextConverter::EncodingId(_encodings.size());
+            _encodings.emplace_back();
+            _encodings.back().id = id;
+            _encodings.back().name = names[0];
+            _names.push_back(names[0]);
+            _traits.push_back(findEncodingTraits(names[0]));
+            _index[key] = id;
+        }
+
+        for (std::size_t i = 1; i < names.size(); ++i)
+        {
+            std::string key = normalizeEncodingName(names[i]);
+
+            // A name keeps the first encoding that claimed it.
+            if (key.empty() || !_index.emplace(key, id).second)
+                continue;
+
+            _encodings[id].aliases.push_back(names[i]);
+
+            // The properties may only be known by an alias, such as CP949
+            // for the canonical UHC.
+            EncodingTraits alias = findEncodingTraits(names[i]);
+            EncodingTraits& traits = _traits[id];
+
+            if (!traits.codec)
+                traits.codec = alias.codec;
+
+            if (!traits.isKnownWidth && alias.isKnownWidth)
+            {
+                traits.widths = alias.widths;
+                traits.isKnownWidth = true;
+            }
+
+            if (traits.prefixSize == 0)
+                traits.prefixSize = alias.prefixSize;
+
+            traits.isUTF8 = traits.isUTF8 || alias.isUTF8;
+            traits.isStateful = traits.isStateful || alias.isStateful;
+        }
+    }
+
+    /// \brief Find an encoding by name.
+    /// \param name The name or alias.
+    /// \returns the id or UNKNOWN_ENCODING.
+    TextConverter::EncodingId find(const std::string& name) const
+    {
+        auto iter = _index.find(normalizeEncodingName(name));
+        return iter == _index.end() ? TextConverter::UNKNOWN_ENCODING : iter->second;
+    }
+
+    /// \returns the encoding for an id or nullptr if it is not registered.
+    const TextConverter::EncodingInfo* info(TextConverter::EncodingId id) const
+    {
+        return id >= 0 && std::size_t(id) < _encodings.size() ? &_encodings[id] : nullptr;
+    }
+
+    /// \returns the properties for an id or nullptr if it is not registered.
+    const EncodingTraits* traits(TextConverter::EncodingId id) const
+    {
+        return id >= 0 && std::size_t(id) < _traits.size() ? &_traits[id] : nullptr;
+    }
+
+    /// \returns the canonical names indexed by id.
+    const std::vector<std::string>& names() const
+    {
+        return _names;
+    }
+
+private:
+    /// \brief The encodings indexed by id.
+    std::vector<TextConverter::EncodingInfo> _encodings;
+
+    /// \brief The encoding properties indexed by id.
+    std::vector<EncodingTraits> _traits;
+
+    /// \brief The canonical names indexed by id.
+    std::vector<std::string> _names;
+
+    /// \brief The id of each normalized name and alias.
+    std::unordered_map<std::string, TextConverter::EncodingId> _index;
+
+};
+
+
+/// \brief Get the process-wide registry, built on first use.
+const EncodingRegistry& encodingRegistry()
+{
+    static const EncodingRegistry registry;
+    return registry;
+}
+
+
+/// \brief Find the properties of a Settings encoding.
+/// \param encoding The encoding name, replaced by the canonical name if id
+///        is registered.
+/// \param id The encoding id, or UNKNOWN_ENCODING to look up the name.
+/// \param traits Set to the properties of the encoding.
+/// \returns false if id is neither registered nor UNKNOWN_ENCODING.
+bool resolveEncoding(std::string& encoding,
+                     TextConverter::EncodingId id,
+                     EncodingTraits& traits)
+{
+    const EncodingRegistry& registry = encodingRegistry();
+
+    if (id == TextConverter::UNKNOWN_ENCODING)
+    {
+        id = registry.find(encoding);
+    }
+    else if (const TextConverter::EncodingInfo* info = registry.info(id))
+    {
+        encoding = info->name;
+    }
+    else
+    {
+        return false;
+    }
+
+    // Names that are not registered may still be known to iconv.
+    const EncodingTraits* registered = registry.traits(id);
+    traits = registered ? *registered : findEncodingTraits(encoding);
+    return true;
+}
+
+
+} // namespace
+
+
+TextConverter::TextConverter()
+{
+}
+
+
+TextConverter::TextConverter(const std::string& inputEncoding,
+                             const std::string& outputEncoding)
+{
+    Settings settings;
+    settings.inputEncoding = inputEncoding;
+    settings.outputEncoding = outputEncoding;
+    setup(settings);
+}
+
+
+TextConverter::TextConverter(const Settings& settings)
+{
+    setup(settings);
+}
+
+
+TextConverter::~TextConverter()
+{
+}
+
+
+bool TextConverter::setup(const std::string& outputEncoding)
+{
+    Settings settings;
+    settings.inputEncoding = "UTF-8";
+    settings.outputEncoding = outputEncoding;
+    return setup(settings);
+}
+
+
+bool TextConverter::setup(const Settings& settings)
+{
+    _cd.reset();
+    _decodeCd.reset();
+    _settings = settings;
+    _inputCodec = nullptr;
+    _outputCodec = nullptr;
+
+    EncodingTraits input;
+    EncodingTraits output;
+
+    if (!resolveEncoding(_settings.inputEncoding, settings.inputEncodingId, input)
+    ||  !resolveEncoding(_settings.outputEncoding, settings.outputEncodingId, output))
+    {
+        ofLogError("TextConverter::setup") << "Unknown encoding id.";
+        return false;
+    }
+
+    _isOutputBounded = findOutputExpansion(input,
+                                           output,
+                                           settings.transliterate,
+                                           _expansionNumerator,
+                                           _expansionDenominator);
+    _outputPrefixSize = output.prefixSize;
+
+    // Rejected input is skipped one code unit at a time, except for UTF-8
+    // whose invalid runs are found directly.
+    _isInputUTF8 = input.isUTF8;
+    _inputUnitSize = 4;
+
+    for (uint8_t width: input.widths.min)
+        if (width > 0)
+            _inputUnitSize = std::min(_inputUnitSize, std::size_t(width));
+
+    _joinErrors = !_isInputUTF8;
+    _isInputStateful = input.isStateful;
+    _isOutputStateful = output.isStateful;
+    _replacement.assign(1, settings.defaultCharacter);
+
+    // The built-in codecs do not transliterate.
+    if (!settings.transliterate)
+    {
+        _inputCodec = input.codec;
+        _outputCodec = output.codec;
+
+        if (isNative())
+            return true;
+
+        _inputCodec = nullptr;
+        _outputCodec = nullptr;
+    }
+
+    // Input and output encoding are backwards in the iconv api.
+    // This allocates a conversion descriptor.
+
+    std::string outputEncoding = _settings.outputEncoding;
+
+    if (settings.transliterate)
+        outputEncoding += "//TRANSLIT";
+
+    iconv_t cd = iconv_open(outputEncoding.data(),
+                            _settings.inputEncoding.data());
 
     if (cd == INVALID_CD)
     {
-        if (errno == EINVAL)
-            ofLogError("TextConverter::convert") << settings.inputEncoding << " to " << settings.outputEncoding << " is not supported.";
-        else
-            ofLogError("TextConverter::convert") << "Unknown error.";
+        if (errno == EINVAL)
+            ofLogError("TextConverter::convert") << _settings.inputEncoding << " to " << _settings.outputEncoding << " is not supported.";
+        else
+            ofLogError("TextConverter::convert") << "Unknown error.";
+    }
+    else
+    {
+        // Wrap in std::shared_ptr.
+        _cd = std::shared_ptr<void>(cd, iconv_close);
+
+        // ASCII compatible outputs write the replacement as it is.
+        if (settings.skipErrors && (!output.isKnownWidth || output.widths.max[0] != 1))
+            _replacement = encodeReplacement(settings.defaultCharacter,
+                                             _settings.outputEncoding,
+                                             _outputPrefixSize);
+
+        // Rejected input is decoded again to find whole characters. This
+        // cannot start in the middle of a stateful input.
+        if (!input.isUTF8 && !input.isStateful)
+        {
+            iconv_t decodeCd = iconv_open("UTF-32LE", _settings.inputEncoding.data());
+
+            if (decodeCd != INVALID_CD)
+                _decodeCd = std::shared_ptr<void>(decodeCd, iconv_close);
+        }
+    }
+
+    return isLoaded();
+}
+
+
+bool TextConverter::isLoaded() const
+{
+    return _cd != nullptr || isNative();
+}
+
+
+bool TextConverter::isNative() const
+{
+    return _inputCodec != nullptr && _outputCodec != nullptr;
+}
+
+
+std::size_t TextConverter::maxOutputSize(std::size_t inputBytes) const
+{
+    return (inputBytes * _expansionNumerator + _expansionDenominator - 1) / _expansionDenominator
+         + _outputPrefixSize;
+}
+
+
+bool TextConverter::isOutputBounded() const
+{
+    return _isOutputBounded;
+}
+
+
+void TextConverter::reset()
+{
+    if (_cd)
+        iconv(_cd.get(), nullptr, nullptr, nullptr, nullptr);
+
+    _pending.clear();
+    _isInInvalidRun = false;
+}
+
+
+const std::vector<std::string>& TextConverter::encodings()
+{
+    return encodingRegistry().names();
+}
+
+
+TextConverter::EncodingId TextConverter::findEncoding(const std::string& name)
+{
+    return encodingRegistry().find(name);
+}
+
+
+const TextConverter::EncodingInfo* TextConverter::encodingInfo(EncodingId id)
+{
+    return encodingRegistry().info(id);
+}
+
+
+int TextConverter::convert(const std::string& input,
+                           std::string& output,
+                           std::vector<ConversionError>* errors) const
+{
+    return convert(input.data(), input.size(), output, errors);
+}
+
+
+int TextConverter::convert(const char* data,
+                           std::size_t size,
+                           std::string& output,
+                           std::vector<ConversionError>* errors) const
+{
+    int numEncodingErrors = 0;
+
+    if (!isLoaded())
+    {
+        ofLogError("TextConverter::convert") << "Converter is not loaded. Call setup().";
+        return -1;
+    }
+
+    if (isNative())
+    {
+        std::size_t outputSize = _settings.exactOutputSize
+                               ? nativeOutputSize(*_inputCodec,
+                                                  *_outputCodec,
+                                                  reinterpret_cast<const unsigned char*>(data),
+                                                  reinterpret_cast<const unsigned char*>(data) + size)
+                               : maxOutputSize(size);
+
+        // Here we only resize the output if the caller hasn't already done so.
+        if (output.size() < outputSize)
+            output.resize(outputSize);
+
+        char* out = &output[0];
+        numEncodingErrors = convertNative(data, size, out, errors);
+
+        if (numEncodingErrors >= 0)
+            output.resize(out - output.data());
+
+        return numEncodingErrors;
+    }
+
+    char* pInput = const_cast<char*>(data);
+    std::size_t sInput = size;
+
+    // Here we only resize the output if the caller hasn't already done so.
+    // The output is only grown again if the size is an estimate.
+    if (output.size() < maxOutputSize(sInput))
+        output.resize(maxOutputSize(sInput));
+
+    char* pOutput = const_cast<char*>(output.data());
+    size_t sOutput = output.size();
+
+    // Grow the output by at least minSize bytes.
+    auto grow = [&](std::size_t minSize)
+    {
+        // Make a note of where we were in the output buffer.
+        std::size_t outputPosition = pOutput - output.data();
+
+        // Resize output memory to fit the rest of the input.
+        output.resize(output.size() + std::max(minSize, maxOutputSize(sInput)));
+
+        // Get new pointers in case the resize operation moved memory.
+        pOutput = const_cast<char*>(output.data()) + outputPosition;
+
+        // Set a new remaining size based on the updated output
+        // position and the resized output buffer.
+        sOutput = output.size() - outputPosition;
+    };
+
+    // The end of the last invalid sequence, so that adjacent invalid units
+    // are reported and replaced once.
+    const char* errorEnd = nullptr;
+
+    while (0 < sInput)
+    {
+        size_t res = iconv(_cd.get(), // Conversion descriptor.
+                           &pInput,   // Pointer to input pointer.
+                           &sInput,   // Pointer to input size.
+                           &pOutput,  // Pointer to output pointer.
+                           &sOutput   // Pointer to output size.
+                           );
+
+        if (res != INVALID_CONVERSION)
+            continue;
+
+        if (errno == E2BIG)
+        {
+            // errno == E2BIG means the output buffer ran out of space.
+            grow(0);
+            continue;
+        }
+
+        if (errno == EILSEQ && _isInputStateful)
+        {
+            if (sOutput < MAX_PREFIX_OUTPUT_SIZE)
+                grow(MAX_PREFIX_OUTPUT_SIZE);
+
+            if (convertPrefix(pInput, sInput, pOutput, sOutput))
+                continue;
+
+            errno = EILSEQ;
+        }
+
+        // EILSEQ is an invalid or unmappable sequence and EINVAL is an
+        // incomplete character at the end of the input.
+        ConversionError error;
+        bool isInvalid = true;
+        error.offset = pInput - data;
+        error.length = errno == EINVAL ? sInput : skippedLength(pInput, sInput, isInvalid);
+
+        if (!_settings.skipErrors)
+        {
+            if (errors)
+                errors->push_back(error);
+
+            switch (errno)
+            {
+                case EILSEQ:
+                case EINVAL:
+                    ofLogError("TextConverter::convert") << std::strerror(errno) << " at byte " << error.offset << ".";
+                    break;
+                default:
+                    ofLogError("TextConverter::convert") << "Unknown conversion error: " << std::strerror(errno);
+            }
+
+            return -1;
+        }
+
+        if (_joinErrors && isInvalid && pInput == errorEnd)
+        {
+            if (errors)
+                errors->back().length += error.length;
+        }
+        else
+        {
+            // Leave room for a shift sequence before the replacement.
+            if (sOutput < _replacement.size() + 8)
+                grow(_replacement.size() + 8);
+
+            if (_isOutputStateful)
+                iconv(_cd.get(), nullptr, nullptr, &pOutput, &sOutput);
+
+            std::memcpy(pOutput, _replacement.data(), _replacement.size());
+            pOutput += _replacement.size();
+            sOutput -= _replacement.size();
+            ++numEncodingErrors;
+
+            if (errors)
+                errors->push_back(error);
+        }
+
+        pInput += error.length;
+        sInput -= error.length;
+        errorEnd = isInvalid ? pInput : nullptr;
+    }
+
+    // End a stateful output in its initial state as flush() does, and start
+    // the next conversion from the initial input state.
+    if (_isInputStateful || _isOutputStateful)
+    {
+        if (sOutput < MAX_PREFIX_OUTPUT_SIZE)
+            grow(MAX_PREFIX_OUTPUT_SIZE);
+
+        iconv(_cd.get(), nullptr, nullptr, &pOutput, &sOutput);
+    }
+
+    // Remove any excess size if required.
+    output.resize(pOutput - const_cast<char*>(output.data()));
+
+    return numEncodingErrors;
+}
+
+
+int TextConverter::convertNative(const char* data,
+                                 std::size_t size,
+                                 char*& out,
+                                 std::vector<ConversionError>* errors,
+                                 bool* isInInvalidRun) const
+{
+    const unsigned char* begin = reinterpret_cast<const unsigned char*>(data);
+    const unsigned char* end = begin + size;
+    const unsigned char* in = begin;
+    const unsigned char* errorEnd = nullptr;
+    int numEncodingErrors = 0;
+
+    // The rest of a run that an earlier call already replaced.
+    if (isInInvalidRun && *isInInvalidRun)
+    {
+        while (in < end && continuesInvalidRun(*_inputCodec, *in))
+            ++in;
+
+        errorEnd = in;
+    }
+
+    while (in < end)
+    {
+        // ASCII is the same in every built-in encoding, so runs of it are
+        // copied eight bytes at a time.
+        while (end - in >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, in, sizeof(word));
+
+            if (word & 0x8080808080808080ULL)
+                break;
+
+            std::memcpy(out, in, sizeof(word));
+            in += sizeof(word);
+            out += sizeof(word);
+        }
+
+        if (in == end)
+            break;
+
+        if (*in < 0x80)
+        {
+            *out++ = static_cast<char>(*in++);
+            continue;
+        }
+
+        char32_t codepoint = 0;
+        std::size_t length = 1;
+        bool isValid = decodeNative(*_inputCodec, in, end, codepoint, length);
+
+        // Skip the whole run of invalid bytes.
+        if (!isValid)
+            length = invalidNativeLength(*_inputCodec, in, end);
+
+        if (!isValid || !encodeNative(*_outputCodec, codepoint, out))
+        {
+            if (errors)
+                errors->push_back({ std::size_t(in - begin), length });
+
+            if (!_settings.skipErrors)
+            {
+                ofLogError("TextConverter::convert") << "Invalid or unmappable input at byte " << (in - begin) << ".";
+                return -1;
+            }
+
+            *out++ = _settings.defaultCharacter;
+            ++numEncodingErrors;
+        }
+
+        in += length;
+
+        if (!isValid)
+            errorEnd = in;
+    }
+
+    if (isInInvalidRun)
+        *isInInvalidRun = errorEnd == end;
+
+    return numEncodingErrors;
+}
+
+
+std::size_t TextConverter::skippedLength(const char* data, std::size_t size, bool& isInvalid) const
+{
+    isInvalid = true;
+
+    if (_isInputUTF8)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+        std::size_t length = skippedUTF8Length(p, p + size);
+        char32_t codepoint = 0;
+        std::size_t decodedLength = 1;
+        isInvalid = *p >= 0x80 && !decodeNative(NATIVE_CODECS[0], p, p + length, codepoint, decodedLength);
+        return length;
+    }
+
+    if (_decodeCd)
+    {
+        // Decode a growing prefix until it is one whole character, so that
+        // an unmappable character is skipped with its trail bytes.
+        char decoded[16];
+
+        for (std::size_t length = 1; length <= std::min(size, MAX_CHARACTER_SIZE); ++length)
+        {
+            iconv(_decodeCd.get(), nullptr, nullptr, nullptr, nullptr);
+
+            char* pInput = const_cast<char*>(data);
+            std::size_t sInput = length;
+            char* pOutput = decoded;
+            std::size_t sOutput = sizeof(decoded);
+
+            if (iconv(_decodeCd.get(), &pInput, &sInput, &pOutput, &sOutput) != INVALID_CONVERSION)
+            {
+                isInvalid = false;
+                return length;
+            }
+
+            if (errno != EINVAL)
+                break;
+        }
+    }
+
+    return std::min(size, _inputUnitSize);
+}
+
+
+bool TextConverter::convertPrefix(char*& pInput,
+                                  std::size_t& sInput,
+                                  char*& pOutput,
+                                  std::size_t& sOutput) const
+{
+    for (std::size_t length = 1; length <= std::min(sInput, MAX_CHARACTER_SIZE); ++length)
+    {
+        char* p = pInput;
+        std::size_t s = length;
+
+        iconv(_cd.get(), &p, &s, &pOutput, &sOutput);
+
+        if (p != pInput)
+        {
+            sInput -= p - pInput;
+            pInput = p;
+            return true;
+        }
+
+        if (errno != EINVAL)
+            break;
+    }
+
+    return false;
+}
+
+
+std::string TextConverter::convert(const std::string& input) const
+{
+    std::string output;
+    convert(input, output);
+    return output;
+}
+
+
+int TextConverter::feed(const char* data, std::size_t size, const Sink& sink)
+{
+    if (!isLoaded())
+    {
+        ofLogError("TextConverter::feed") << "Converter is not loaded. Call setup().";
+        return -1;
+    }
+
+    int numEncodingErrors = 0;
+    std::size_t consumed = 0;
+
+    // Complete the character left by the last chunk. A few bytes are moved
+    // to the pending buffer at a time, so that only the pending character
+    // and not the whole chunk is copied.
+    while (!_pending.empty() && size > 0)
+    {
+        std::size_t pendingSize = _pending.size();
+        std::size_t take = std::min(size, std::size_t(16));
+        _pending.append(data, take);
+
+        int result = convertChunk(_pending.data(), _pending.size(), consumed, sink);
+
+        if (result < 0)
+            return -1;
+
+        numEncodingErrors += result;
+
+        if (consumed < pendingSize)
+        {
+            _pending.erase(0, consumed);
+            data += take;
+            size -= take;
+        }
+        else
+        {
+            _pending.clear();
+            data += consumed - pendingSize;
+            size -= consumed - pendingSize;
+        }
+    }
+
+    int result = convertChunk(data, size, consumed, sink);
+
+    if (result < 0)
+        return -1;
+
+    _pending.append(data + consumed, size - consumed);
+
+    return numEncodingErrors + result;
+}
+
+
+int TextConverter::feed(const std::string& chunk, const Sink& sink)
+{
+    return feed(chunk.data(), chunk.size(), sink);
+}
+
+
+int TextConverter::flush(const Sink& sink)
+{
+    if (!isLoaded())
+    {
+        ofLogError("TextConverter::flush") << "Converter is not loaded. Call setup().";
+        return -1;
+    }
+
+    int numEncodingErrors = 0;
+
+    if (!_pending.empty())
+    {
+        // The incomplete character is converted as convert() does at the
+        // end of its input.
+        std::size_t consumed = 0;
+        numEncodingErrors = convertChunk(_pending.data(), _pending.size(), consumed, sink, true);
+
+        if (numEncodingErrors < 0)
+        {
+            reset();
+            return -1;
+        }
+    }
+
+    if (_cd)
+    {
+        // Write any sequence that returns the output to its initial state.
+        char buffer[32];
+        char* pOutput = buffer;
+        std::size_t sOutput = sizeof(buffer);
+
+        if (iconv(_cd.get(), nullptr, nullptr, &pOutput, &sOutput) != INVALID_CONVERSION
+        &&  pOutput != buffer)
+        {
+            sink(buffer, pOutput - buffer);
+        }
+    }
+
+    reset();
+
+    return numEncodingErrors;
+}
+
+
+int TextConverter::convert(std::istream& input, std::ostream& output)
+{
+    Sink sink = [&output](const char* data, std::size_t size)
+    {
+        output.write(data, size);
+    };
+
+    std::vector<char> buffer(STREAM_BUFFER_SIZE);
+    int numEncodingErrors = 0;
+
+    reset();
+
+    while (input)
+    {
+        input.read(buffer.data(), buffer.size());
+
+        int result = feed(buffer.data(), input.gcount(), sink);
+
+        if (result < 0)
+        {
+            reset();
+            return -1;
+        }
+
+        numEncodingErrors += result;
+    }
+
+    int result = flush(sink);
+
+    if (result < 0)
+        return -1;
+
+    if (!output)
+    {
+        ofLogError("TextConverter::convert") << "Unable to write to the output stream.";
+        return -1;
+    }
+
+    return numEncodingErrors + result;
+}
+
+
+int TextConverter::convertChunk(const char* data,
+                                std::size_t size,
+                                std::size_t& consumed,
+                                const Sink& sink,
+                                bool isFinal)
+{
+    _streamBuffer.resize(STREAM_BUFFER_SIZE);
+
+    char* buffer = _streamBuffer.data();
+    int numEncodingErrors = 0;
+
+    consumed = 0;
+
+    if (isNative())
+    {
+        // An incomplete UTF-8 character waits for the next chunk.
+        if (!_inputCodec->decode && !isFinal)
+            size -= incompleteUTF8Size(reinterpret_cast<const unsigned char*>(data),
+                                       reinterpret_cast<const unsigned char*>(data) + size);
+
+        // The largest slice of input whose output always fits the buffer.
+        std::size_t sliceSize = std::max(std::size_t(1), STREAM_BUFFER_SIZE * _expansionDenominator / _expansionNumerator);
+
+        while (consumed < size)
+        {
+            std::size_t end = std::min(size, consumed + sliceSize);
+
+            // Do not split a UTF-8 character between slices.
+            if (!_inputCodec->decode && end < size)
+            {
+                for (std::size_t i = 0; i < 3 && end > consumed + 1 && (data[end] & 0xC0) == 0x80; ++i)
+                    --end;
+            }
+
+            char* out = buffer;
+            int result = convertNative(data + consumed, end - consumed, out, nullptr, &_isInInvalidRun);
+
+            if (result < 0)
+                return -1;
+
+            numEncodingErrors += result;
+            consumed = end;
+            sink(buffer, out - buffer);
+        }
+
+        return numEncodingErrors;
+    }
+
+    char* pInput = const_cast<char*>(data);
+    std::size_t sInput = size;
+    char* pOutput = buffer;
+    std::size_t sOutput = _streamBuffer.size();
+    const char* errorEnd = nullptr;
+
+    // A run of invalid input replaced by the last chunk continues here. Runs
+    // of UTF-8 extend over the bytes that cannot start a sequence, and other
+    // runs are joined with the next invalid unit.
+    if (_isInInvalidRun)
+    {
+        if (_isInputUTF8)
+        {
+            while (sInput > 0 && continuesInvalidRun(NATIVE_CODECS[0], *pInput))
+            {
+                ++pInput;
+                --sInput;
+            }
+        }
+
+        errorEnd = pInput;
+    }
+
+    while (0 < sInput)
+    {
+        size_t res = iconv(_cd.get(), &pInput, &sInput, &pOutput, &sOutput);
+
+        if (res != INVALID_CONVERSION)
+            break;
+
+        if (errno == EILSEQ && _isInputStateful)
+        {
+            if (sOutput < MAX_PREFIX_OUTPUT_SIZE)
+            {
+                sink(buffer, pOutput - buffer);
+                pOutput = buffer;
+                sOutput = _streamBuffer.size();
+            }
+
+            if (convertPrefix(pInput, sInput, pOutput, sOutput))
+                continue;
+
+            errno = EILSEQ;
+        }
+
+        if (errno == E2BIG)
+        {
+            // The buffer is full, so pass it on and reuse it.
+            sink(buffer, pOutput - buffer);
+            pOutput = buffer;
+            sOutput = _streamBuffer.size();
+        }
+        else if (errno == EINVAL && !isFinal)
+        {
+            // An incomplete character waits for the next chunk.
+            break;
+        }
+        else if (_settings.skipErrors)
+        {
+            bool isInvalid = true;
+            std::size_t length = errno == EINVAL ? sInput : skippedLength(pInput, sInput, isInvalid);
+
+            if (!_joinErrors || !isInvalid || pInput != errorEnd)
+            {
+                // Leave room for a shift sequence before the replacement.
+                if (sOutput < _replacement.size() + 8)
+                {
+                    sink(buffer, pOutput - buffer);
+                    pOutput = buffer;
+                    sOutput = _streamBuffer.size();
+                }
+
+                if (_isOutputStateful)
+                    iconv(_cd.get(), nullptr, nullptr, &pOutput, &sOutput);
+
+                std::memcpy(pOutput, _replacement.data(), _replacement.size());
+                pOutput += _replacement.size();
+                sOutput -= _replacement.size();
+                ++numEncodingErrors;
+            }
+
+            // Skip the sequence that caused the error.
+            pInput += length;
+            sInput -= length;
+            errorEnd = isInvalid ? pInput : nullptr;
+        }
+        else
+        {
+            ofLogError("TextConverter::feed") << std::strerror(errno);
+            return -1;
+        }
+    }
+
+    if (pOutput != buffer)
+        sink(buffer, pOutput - buffer);
+
+    consumed = pInput - data;
+    _isInInvalidRun = errorEnd == pInput;
+
+    return numEncodingErrors;
+}
+
+
+namespace {
+
+
+/// \brief A process-wide cache of idle TextConverters.
+///
+/// Opening an iconv descriptor loads conversion modules and parses the
+/// encoding names, which costs far more than converting a short string. The
+/// static TextConverter::convert() borrows a converter from this cache and
+/// returns it when done, so each converter is used by one thread at a time.
+/// At most MAX_IDLE converters are kept, and the least recently used one is
+/// closed when the cache is full.
+class TextConverterCache
+{
+public:
+    /// \brief The maximum number of idle converters.
+    static constexpr std::size_t MAX_IDLE = 32;
+
+    /// \brief Borrow a converter, creating one if none is idle.
+    /// \param key The normalized key for the Settings.
+    /// \param settings The conversion Settings.
+    /// \returns a reset converter, or nullptr if the Settings are not supported.
+    std::unique_ptr<TextConverter> acquire(const std::string& key,
+                                           const TextConverter::Settings& settings)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            for (auto iter = _idle.begin(); iter != _idle.end(); ++iter)
+            {
+                if (iter->first == key)
+                {
+                    std::unique_ptr<TextConverter> converter = std::move(iter->second);
+                    _idle.erase(iter);
+                    converter->reset();
+                    return converter;
+                }
+            }
+        }
+
+        auto converter = std::make_unique<TextConverter>();
+
+        if (!converter->setup(settings))
+            return nullptr;
+
+        return converter;
+    }
+
+    /// \brief Return a borrowed converter to the cache.
+    /// \param key The normalized key for the converter's Settings.
+    /// \param converter The converter to return.
+    void release(const std::string& key, std::unique_ptr<TextConverter> converter)
+    {
+        std::unique_ptr<TextConverter> evicted;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // The most recently used converters are kept at the front.
+            _idle.emplace_front(key, std::move(converter));
+
+            if (_idle.size() > MAX_IDLE)
+            {
+                evicted = std::move(_idle.back().second);
+                _idle.pop_back();
+            }
+        }
+
+        // The evicted descriptor is closed here, outside the lock.
+    }
+
+private:
+    /// \brief Guards _idle.
+    std::mutex _mutex;
+
+    /// \brief The idle converters and their keys, most recently used first.
+    std::list<std::pair<std::string, std::unique_ptr<TextConverter>>> _idle;
+
+};
+
+
+TextConverterCache& textConverterCache()
+{
+    static TextConverterCache cache;
+    return cache;
+}
+
+
+} // namespace
+
+
+std::string TextConverter::settingsKey(const Settings& settings)
+{
+    std::string key = normalizeEncodingName(settings.inputEncoding);
+    key += '\0';
+    key += normalizeEncodingName(settings.outputEncoding);
+    key += '\0';
+    key += settings.skipErrors ? '1' : '0';
+    key += settings.defaultCharacter;
+    key += settings.transliterate ? '1' : '0';
+    key += settings.exactOutputSize ? '1' : '0';
+    key += std::to_string(settings.inputEncodingId);
+    key += '\0';
+    key += std::to_string(settings.outputEncodingId);
+    return key;
+}
+
+
+int TextConverter::convert(const std::string& input,
+                           std::string& output,
+                           const std::string& inputEncoding,
+                           const std::string& outputEncoding)
+{
+    if (inputEncoding == outputEncoding)
+    {
+        output = input;
+        return 0;
+    }
+
+    TextConverter::Settings settings;
+    settings.inputEncoding = inputEncoding;
+    settings.outputEncoding = outputEncoding;
+
+    std::string key = settingsKey(settings);
+
+    auto converter = textConverterCache().acquire(key, settings);
+
+    if (!converter)
+        return -1;
+
+    int result = converter->convert(input, output);
+    textConverterCache().release(key, std::move(converter));
+    return result;
+}
+
+
+namespace {
+
+
+/// \brief How a stateless input encoding can be split into chunks.
+enum class ChunkBoundary
+{
+    /// \brief The encoding cannot be split.
+    NONE,
+    /// \brief Every byte is a character.
+    BYTE,
+    /// \brief Characters begin with a UTF-8 lead byte.
+    UTF8,
+    /// \brief Little endian UTF-16 units, split between surrogate pairs.
+    UTF16LE,
+    /// \brief Big endian UTF-16 units, split between surrogate pairs.
+    UTF16BE,
+    /// \brief Two byte units.
+    UNIT2,
+    /// \brief Four byte units.
+    UNIT4,
+    /// \brief Split after a line feed, which is never part of a multi-byte
+    ///        character.
+    LINE_FEED
+};
+
+
+/// \brief Find how an input can be split into chunks.
+/// \param input The input.
+/// \param encoding The input encoding.
+/// \param chunkEncoding Set to the encoding of every chunk but the first,
+///        which differs if the input has a byte order mark.
+/// \returns the chunk boundary type.
+ChunkBoundary findChunkBoundary(const std::string& input,
+                                const std::string& encoding,
+                                std::string& chunkEncoding)
+{
+    std::string name = normalizeEncodingName(encoding);
+    chunkEncoding = encoding;
+
+    // Unmarked UTF-16 and UTF-32 are big endian unless the byte order mark
+    // says otherwise, so later chunks are given an explicit byte order.
+    if (name == "utf16")
+    {
+        bool isLittleEndian = input.compare(0, 2, "\xFF\xFE") == 0;
+        chunkEncoding = isLittleEndian ? "UTF-16LE" : "UTF-16BE";
+        return isLittleEndian ? ChunkBoundary::UTF16LE : ChunkBoundary::UTF16BE;
+    }
+    else if (name == "utf32")
+    {
+        bool isLittleEndian = input.compare(0, 4, std::string("\xFF\xFE\0\0", 4)) == 0;
+        chunkEncoding = isLittleEndian ? "UTF-32LE" : "UTF-32BE";
+        return ChunkBoundary::UNIT4;
+    }
+    else if (name == "ucs2" || name == "ucs4")
+    {
+        // The default byte order of unmarked UCS-2 and UCS-4 depends on the
+        // iconv implementation, so later chunks are only given an explicit
+        // byte order when the input begins with a byte order mark.
+        std::size_t unitSize = name == "ucs2" ? 2 : 4;
+        std::string littleEndianMark = std::string("\xFF\xFE\0\0", unitSize);
+        std::string bigEndianMark = std::string("\0\0\xFE\xFF", 4).substr(4 - unitSize);
+
+        if (input.compare(0, unitSize, littleEndianMark) == 0)
+            chunkEncoding = unitSize == 2 ? "UCS-2LE" : "UCS-4LE";
+        else if (input.compare(0, unitSize, bigEndianMark) == 0)
+            chunkEncoding = unitSize == 2 ? "UCS-2BE" : "UCS-4BE";
+
+        return unitSize == 2 ? ChunkBoundary::UNIT2 : ChunkBoundary::UNIT4;
+    }
+    else if (name == "utf8")
+        return ChunkBoundary::UTF8;
+    else if (name == "utf16le")
+        return ChunkBoundary::UTF16LE;
+    else if (name == "utf16be")
+        return ChunkBoundary::UTF16BE;
+    else if (name == "ucs2le" || name == "ucs2be")
+        return ChunkBoundary::UNIT2;
+    else if (name == "utf32le" || name == "utf32be" || name == "ucs4le" || name == "ucs4be")
+        return ChunkBoundary::UNIT4;
+
+    EncodingWidths widths;
+
+    if (!findEncodingWidths(encoding, widths))
+        return ChunkBoundary::NONE;
+    else if (widths.max[1] == 1 && widths.max[2] == 1)
+        return ChunkBoundary::BYTE;
+    else if (widths.min[0] == 1)
+        return ChunkBoundary::LINE_FEED;
+
+    return ChunkBoundary::NONE;
+}
+
+
+/// \brief Move a split position forward to the next character boundary.
+/// \param boundary The chunk boundary type.
+/// \param input The input.
+/// \param position The position to move.
+/// \returns the next boundary at or after position, or the input size.
+std::size_t nextChunkBoundary(ChunkBoundary boundary,
+                              const std::string& input,
+                              std::size_t position)
+{
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data());
+
+    switch (boundary)
+    {
+        case ChunkBoundary::UTF8:
+            for (std::size_t i = 0; i < 3 && position < input.size() && (data[position] & 0xC0) == 0x80; ++i)
+                ++position;
+            break;
+        case ChunkBoundary::UTF16LE:
+        case ChunkBoundary::UTF16BE:
+        {
+            position += position % 2;
+
+            if (position + 1 < input.size())
+            {
+                char16_t unit = boundary == ChunkBoundary::UTF16LE
+                              ? char16_t(data[position] | (data[position + 1] << 8))
+                              : char16_t((data[position] << 8) | data[position + 1]);
+
+                // Do not separate a low surrogate from its high surrogate.
+                if (unit >= 0xDC00 && unit <= 0xDFFF)
+                    position += 2;
+            }
+            break;
+        }
+        case ChunkBoundary::UNIT2:
+            position += position % 2;
+            break;
+        case ChunkBoundary::UNIT4:
+            position += (4 - position % 4) % 4;
+            break;
+        case ChunkBoundary::LINE_FEED:
+        {
+            std::size_t lineFeed = input.find('\n', position == 0 ? 0 : position - 1);
+            position = lineFeed == std::string::npos ? input.size() : lineFeed + 1;
+            break;
+        }
+        case ChunkBoundary::BYTE:
+        case ChunkBoundary::NONE:
+            break;
+    }
+
+    return std::min(position, input.size());
+}
+
+
+} // namespace
+
+
+int TextConverter::convertParallel(const std::string& input,
+                                   std::string& output,
+                                   const ParallelSettings& settings) const
+{
+    if (!isLoaded())
+    {
+        ofLogError("TextConverter::convertParallel") << "Converter is not loaded. Call setup().";
+        return -1;
+    }
+
+    std::size_t chunkSize = std::max(std::size_t(1), settings.minChunkSize);
+
+    Settings chunkSettings = _settings;
+    ChunkBoundary boundary = findChunkBoundary(input, _settings.inputEncoding, chunkSettings.inputEncoding);
+
+    // Stateful output encodings, and those with unknown widths, cannot be
+    // joined from independently converted items.
+    EncodingWidths outputWidths;
+
+    if (boundary == ChunkBoundary::NONE
+    ||  !findEncodingWidths(_settings.outputEncoding, outputWidths)
+    ||  input.size() < chunkSize * 2)
+    {
+        return convert(input, output);
+    }
+
+    // Precompute the work items. Each one ends at a character boundary and
+    // is at least chunkSize bytes long.
+    std::vector<std::size_t> boundaries(1, 0);
+
+    while (boundaries.back() < input.size())
+        boundaries.push_back(nextChunkBoundary(boundary, input, boundaries.back() + chunkSize));
+
+    std::size_t numItems = boundaries.size() - 1;
+    std::size_t numThreads = settings.numThreads;
+
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    numThreads = std::min(numThreads, numItems);
+
+    std::vector<std::string> outputs(numItems);
+    std::vector<int> results(numItems, 0);
+    std::atomic<std::size_t> nextItem(0);
+    std::string key = settingsKey(chunkSettings);
+
+    auto worker = [&]() {
+        std::unique_ptr<TextConverter> converter;
+        std::size_t i;
+
+        while ((i = nextItem.fetch_add(1)) < numItems)
+        {
+            std::size_t begin = boundaries[i];
+            std::size_t size = boundaries[i + 1] - begin;
+
+            // The built-in codecs have no state, so this converter is shared
+            // by all threads.
+            if (isNative())
+            {
+                outputs[i].resize(maxOutputSize(size));
+                char* out = &outputs[i][0];
+                results[i] = convertNative(input.data() + begin, size, out);
+                outputs[i].resize(out - outputs[i].data());
+                continue;
+            }
+
+            // The first item keeps any byte order mark, so it is converted
+            // with the original Settings.
+            const Settings& itemSettings = i == 0 ? _settings : chunkSettings;
+            std::string itemKey = i == 0 ? settingsKey(_settings) : key;
+            auto itemConverter = textConverterCache().acquire(itemKey, itemSettings);
+
+            if (!itemConverter)
+            {
+                results[i] = -1;
+                continue;
+            }
+
+            results[i] = itemConverter->convert(input.data() + begin, size, outputs[i]);
+            textConverterCache().release(itemKey, std::move(itemConverter));
+
+            // Remove the byte order mark that unmarked UTF-16 and UTF-32
+            // output begins with, which belongs only to the first item.
+            if (i > 0 && _outputPrefixSize > 0 && results[i] >= 0)
+                outputs[i].erase(0, std::min(_outputPrefixSize, outputs[i].size()));
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < numThreads; ++i)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread: threads)
+        thread.join();
+
+    int numEncodingErrors = 0;
+    std::size_t size = 0;
+
+    for (std::size_t i = 0; i < numItems; ++i)
+    {
+        if (results[i] < 0)
+            return -1;
+
+        numEncodingErrors += results[i];
+        size += outputs[i].size();
     }
-    else
+
+    output.resize(size);
+
+    char* out = &output[0];
+
+    for (const auto& itemOutput: outputs)
     {
-        // Wrap in std::shared_ptr.
-        _cd = std::shared_ptr<void>(cd, iconv_close);
+        std::memcpy(out, itemOutput.data(), itemOutput.size());
+        out += itemOutput.size();
     }
 
-    return isLoaded();
+    return numEncodingErrors;
 }
 
 
-bool TextConverter::isLoaded() const
+namespace {
+
+
+/// \brief Find the encoding named by a byte order mark.
+/// \param buffer The encoded text.
+/// \returns the encoding, or an empty string if there is no byte order mark.
+std::string findByteOrderMark(std::string_view buffer)
 {
-    return _cd != nullptr;
+    if (buffer.substr(0, 4) == std::string_view("\xFF\xFE\0\0", 4)
+    ||  buffer.substr(0, 4) == std::string_view("\0\0\xFE\xFF", 4))
+    {
+        return TextConverter::ENCODING_UTF32;
+    }
+    else if (buffer.substr(0, 3) == "\xEF\xBB\xBF")
+        return TextConverter::ENCODING_UTF8;
+    else if (buffer.substr(0, 2) == "\xFF\xFE" || buffer.substr(0, 2) == "\xFE\xFF")
+        return TextConverter::ENCODING_UTF16;
+
+    return std::string();
 }
 
 
-void TextConverter::reset()
+/// \brief Check that a buffer is valid UTF-8.
+/// \param buffer The buffer.
+/// \param isTruncated True if a sequence cut off at the end is allowed.
+/// \param numSequences Set to the number of multi-byte sequences.
+/// \returns true if the buffer is valid UTF-8.
+bool isValidUTF8(std::string_view buffer, bool isTruncated, std::size_t& numSequences)
 {
-    if (isLoaded())
-        iconv(_cd.get(), nullptr, nullptr, nullptr, nullptr);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer.data());
+    const unsigned char* end = p + buffer.size();
+
+    numSequences = 0;
+
+    while (p < end)
+    {
+        // Skip ASCII eight bytes at a time.
+        while (end - p >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+
+            if (word & 0x8080808080808080ULL)
+                break;
+
+            p += sizeof(word);
+        }
+
+        if (p == end)
+            break;
+
+        if (*p < 0x80)
+        {
+            ++p;
+            continue;
+        }
+
+        std::size_t length = utf8SequenceLength(*p);
+        std::size_t available = std::min(length, std::size_t(end - p));
+
+        if (length == 0)
+            return false;
+
+        char32_t units[4] = { *p, 0, 0, 0 };
+
+        for (std::size_t i = 1; i < available; ++i)
+        {
+            if ((p[i] & 0xC0) != 0x80)
+                return false;
+
+            units[i] = p[i];
+        }
+
+        if (available < length)
+            return isTruncated;
+
+        if (decodeUTF8Sequence(units, length) == REPLACEMENT_CHARACTER
+        &&  !(length == 3 && p[0] == 0xEF && p[1] == 0xBF && p[2] == 0xBD))
+        {
+            return false;
+        }
+
+        ++numSequences;
+        p += length;
+    }
+
+    return true;
 }
 
 
-std::vector<std::string> TextConverter::encodings()
+/// \brief Add UTF-16 and UTF-32 candidates for text without a byte order
+///        mark.
+///
+/// Text in these encodings is mostly in scripts with small code points, so
+/// zero bytes appear in predictable positions.
+///
+/// \param text The encoded text.
+/// \param candidates The list to add candidates to.
+void detectWideEncodings(std::string_view text,
+                         std::vector<TextConverter::DetectedEncoding>& candidates)
 {
-    std::vector<std::string> results;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+
+    std::size_t numUnits = text.size() / 4;
+    std::size_t numLittleEndian = 0;
+    std::size_t numBigEndian = 0;
 
-    auto list_callback = [](unsigned int namescount,
-                            const char * const * names,
-                            void* data) -> int
+    for (std::size_t i = 0; i < numUnits * 4; i += 4)
     {
-        auto encodingList = reinterpret_cast<std::vector<std::string>*>(data);
+        numLittleEndian += p[i + 2] == 0 && p[i + 3] == 0 && (p[i] | p[i + 1]) != 0;
+        numBigEndian += p[i] == 0 && p[i + 1] == 0 && (p[i + 2] | p[i + 3]) != 0;
+    }
 
-        if (encodingList)
-            for (unsigned int i = 0; i < namescount; ++i)
-                if (names[i] && strlen(names[i]) > 0)
-                    encodingList->push_back(std::string(names[i]));
+    if (numUnits > 0 && numLittleEndian >= numUnits * 9 / 10)
+        candidates.push_back({ "UTF-32LE", 0.95f * numLittleEndian / numUnits });
+    else if (numUnits > 0 && numBigEndian >= numUnits * 9 / 10)
+        candidates.push_back({ "UTF-32BE", 0.95f * numBigEndian / numUnits });
 
-        return 0;
-    };
+    if (!candidates.empty())
+        return;
 
-    iconvlist(list_callback, &results);
+    // Legacy text never has zero bytes, while UTF-16 text has them in
+    // spaces, punctuation and digits in one byte of the unit. The other
+    // byte of the unit varies little within one script.
+    numUnits = text.size() / 2;
 
-    return results;
+    if (numUnits == 0)
+        return;
+
+    std::size_t numZeros[2] = { 0, 0 };
+    std::vector<std::size_t> histograms[2] = { std::vector<std::size_t>(256, 0),
+                                                std::vector<std::size_t>(256, 0) };
+
+    for (std::size_t i = 0; i < numUnits * 2; ++i)
+    {
+        numZeros[i % 2] += p[i] == 0;
+        ++histograms[i % 2][p[i]];
+    }
+
+    for (std::size_t high = 0; high < 2; ++high)
+    {
+        std::size_t numHighZeros = numZeros[high];
+        std::size_t numLowZeros = numZeros[1 - high];
+
+        if (numHighZeros == 0 || numHighZeros * 100 < numUnits || numLowZeros * 4 > numHighZeros)
+            continue;
+
+        std::vector<std::size_t>& histogram = histograms[high];
+        std::partial_sort(histogram.begin(), histogram.begin() + 2, histogram.end(), std::greater<std::size_t>());
+        float concentration = float(histogram[0] + histogram[1]) / numUnits;
+
+        candidates.push_back({ high == 1 ? "UTF-16LE" : "UTF-16BE", 0.5f + 0.45f * concentration });
+    }
 }
 
 
-int TextConverter::convert(const std::string& input, std::string& output) const
+/// \brief Common lower case letters outside of ASCII in Latin script text.
+const std::u32string_view COMMON_LATIN_LETTERS = U"àáâãäåæçèéêëìíîïñòóôõöøùúûüýÿßąćęłńśźżčďěňřšťůžőűăşţ";
+
+/// \brief Common symbols outside of ASCII.
+const std::u32string_view COMMON_SYMBOLS = U" «»–—‘’‚“”„…•€°§©®·×";
+
+
+/// \brief True if a lower case letter is common in text.
+bool isCommonLetter(char32_t lower)
 {
-    int numEncodingErrors = 0;
+    return (lower >= 0x0430 && lower <= 0x044F)
+        || lower == 0x0451  // ё
+        || lower == 0x0454  // є
+        || lower == 0x0456  // і
+        || lower == 0x0457  // ї
+        || lower == 0x045E  // ў
+        || lower == 0x0491  // ґ
+        || COMMON_LATIN_LETTERS.find(lower) != std::u32string_view::npos;
+}
 
-    if (!isLoaded())
-    {
-        ofLogError("TextConverter::convert") << "Converter is not loaded. Call setup().";
+
+/// \returns 1 for an upper case letter, -1 for a lower case letter or 0.
+int letterCase(char32_t codepoint)
+{
+    if (codepoint < 0x80)
+        return (codepoint >= 'A' && codepoint <= 'Z') - (codepoint >= 'a' && codepoint <= 'z');
+    else if (UTF32::isUpper(codepoint))
+        return 1;
+    else if (UTF32::isLower(codepoint))
         return -1;
-    }
 
-    // C++11+ guarantees that std::string is stored in contiguous memory.
-    char* pInput = const_cast<char*>(input.data());
-    std::size_t sInput = input.size();
+    return 0;
+}
 
-    // Here we only resize the output if the caller hasn't already done so.
-    if (output.size() < sInput * 2)
-        output.resize(sInput * 2);
 
-    char* pOutput = const_cast<char*>(output.data());
-    size_t sOutput = output.size();
+/// \brief Score text decoded with a single-byte encoding.
+/// \param text The encoded text.
+/// \param decode The decode table for bytes 0x80-0xFF.
+/// \param isCyrillic True if the encoding is for Cyrillic script.
+/// \param numScored Set to the number of scored characters.
+/// \returns the score, at most 2 per scored character.
+float scoreSingleByte(std::string_view text,
+                      const char16_t* decode,
+                      bool isCyrillic,
+                      std::size_t& numScored)
+{
+    float score = 0;
+    char32_t previous = ' ';
+    std::size_t runLength = 0;
 
-    while (0 < sInput)
+    numScored = 0;
+
+    for (char c: text)
     {
-        size_t res = iconv(_cd.get(), // Conversion descriptor.
-                           &pInput,   // Pointer to input pointer.
-                           &sInput,   // Pointer to input size.
-                           &pOutput,  // Pointer to output pointer.
-                           &sOutput   // Pointer to output size.
-                           );
-        if (res == INVALID_CONVERSION)
+        unsigned char byte = static_cast<unsigned char>(c);
+        char32_t codepoint = byte < 0x80 ? byte : decode[byte - 0x80];
+        bool isLetter = false;
+
+        if (byte >= 0x80)
         {
-            if (errno == E2BIG)
+            ++numScored;
+
+            if (codepoint == 0)
+                score -= 5;
+            else if (codepoint < 0xA0)
+                score -= 3;
+            else if (UTF32::isAlpha(codepoint))
             {
-                // errno == E2BIG means the output buffer ran out of space.
+                isLetter = true;
+                score += isCommonLetter(UTF32::toLower(codepoint)) ? 2 : 0.5f;
+
+                // Latin script rarely has three non-ASCII letters in a row,
+                // and Cyrillic letters are rarely joined to ASCII letters.
+                if (!isCyrillic && runLength >= 2)
+                    score -= 1.5f;
+                else if (isCyrillic && previous < 0x80 && letterCase(previous) != 0)
+                    score -= 1.5f;
+            }
+            else if (COMMON_SYMBOLS.find(codepoint) != std::u32string_view::npos)
+                score += 0.5f;
+            else
+                score -= 1;
+        }
+        else if (byte < 0x20 && byte != '\t' && byte != '\n' && byte != '\r' && byte != '\f')
+        {
+            ++numScored;
+            score -= 3;
+        }
+        else if (isCyrillic && runLength > 0 && letterCase(codepoint) != 0)
+        {
+            score -= 1.5f;
+        }
 
-                // Make a note of where we were in the output buffer.
-                std::size_t outputPosition = output.size();
+        // An upper case letter rarely follows a lower case letter.
+        if ((byte >= 0x80 || previous >= 0x80)
+        &&  letterCase(codepoint) == 1
+        &&  letterCase(previous) == -1)
+        {
+            score -= 1.5f;
+        }
 
-                // Resize output memory. This resize would ideally be calculated
-                // based on the maximum theoretical size of the output encoding
-                // given the input encoding. For now we'll just use 2x.
-                output.resize(output.size() + sInput * 2);
+        runLength = isLetter ? runLength + 1 : 0;
+        previous = codepoint;
+    }
 
-                // Get new pointers in case the resize operation moved memory.
-                // Offset pointer to place it at the end.
-                pOutput = const_cast<char*>(output.data()) + outputPosition;
+    return score;
+}
 
-                // Set a new remaining size based on the updated output
-                // position and the resized output buffer..
-                sOutput = output.size() - outputPosition;
-            }
-            else if (_settings.skipErrors)
-            {
-                // Skip the character that caused the error.
-                ++pInput;
-                --sInput;
-                *pOutput = _settings.defaultCharacter;
-                ++pOutput;
-                --sOutput;
-                ++numEncodingErrors;
-           }
+
+/// \brief Score text as Shift_JIS.
+/// \param text The encoded text.
+/// \param numScored Set to the number of scored characters.
+/// \returns the score, at most 2 per scored character.
+float scoreShiftJIS(std::string_view text, std::size_t& numScored)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    const unsigned char* end = p + text.size();
+    float score = 0;
+
+    numScored = 0;
+
+    while (p < end)
+    {
+        unsigned char lead = *p;
+
+        if (lead < 0x80)
+        {
+            ++p;
+            continue;
+        }
+
+        ++numScored;
+
+        if (lead >= 0xA1 && lead <= 0xDF)
+        {
+            // Half-width katakana.
+            score += 0.5f;
+            ++p;
+        }
+        else if (((lead >= 0x81 && lead <= 0x9F) || (lead >= 0xE0 && lead <= 0xFC))
+             &&  end - p >= 2
+             &&  p[1] >= 0x40 && p[1] <= 0xFC && p[1] != 0x7F)
+        {
+            // Hiragana and katakana, punctuation, then kanji.
+            if (lead == 0x82 || lead == 0x83)
+                score += 2;
+            else if (lead == 0x81 || (lead >= 0x88 && lead <= 0x9F))
+                score += 1.5f;
+            else if (lead >= 0xE0 && lead <= 0xEA)
+                score += 1;
             else
-            {
-                switch (errno)
-                {
-                    case EILSEQ:
-                    case EINVAL:
-                        ofLogError("TextConverter::convert") << std::strerror(errno);
-                        break;
-                    default:
-                        ofLogError("TextConverter::convert") << "Unknown conversion error: " << std::strerror(errno);
-                }
+                score += 0.25f;
 
-                return -1;
-            }
+            p += 2;
+        }
+        else if (end - p < 2)
+        {
+            // A character cut off at the end of the text.
+            --numScored;
+            break;
+        }
+        else
+        {
+            score -= 5;
+            ++p;
         }
     }
 
-    // Remove any excess size if required.
-    output.resize(pOutput - const_cast<char*>(output.data()));
+    return score;
+}
 
-    return numEncodingErrors;
+
+/// \brief Score text as an EUC or GB encoding of two byte characters.
+/// \param text The encoded text.
+/// \param weight A function returning the score of a lead and trail byte,
+///        or a negative number if they are not a character.
+/// \param usesSpaces True if the language separates words with spaces.
+/// \param numScored Set to the number of scored characters.
+/// \returns the score, at most 2 per scored character.
+template<typename Weight>
+float scoreDoubleByte(std::string_view text, Weight weight, bool usesSpaces, std::size_t& numScored)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    const unsigned char* end = p + text.size();
+    float score = 0;
+    bool isSpaced = false;
+
+    numScored = 0;
+
+    while (p < end)
+    {
+        if (*p < 0x80)
+        {
+            // Only Korean separates words written in its script by spaces.
+            if (!usesSpaces && isSpaced && *p != ' ')
+                isSpaced = false;
+
+            ++p;
+            continue;
+        }
+
+        if (isSpaced)
+            score -= 1.5f;
+
+        // A character cut off at the end of the text.
+        if (end - p < 2)
+            break;
+
+        ++numScored;
+
+        float characterScore = weight(p, end);
+
+        if (characterScore < 0)
+        {
+            score -= 5;
+            ++p;
+        }
+        else
+        {
+            score += characterScore;
+            p += 2;
+            isSpaced = !usesSpaces && p < end && *p == ' ';
+        }
+    }
+
+    return score;
 }
 
 
-std::string TextConverter::convert(const std::string& input) const
+/// \brief True if a byte is in the range of EUC double byte characters.
+bool isEUCByte(unsigned char byte)
 {
-    std::string output;
-    convert(input, output);
-    return output;
+    return byte >= 0xA1 && byte <= 0xFE;
 }
 
 
-int TextConverter::convert(const std::string& input,
-                           std::string& output,
-                           const std::string& inputEncoding,
-                           const std::string& outputEncoding)
+float scoreEUCJP(const unsigned char* p, const unsigned char* end)
 {
-    if (inputEncoding == outputEncoding)
+    if (p[0] == 0x8E && p[1] >= 0xA1 && p[1] <= 0xDF)
+        return 0.5f;
+    else if (p[0] == 0x8F && end - p >= 3 && isEUCByte(p[1]) && isEUCByte(p[2]))
+        return 0.25f;
+    else if (!isEUCByte(p[0]) || !isEUCByte(p[1]))
+        return -1;
+    else if (p[0] == 0xA4 || p[0] == 0xA5)
+        return 2;
+    else if (p[0] >= 0xB0 && p[0] <= 0xCF)
+        return 1.5f;
+    else if (p[0] == 0xA1 || (p[0] >= 0xD0 && p[0] <= 0xF4))
+        return 1;
+
+    return 0.25f;
+}
+
+
+float scoreGB18030(const unsigned char* p, const unsigned char* end)
+{
+    if (p[0] < 0x81 || p[0] > 0xFE)
+        return -1;
+    else if (p[1] >= 0x30 && p[1] <= 0x39)
     {
-        output = input;
-        return 0;
+        if (end - p >= 4 && p[2] >= 0x81 && p[2] <= 0xFE && p[3] >= 0x30 && p[3] <= 0x39)
+            return 0.25f;
+
+        return -1;
     }
-    else
+    else if (p[1] < 0x40 || p[1] == 0x7F || p[1] == 0xFF)
+        return -1;
+    else if (p[1] >= 0xA1 && p[0] >= 0xB0 && p[0] <= 0xD7)
+        return 2;
+    else if (p[1] >= 0xA1 && ((p[0] >= 0xD8 && p[0] <= 0xF7) || p[0] == 0xA1 || p[0] == 0xA3))
+        return 1.5f;
+
+    return 0.25f;
+}
+
+
+float scoreBig5(const unsigned char* p, const unsigned char*)
+{
+    if (p[0] < 0xA1 || p[0] > 0xF9
+    || !((p[1] >= 0x40 && p[1] <= 0x7E) || (p[1] >= 0xA1 && p[1] <= 0xFE)))
+    {
+        return -1;
+    }
+
+    // Trail bytes below 0xA1 are only found in Big5, so they are a stronger
+    // sign than those shared with the EUC encodings.
+    float shared = p[1] >= 0xA1 ? 0.6f : 1;
+
+    if (p[0] >= 0xA4 && p[0] <= 0xC6)
+        return 2 * shared;
+    else if (p[0] <= 0xA3 || p[0] >= 0xC9)
+        return shared;
+
+    return 0.25f;
+}
+
+
+float scoreEUCKR(const unsigned char* p, const unsigned char*)
+{
+    if (!isEUCByte(p[0]) || !isEUCByte(p[1]))
+        return -1;
+    else if (p[0] >= 0xB0 && p[0] <= 0xC8)
+        return 2;
+    else if (p[0] <= 0xAC)
+        return 0.5f;
+
+    return 0.25f;
+}
+
+
+/// \brief Add a statistically scored candidate.
+/// \param encoding The encoding.
+/// \param score The score, at most 2 per scored character.
+/// \param numScored The number of scored characters.
+/// \param candidates The list to add the candidate to.
+void addScoredCandidate(const std::string& encoding,
+                        float score,
+                        std::size_t numScored,
+                        std::vector<TextConverter::DetectedEncoding>& candidates)
+{
+    if (numScored == 0 || score <= 0)
+        return;
+
+    // Statistics are never certain, and less so for few characters.
+    float confidence = std::min(1.0f, score / (2 * numScored))
+                     * 0.9f
+                     * numScored / (numScored + 1);
+
+    candidates.push_back({ encoding, confidence });
+}
+
+
+} // namespace
+
+
+std::vector<TextConverter::DetectedEncoding> TextConverter::detect(std::string_view buffer,
+                                                                  std::size_t maxBytes)
+{
+    std::vector<DetectedEncoding> candidates;
+
+    std::string byteOrderMark = findByteOrderMark(buffer);
+
+    if (!byteOrderMark.empty())
+    {
+        candidates.push_back({ byteOrderMark, 1 });
+        return candidates;
+    }
+
+    std::string_view text = buffer.substr(0, maxBytes);
+
+    if (text.empty())
+        return candidates;
+
+    detectWideEncodings(text, candidates);
+
+    std::size_t numSequences = 0;
+
+    if (isValidUTF8(text, buffer.size() > maxBytes, numSequences))
     {
-        TextConverter converter;
-        TextConverter::Settings settings;
-        settings.inputEncoding = inputEncoding;
-        settings.outputEncoding = outputEncoding;
-        converter.setup(settings);
-        return converter.convert(input, output);
+        if (numSequences == 0
+        &&  candidates.empty()
+        &&  text.find('\0') == std::string_view::npos)
+        {
+            candidates.push_back({ ENCODING_ASCII, 1 });
+            candidates.push_back({ ENCODING_UTF8, 1 });
+            return candidates;
+        }
+
+        // Legacy text is rarely valid UTF-8 by chance, less so the more
+        // multi-byte sequences it has.
+        if (numSequences > 0)
+            candidates.push_back({ ENCODING_UTF8, std::min(0.99f, 1 - std::pow(0.5f, float(numSequences + 1))) });
+    }
+
+    const std::pair<const std::string*, const char16_t*> singleByteEncodings[] = {
+        { &ENCODING_WINDOWS_1252, WINDOWS_1252_DECODE },
+        { &ENCODING_ISO_8859_1, ISO_8859_1_DECODE },
+        { &ENCODING_ISO_8859_15, ISO_8859_15_DECODE },
+        { &ENCODING_WINDOWS_1250, WINDOWS_1250_DECODE },
+        { &ENCODING_ISO_8859_2, ISO_8859_2_DECODE },
+        { &ENCODING_WINDOWS_1251, WINDOWS_1251_DECODE }
+    };
+
+    std::size_t numScored = 0;
+
+    for (const auto& encoding: singleByteEncodings)
+    {
+        bool isCyrillic = encoding.first == &ENCODING_WINDOWS_1251;
+        float score = scoreSingleByte(text, encoding.second, isCyrillic, numScored);
+        addScoredCandidate(*encoding.first, score, numScored, candidates);
     }
+
+    float score = scoreShiftJIS(text, numScored);
+    addScoredCandidate("Shift_JIS", score, numScored, candidates);
+
+    score = scoreDoubleByte(text, scoreEUCJP, false, numScored);
+    addScoredCandidate("EUC-JP", score, numScored, candidates);
+
+    score = scoreDoubleByte(text, scoreGB18030, false, numScored);
+    addScoredCandidate("GB18030", score, numScored, candidates);
+
+    score = scoreDoubleByte(text, scoreBig5, false, numScored);
+    addScoredCandidate("Big5", score, numScored, candidates);
+
+    score = scoreDoubleByte(text, scoreEUCKR, true, numScored);
+    addScoredCandidate("EUC-KR", score, numScored, candidates);
+
+    std::stable_sort(candidates.begin(),
+                     candidates.end(),
+                     [](const DetectedEncoding& a, const DetectedEncoding& b) {
+                         return a.confidence > b.confidence;
+                     });
+
+    return candidates;
 }
 
 
@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2012 Christopher Baker <https://christopherbaker.net>
+//
+// SPDX-License-Identifier:	MIT
+//
+
+
+#include "ofx/WordTokenizer.h"
+#include <algorithm>
+#include <cctype>
+#include "ofUtils.h"
+
+
+namespace ofx {
+
+
+namespace {
+
+
+/// \brief The largest window, as a multiple of the minimum window size.
+constexpr std::size_t MAX_WINDOW_FACTOR = 4;
+
+
+/// \brief Find where a window of a text can end.
+///
+/// A window ends where a word break is always allowed, so that each window
+/// breaks the same as the whole text: just after a line feed, or after a
+/// space that is followed by another ASCII character. If neither is found
+/// before the limit, the window ends at the last character boundary before
+/// it, where a break is reported that the whole text might not have.
+///
+/// \param text The text to search.
+/// \param from The smallest window end.
+/// \param limit The largest window end.
+/// \returns the window end.
+std::size_t findWindowEnd(std::string_view text, std::size_t from, std::size_t limit)
+{
+    for (std::size_t i = from - 1; i < limit; ++i)
+    {
+        if (text[i] == '\n')
+            return i + 1;
+
+        if (text[i] == ' '
+        &&  i + 1 < text.size()
+        &&  text[i + 1] != ' '
+        &&  static_cast<unsigned char>(text[i + 1]) < 0x80)
+        {
+            return i + 1;
+        }
+    }
+
+    if (limit == text.size())
+        return limit;
+
+    // A UTF-8 character has at most three continuation bytes.
+    for (int n = 0; n < 3 && (static_cast<unsigned char>(text[limit]) & 0xC0) == 0x80; ++n)
+        --limit;
+
+    return limit;
+}
+
+
+} // namespace
+
+
+WordTokenizer::WordTokenizer(std::string_view utf8,
+                             bool skipNonWords,
+                             const std::string& language,
+                             std::size_t windowSize):
+    _text(utf8),
+    _skipNonWords(skipNonWords),
+    _language(language),
+    _windowSize(std::max(std::size_t(1), windowSize))
+{
+}
+
+
+WordTokenizer::~WordTokenizer()
+{
+}
+
+
+bool WordTokenizer::next(std::string_view& token)
+{
+    while (true)
+    {
+        if (_offset >= _windowEnd && !nextWindow())
+            return false;
+
+        std::size_t begin = _offset;
+        std::size_t i = _offset - _windowBegin;
+
+        // The last byte of each window always ends a token.
+        while (i + 1 < _breaks.size() && _breaks[i] != Wordbreaker::BreakType::ALLOW_BREAK)
+            ++i;
+
+        _offset = _windowBegin + i + 1;
+        token = _text.substr(begin, _offset - begin);
+
+        if (!_skipNonWords || !isNonWord(token))
+            return true;
+    }
+}
+
+
+void WordTokenizer::reset()
+{
+    _windowBegin = 0;
+    _windowEnd = 0;
+    _offset = 0;
+}
+
+
+std::size_t WordTokenizer::offset() const
+{
+    return _offset;
+}
+
+
+WordTokenizer::const_iterator WordTokenizer::begin()
+{
+    return const_iterator(this);
+}
+
+
+WordTokenizer::const_iterator WordTokenizer::end()
+{
+    return const_iterator();
+}
+
+
+bool WordTokenizer::isNonWord(std::string_view token)
+{
+    try
+    {
+        auto iter = token.begin();
+
+        while (iter != token.end())
+        {
+            unsigned char c = static_cast<unsigned char>(*iter);
+
+            // ASCII letters and digits are by far the most common.
+            if (c < 0x80 && std::isalnum(c))
+                return false;
+
+            char32_t codepoint = utf8::next(iter, token.end());
+
+            if (!UTF32::isSpace(codepoint)
+            &&  !UTF32::isPunct(codepoint)
+            &&  !UTF32::isControl(codepoint))
+            {
+                return false;
+            }
+        }
+    }
+    catch (const utf8::exception&)
+    {
+        // Invalid sequences are kept as words.
+        return false;
+    }
+
+    return true;
+}
+
+
+bool WordTokenizer::nextWindow()
+{
+    if (_windowEnd >= _text.size())
+        return false;
+
+    std::size_t begin = _windowEnd;
+    std::size_t end = _text.size();
+
+    if (end - begin > _windowSize)
+    {
+        std::size_t limit = end;
+
+        if ((end - begin) / MAX_WINDOW_FACTOR >= _windowSize)
+            limit = begin + _windowSize * MAX_WINDOW_FACTOR;
+
+        end = findWindowEnd(_text, begin + _windowSize, limit);
+    }
+
+    _breaks.resize(end - begin);
+
+    Wordbreaker::findBreaks(_text.substr(begin, end - begin),
+                            _language,
+                            _breaks.data(),
+                            _breaks.size());
+
+    _windowBegin = begin;
+    _windowEnd = end;
+    _offset = begin;
+    return true;
+}
+
+
+} // namespace ofx
@@ -0,0 +1,106 @@
+#! /usr/bin/env python3
+#
+# Generate the native single-byte codec tables used by TextConverter.
+#
+# The tables are written into the generated region of Unicode.cpp. Python's
+# codecs for these charsets are themselves generated from the Unicode mapping
+# files, e.g.
+#
+#   http://unicode.org/Public/MAPPINGS/ISO8859/8859-1.TXT
+#   http://unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1252.TXT
+#
+# For each charset a 128 entry decode table maps bytes 0x80-0xFF to UTF-16
+# code units, with 0 for undefined bytes. The encode table lists
+# (codepoint << 8) | byte for the same bytes, sorted by code point, so that
+# encoding is a binary search over at most 128 entries. Bytes 0x00-0x7F are
+# ASCII in every charset and are not stored.
+
+import codecs
+import os
+import sys
+
+ADDON_ROOT = os.environ.get("ADDON_ROOT", os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+IMPL = os.path.join(ADDON_ROOT, "libs", "ofxUnicode", "src", "Unicode.cpp")
+
+BEGIN_MARKER = "// BEGIN GENERATED SINGLE BYTE TABLES"
+END_MARKER = "// END GENERATED SINGLE BYTE TABLES"
+
+# (C++ prefix, Python codec) in the order used by Unicode.cpp.
+CHARSETS = [
+    ("ASCII", "ascii"),
+    ("ISO_8859_1", "latin-1"),
+    ("ISO_8859_2", "iso8859-2"),
+    ("ISO_8859_15", "iso8859-15"),
+    ("WINDOWS_1250", "cp1250"),
+    ("WINDOWS_1251", "cp1251"),
+    ("WINDOWS_1252", "cp1252"),
+]
+
+
+def table(name, type, values):
+    lines = ["const %s %s[] = {" % (type, name)]
+
+    for i in range(0, len(values), 8):
+        lines.append("    " + " ".join(v + "," for v in values[i:i + 8]))
+
+    lines.append("};")
+    return lines
+
+
+def generate():
+    lines = []
+
+    for prefix, codec in CHARSETS:
+        decode = []
+        encode = []
+
+        for byte in range(0x80, 0x100):
+            try:
+                codepoint = ord(codecs.decode(bytes([byte]), codec))
+            except UnicodeDecodeError:
+                codepoint = 0
+
+            decode.append(codepoint)
+
+            if codepoint:
+                encode.append((codepoint << 8) | byte)
+
+        lines += table(prefix + "_DECODE", "char16_t", ["0x%04X" % v for v in decode])
+        lines.append("")
+
+        # An empty array is not allowed, so a charset without upper half
+        # mappings has a single entry that can never match.
+        if not encode:
+            encode = [0]
+
+        lines += table(prefix + "_ENCODE", "uint32_t", ["0x%06X" % v for v in sorted(encode)])
+        lines.append("")
+        lines.append("")
+
+    return lines[:-2]
+
+
+def main():
+    with open(IMPL) as f:
+        source = f.read().split("\n")
+
+    output = []
+    skip = False
+
+    for line in source:
+        if END_MARKER in line:
+            skip = False
+
+        if not skip:
+            output.append(line)
+
+        if BEGIN_MARKER in line:
+            output += generate()
+            skip = True
+
+    with open(IMPL, "w") as f:
+        f.write("\n".join(output))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
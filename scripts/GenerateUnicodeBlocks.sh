@@ -0,0 +1,61 @@
+#! /bin/bash
+#
+# Generate the Unicode Block table from the vendored Blocks.txt.
+#
+# The table is written as a constexpr array into the generated regions of
+# Unicode.h and Unicode.cpp, so that no Block requires static initialization.
+#
+# To update the vendored data first run:
+#
+#   curl http://www.unicode.org/Public/UNIDATA/Blocks.txt > scripts/data/Blocks.txt
+
+set -e
+
+ADDON_ROOT=${ADDON_ROOT:-$(cd "$( dirname "${BASH_SOURCE[0]}" )/.." && pwd)}
+
+BLOCKS_TXT=${1:-$ADDON_ROOT/scripts/data/Blocks.txt}
+HEADER=$ADDON_ROOT/libs/ofxUnicode/include/ofx/Unicode.h
+IMPL=$ADDON_ROOT/libs/ofxUnicode/src/Unicode.cpp
+
+BEGIN_MARKER="// BEGIN GENERATED UNICODE BLOCKS"
+END_MARKER="// END GENERATED UNICODE BLOCKS"
+
+TMP=$(mktemp -d)
+trap "rm -rf $TMP" EXIT
+
+# Convert "0100..017F; Latin Extended-A" to "0100,017F,LATIN_EXTENDED_A".
+cat "$BLOCKS_TXT" | \
+	tr -d '\r' | \
+	grep -vE "^#|^$" | \
+	sed 's/\.\./,/g' | \
+	sed 's/; /,/g' | \
+	tr '[:lower:]' '[:upper:]' | \
+	sed 's/[ -]/_/g' \
+	> $TMP/Blocks.csv
+
+# Create header data.
+awk -F "," '{print "    /// \\brief The " $3 " Unicode Block.\n    static const Block& " $3 ";\n"}' $TMP/Blocks.csv > $TMP/header.txt
+
+# Create implementation data.
+(
+	echo "constexpr Unicode::Block BLOCK_TABLE[] = {"
+	awk -F "," '{print "    {0x" $1 ", 0x" $2 ", \"" $3 "\"},"}' $TMP/Blocks.csv
+	echo "};"
+	echo ""
+	echo ""
+	awk -F "," '{print "const Unicode::Block& Unicode::" $3 " = BLOCK_TABLE[" NR - 1 "];"}' $TMP/Blocks.csv
+) > $TMP/impl.txt
+
+# Replace the text between the generated markers in a file.
+replace_generated()
+{
+	awk -v data="$2" -v begin="$BEGIN_MARKER" -v end="$END_MARKER" '
+		index($0, begin) { print; while ((getline line < data) > 0) print line; skip = 1; next }
+		index($0, end) { skip = 0 }
+		!skip { print }
+	' "$1" > $TMP/replaced
+	cat $TMP/replaced > "$1"
+}
+
+replace_generated "$HEADER" $TMP/header.txt
+replace_generated "$IMPL" $TMP/impl.txt
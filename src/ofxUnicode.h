@@ -9,11 +9,24 @@
 
 
 #include "ofx/Unicode.h"
+#include "ofx/BreakCache.h"
+#include "ofx/CodepointSet.h"
+#include "ofx/CoverageAnalyzer.h"
+#include "ofx/LineFitter.h"
+#include "ofx/WordTokenizer.h"
+#include "ofx/TextConverterPool.h"
 
 
 typedef ofx::Unicode ofxUnicode;
 typedef ofx::Linebreaker ofxLinebreaker;
 typedef ofx::Wordbreaker ofxWordbreaker;
+typedef ofx::Segmenter ofxSegmenter;
+typedef ofx::BreakCache ofxBreakCache;
 typedef ofx::UTF8 ofxUTF8;
 typedef ofx::UTF32 ofxUTF32;
 typedef ofx::TextConverter ofxTextConverter;
+typedef ofx::TextConverterPool ofxTextConverterPool;
+typedef ofx::CodepointSet ofxCodepointSet;
+typedef ofx::CoverageAnalyzer ofxCoverageAnalyzer;
+typedef ofx::LineFitter ofxLineFitter;
+typedef ofx::WordTokenizer ofxWordTokenizer;